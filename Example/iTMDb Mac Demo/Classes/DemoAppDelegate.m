@@ -253,7 +253,7 @@
 
 - (NSInteger)numberOfRowsInTableView:(NSTableView *)tableView {
 	TMDBMovie *movie = self.movies.firstObject;
-	return movie.cast.count;
+	return movie.credits.count;
 }
 
 #pragma mark - NSTableViewDelegate
@@ -261,11 +261,12 @@
 - (NSView *)tableView:(NSTableView *)tableView viewForTableColumn:(NSTableColumn *)tableColumn row:(NSInteger)row {
 	TMDBMovie *movie = self.movies.firstObject;
 
-	TMDBPerson *person = movie.cast[row];
+	TMDBCredit *credit = movie.credits[row];
+	TMDBPerson *person = credit.person;
 	NSTableCellView *view = [tableView makeViewWithIdentifier:tableColumn.identifier owner:self];
 
 	if ([tableColumn.identifier isEqualToString:@"imageAndName"]) {
-		view.textField.stringValue = person.name;
+		view.textField.stringValue = person.name ?: @"";
 
 		NSURL *imageURL = nil;
 		if (person.imageURL != nil) {
@@ -297,16 +298,16 @@
 		}
 	}
 	else if ([tableColumn.identifier isEqualToString:@"character"]) {
-		if ([person.job isEqualToString:@"Actor"]) {
-			view.textField.stringValue = person.character ? : person.job ? : @"";
+		if ([credit.job isEqualToString:@"Actor"]) {
+			view.textField.stringValue = credit.character ? : credit.job ? : @"";
 		}
 		else {
-			view.textField.stringValue = person.job ? : @"";
+			view.textField.stringValue = credit.job ? : @"";
 		}
 	}
 	else if ([tableColumn.identifier isEqualToString:@"other"]) {
-		if ([person.job isEqualToString:@"Actor"])
-			view.textField.stringValue = person.job ? : @"";
+		if ([credit.job isEqualToString:@"Actor"])
+			view.textField.stringValue = credit.job ? : @"";
 		else
 			view.textField.stringValue = @"";
 	}
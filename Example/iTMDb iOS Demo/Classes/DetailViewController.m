@@ -52,7 +52,7 @@
 		NSMutableString *text = [NSMutableString string];
 		[text appendFormat:@"%@ (%@)\n\n", movie.title, @(movie.year)];
 		[text appendFormat:@"OVERVIEW:\n%@\n\n", movie.overview];
-		[text appendFormat:@"CAST:\n%@\n\n", movie.cast];
+		[text appendFormat:@"CAST:\n%@\n\n", movie.credits];
 		[text appendFormat:@"KEYWORDS:\n%@\n\n", movie.keywords];
 		[text appendFormat:@"CATEGORIES:\n%@\n\n", movie.categories];
 		self.detailDescriptionLabel.text = text;
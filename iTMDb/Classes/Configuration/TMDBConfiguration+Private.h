@@ -0,0 +1,35 @@
+//
+//  TMDBConfiguration+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBConfiguration.h"
+
+@class TMDB;
+@class TMDBImageSizeIndex;
+
+// Private methods shared with the model classes
+@interface TMDBConfiguration (Private)
+
+/**
+ * Creates the configuration of `context`, which it is reloaded through. The
+ * context isn't retained. Pass `nil` to use the shared instance.
+ */
+- (nonnull instancetype)initWithContext:(nullable TMDB *)context;
+
+/**
+ * Returns the index of `sizes` if it is one of the configuration's own size
+ * arrays, or `nil`.
+ */
+- (nullable TMDBImageSizeIndex *)sizeIndexForSizes:(nonnull NSArray<NSString *> *)sizes;
+
+/**
+ * Returns the image base URL joined with `size`, without a trailing slash, or
+ * `nil` if the configuration hasn't been loaded.
+ */
+- (nullable NSString *)imageURLPrefixForSize:(nonnull NSString *)size;
+
+@end
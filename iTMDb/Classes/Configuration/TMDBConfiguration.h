@@ -8,18 +8,70 @@
 
 @import Foundation;
 
+#import "TMDBImage.h"
+
+@class TMDBRequestToken;
+
+/**
+ * The number of seconds a stored configuration is used before it is
+ * refreshed. 3 days.
+ */
+extern const NSTimeInterval TMDBConfigurationDefaultSnapshotLifetime;
+
 /**
  * The TMDb configuration information includes information commonly needed 
  * in many API responses, such as base URLs. Instances of this class is
  * automatically created by the `TMDB` shared instance so you never need to
  * create an instance yourself.
+ *
+ * A reload replaces the loaded values all at once, so they can be read from
+ * any thread while the configuration is being refreshed.
  */
 @interface TMDBConfiguration : NSObject
 
-- (void)reload:(void (^_Nullable)(NSError * _Nullable error))completionBlock;
+/**
+ * Loads the configuration from TMDb, and stores it on disk for the next
+ * launch. The completion block is always called, also when the response is
+ * invalid, unless the token is cancelled.
+ *
+ * @return A token for changing the priority of the request or cancelling it.
+ */
+- (nonnull TMDBRequestToken *)reload:(void (^_Nullable)(NSError * _Nullable error))completionBlock;
+
+/**
+ * Reloads the configuration if it hasn't been loaded, or was loaded longer
+ * than `snapshotLifetime` ago. Otherwise the completion block is called right
+ * away.
+ *
+ * @return A token for changing the priority of the request or cancelling it.
+ */
+- (nonnull TMDBRequestToken *)reloadIfNeeded:(void (^_Nullable)(NSError * _Nullable error))completionBlock;
+
+/**
+ * A value indicating if the configuration has been loaded yet, either from
+ * TMDb or from the copy stored on disk by a previous launch.
+ *
+ * The stored copy is read when the configuration is created, so image URLs
+ * can be resolved right away. The `TMDB` context refreshes it in the
+ * background once it has an API key and the copy is older than
+ * `snapshotLifetime`.
+ */
+@property (atomic, readonly, getter=isLoaded) BOOL loaded;
+
+/** The time the configuration was last loaded from TMDb, or `nil`. */
+@property (atomic, copy, nullable, readonly) NSDate *lastUpdated;
 
-/** A value indicating if the configuration has been loaded yet. */
-@property (nonatomic, readonly, getter=isLoaded) BOOL loaded;
+/**
+ * A value indicating if the configuration is missing or older than
+ * `snapshotLifetime`.
+ */
+@property (nonatomic, readonly, getter=isStale) BOOL stale;
+
+/**
+ * The number of seconds the configuration is used before it is refreshed.
+ * Default `TMDBConfigurationDefaultSnapshotLifetime`.
+ */
+@property (atomic) NSTimeInterval snapshotLifetime;
 
 @property (nonatomic, copy, nullable, readonly) NSURL *imagesBaseURL;
 @property (nonatomic, copy, nullable, readonly) NSURL *imagesSecureBaseURL;
@@ -31,4 +83,15 @@
 
 @property (nonatomic, copy, nullable, readonly) NSArray *changeKeys;
 
+/**
+ * Returns the configured size for `imageType` that closest matches `size`
+ * pixels in `dimension`: the smallest size at least that large, or else the
+ * largest one. The sizes are indexed once per load, so this is a binary
+ * search.
+ *
+ * @return The size, such as `w500`, or `nil` if the configuration has no
+ * sizes for `imageType`.
+ */
+- (nullable NSString *)imageSizeClosestMatchingSize:(float)size imageType:(TMDBImageType)imageType dimension:(TMDBImageSize)dimension;
+
 @end
@@ -9,73 +9,342 @@
 #import "TMDBConfiguration.h"
 #import "TMDB.h"
 #import "TMDBRequest.h"
+#import "TMDBRequestToken+Private.h"
+#import "TMDBRequestMetrics+Private.h"
+#import "TMDBError.h"
+#import "TMDBConfiguration+Private.h"
+#import "TMDBImageSizeIndex.h"
 
-@interface TMDBConfiguration ()
+const NSTimeInterval TMDBConfigurationDefaultSnapshotLifetime = 3 * 24 * 60 * 60;
+
+static NSString * const TMDBConfigurationSnapshotDataKey = @"configuration";
+static NSString * const TMDBConfigurationSnapshotDateKey = @"storedAt";
+
+/**
+ * The values of a loaded configuration, together with the indexes derived
+ * from them. Built in full before it is handed to the configuration, which
+ * swaps it in as a whole, so readers on other threads always see a
+ * consistent set.
+ */
+// Private class
+@interface TMDBConfigurationValues : NSObject
+
+- (instancetype)initWithDictionary:(NSDictionary *)d;
+
+@property (nonatomic, copy, readonly) NSURL *imagesBaseURL;
+@property (nonatomic, copy, readonly) NSURL *imagesSecureBaseURL;
+
+@property (nonatomic, copy, readonly) NSArray *imagesPosterSizes;
+@property (nonatomic, copy, readonly) NSArray *imagesBackdropSizes;
+@property (nonatomic, copy, readonly) NSArray *imagesProfileSizes;
+@property (nonatomic, copy, readonly) NSArray *imagesLogoSizes;
+
+@property (nonatomic, copy, readonly) NSArray *changeKeys;
+
+@property (nonatomic, copy, readonly) NSDictionary<NSNumber *, TMDBImageSizeIndex *> *sizeIndexes;
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSString *> *imageURLPrefixes;
+@property (nonatomic, copy, readonly) NSString *imagesBaseURLString;
+
+@end
+
+@implementation TMDBConfigurationValues
+
+- (instancetype)initWithDictionary:(NSDictionary *)d {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_imagesBaseURL = TMDB_NSURLOrNilFromStringOrNil(d[@"images"][@"base_url"]);
+	_imagesSecureBaseURL = TMDB_NSURLOrNilFromStringOrNil(d[@"images"][@"secure_base_url"]);
+
+	_imagesPosterSizes = TMDB_NSArrayOrNil(d[@"images"][@"poster_sizes"]);
+	_imagesBackdropSizes = TMDB_NSArrayOrNil(d[@"images"][@"backdrop_sizes"]);
+	_imagesProfileSizes = TMDB_NSArrayOrNil(d[@"images"][@"profile_sizes"]);
+	_imagesLogoSizes = TMDB_NSArrayOrNil(d[@"images"][@"logo_sizes"]);
+
+	_changeKeys = TMDB_NSArrayOrNil(d[@"change_keys"]);
+
+	[self buildImageIndexes];
+
+	return self;
+}
+
+// Private
+- (void)buildImageIndexes {
+	NSMutableDictionary *sizeIndexes = [NSMutableDictionary dictionary];
+	NSDictionary *sizesByType = @{
+		@(TMDBImageTypePoster): _imagesPosterSizes ?: @[],
+		@(TMDBImageTypeBackdrop): _imagesBackdropSizes ?: @[],
+		@(TMDBImageTypeProfile): _imagesProfileSizes ?: @[],
+		@(TMDBImageTypeLogo): _imagesLogoSizes ?: @[]
+	};
+
+	NSString *baseURLString = _imagesBaseURL.absoluteString;
+	while ([baseURLString hasSuffix:@"/"]) {
+		baseURLString = [baseURLString substringToIndex:baseURLString.length - 1];
+	}
+
+	NSMutableDictionary *prefixes = [NSMutableDictionary dictionary];
+
+	for (NSNumber *type in sizesByType) {
+		NSArray *sizes = sizesByType[type];
+		sizeIndexes[type] = [[TMDBImageSizeIndex alloc] initWithSizes:sizes];
+
+		for (NSString *size in sizes) {
+			if (baseURLString != nil && TMDB_NSStringOrNil(size) != nil) {
+				prefixes[size] = [NSString stringWithFormat:@"%@/%@", baseURLString, size];
+			}
+		}
+	}
 
-@property (nonatomic, getter=isLoaded) BOOL loaded;
+	_imagesBaseURLString = [baseURLString copy];
+	_imageURLPrefixes = [prefixes copy];
+	_sizeIndexes = [sizeIndexes copy];
+}
 
-@property (nonatomic, nullable, copy) NSURL *imagesBaseURL;
-@property (nonatomic, nullable, copy) NSURL *imagesSecureBaseURL;
+@end
 
-@property (nonatomic, nullable, copy) NSArray *imagesPosterSizes;
-@property (nonatomic, nullable, copy) NSArray *imagesBackdropSizes;
-@property (nonatomic, nullable, copy) NSArray *imagesProfileSizes;
-@property (nonatomic, nullable, copy) NSArray *imagesLogoSizes;
+#pragma mark -
 
-@property (nonatomic, nullable, copy) NSArray *changeKeys;
+@interface TMDBConfiguration ()
+
+@property (atomic, getter=isLoaded) BOOL loaded;
+@property (atomic, nullable, copy) NSDate *lastUpdated;
+
+// Populated on the work queue while image URLs are resolved on any thread
+@property (atomic, nullable, strong) TMDBConfigurationValues *values;
 
 @end
 
-@implementation TMDBConfiguration
+@implementation TMDBConfiguration {
+@private
+	// The context owns the configuration
+	__weak TMDB *_context;
+}
 
 @synthesize loaded=_isLoaded;
 
-- (void)reload:(void (^_Nullable)(NSError * _Nullable))completionBlock {
-	TMDB *context = [TMDB sharedInstance];
+- (instancetype)init {
+	return (self = [self initWithContext:nil]);
+}
+
+- (instancetype)initWithContext:(TMDB *)context {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_context = context;
+	_snapshotLifetime = TMDBConfigurationDefaultSnapshotLifetime;
+
+	[self loadSnapshot];
+
+	return self;
+}
+
+- (TMDBRequestToken *)reload:(void (^_Nullable)(NSError * _Nullable))completionBlock {
+	TMDB *context = self.context;
 
 	NSString *configURLString = [NSString stringWithFormat:@"%@%@/configuration?api_key=%@", TMDBAPIURLBase, TMDBAPIVersion, context.apiKey];
 	NSURL *configURL = [NSURL URLWithString:configURLString];
 
-	TMDBRequest *request = [TMDBRequest requestWithURL:configURL completionBlock:^(id parsedData, NSError *error) {
+	dispatch_queue_t queue = context.completionQueue;
+	TMDBRequestToken *token = [[TMDBRequestToken alloc] init];
+	__weak TMDBRequestToken *weakToken = token;
+
+	if (configURL == nil) {
+		TMDBLog(@"Could not create request for configuration.");
+		if (completionBlock != nil) {
+			NSError *error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidURL userInfo:nil];
+			dispatch_async(queue, ^{
+				completionBlock(error);
+			});
+		}
+		return token;
+	}
+
+	[token setSubscription:[TMDBRequest requestWithURL:configURL context:context completionBlock:^(id parsedData, NSError *error) {
+		TMDBRequestMetrics *metrics = TMDBRequestMetricsCurrent();
+
 		if (error != nil) {
 			if (completionBlock != nil) {
-				completionBlock(error);
+				TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+					if (!weakToken.isCancelled) {
+						completionBlock(error);
+					}
+				});
 			}
 			return;
 		}
 
 		if (parsedData == nil || ![parsedData isKindOfClass:[NSDictionary class]]) {
 			TMDBLog(@"Configuration response was empty or invalid.");
-			// TODO: Create error object and call completion block
+			if (completionBlock != nil) {
+				NSError *invalidDataError = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeReceivedInvalidData userInfo:nil];
+				TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+					if (!weakToken.isCancelled) {
+						completionBlock(invalidDataError);
+					}
+				});
+			}
 			return;
 		}
 
-		[self populateWithDictionary:(NSDictionary *)parsedData];
+		NSDate *now = [NSDate date];
 
+		[self populateWithDictionary:(NSDictionary *)parsedData];
+		self.lastUpdated = now;
 		self.loaded = YES;
+		[metrics addDuration:-now.timeIntervalSinceNow toPhase:TMDBRequestPhasePopulate];
+
+		[self storeSnapshot:(NSDictionary *)parsedData date:now];
 
 		if (completionBlock != nil) {
-			completionBlock(nil);
+			TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+				if (!weakToken.isCancelled) {
+					completionBlock(nil);
+				}
+			});
 		}
-	}];
+	}]];
 
-	if (request == nil) {
-		TMDBLog(@"Could not create request for configuration.");
+	return token;
+}
+
+- (TMDBRequestToken *)reloadIfNeeded:(void (^_Nullable)(NSError * _Nullable))completionBlock {
+	if (self.isStale) {
+		return [self reload:completionBlock];
+	}
+
+	if (completionBlock != nil) {
+		dispatch_async(self.context.completionQueue, ^{
+			completionBlock(nil);
+		});
+	}
+
+	return [[TMDBRequestToken alloc] init];
+}
+
+// Private
+- (TMDB *)context {
+	return _context ?: [TMDB sharedInstance];
+}
+
+- (BOOL)isStale {
+	NSDate *lastUpdated = self.lastUpdated;
+	return !self.isLoaded || lastUpdated == nil || -lastUpdated.timeIntervalSinceNow > self.snapshotLifetime;
+}
+
+#pragma mark - Snapshots
+
+// Private
++ (NSURL *)snapshotURL {
+	NSURL *cachesURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+	return [cachesURL URLByAppendingPathComponent:@"dk.devify.tmdb/Configuration.plist" isDirectory:NO];
+}
+
+// Private. Called while initializing, so it's small enough to read right away.
+- (void)loadSnapshot {
+	NSURL *snapshotURL = [TMDBConfiguration snapshotURL];
+	if (snapshotURL == nil) {
+		return;
+	}
+
+	NSDictionary *snapshot = [NSDictionary dictionaryWithContentsOfURL:snapshotURL];
+	NSDictionary *d = TMDB_NSDictionaryOrNil(snapshot[TMDBConfigurationSnapshotDataKey]);
+	NSDate *storedAt = TMDB_ObjectOfClassOrNil(snapshot[TMDBConfigurationSnapshotDateKey], [NSDate class]);
+
+	if (d == nil || storedAt == nil) {
+		return;
+	}
+
+	[self populateWithDictionary:d];
+	self.lastUpdated = storedAt;
+	self.loaded = YES;
+}
+
+// Private
+- (void)storeSnapshot:(NSDictionary *)d date:(NSDate *)date {
+	NSURL *snapshotURL = [TMDBConfiguration snapshotURL];
+	if (snapshotURL == nil) {
+		return;
+	}
+
+	NSDictionary *snapshot = @{
+		TMDBConfigurationSnapshotDataKey: d,
+		TMDBConfigurationSnapshotDateKey: date
+	};
+
+	[[NSFileManager defaultManager] createDirectoryAtURL:snapshotURL.URLByDeletingLastPathComponent withIntermediateDirectories:YES attributes:nil error:nil];
+
+	// Fails for responses that can't be written as a property list, such as
+	// ones containing null values. Those are simply loaded again next time.
+	if (![snapshot writeToURL:snapshotURL atomically:YES]) {
+		TMDBLog(@"iTMDb: Could not store configuration snapshot at %@", snapshotURL);
 	}
 }
 
 #pragma mark -
 
 - (void)populateWithDictionary:(NSDictionary *)d {
-	self.imagesBaseURL = TMDB_NSURLOrNilFromStringOrNil(d[@"images"][@"base_url"]);
-	self.imagesSecureBaseURL = TMDB_NSURLOrNilFromStringOrNil(d[@"images"][@"secure_base_url"]);
+	self.values = [[TMDBConfigurationValues alloc] initWithDictionary:d];
+}
+
+#pragma mark - Values
+
+- (NSURL *)imagesBaseURL {
+	return self.values.imagesBaseURL;
+}
+
+- (NSURL *)imagesSecureBaseURL {
+	return self.values.imagesSecureBaseURL;
+}
+
+- (NSArray *)imagesPosterSizes {
+	return self.values.imagesPosterSizes;
+}
+
+- (NSArray *)imagesBackdropSizes {
+	return self.values.imagesBackdropSizes;
+}
+
+- (NSArray *)imagesProfileSizes {
+	return self.values.imagesProfileSizes;
+}
 
-	self.imagesPosterSizes = TMDB_NSArrayOrNil(d[@"images"][@"poster_sizes"]);
-	self.imagesBackdropSizes = TMDB_NSArrayOrNil(d[@"images"][@"backdrop_sizes"]);
-	self.imagesProfileSizes = TMDB_NSArrayOrNil(d[@"images"][@"profile_sizes"]);
-	self.imagesLogoSizes = TMDB_NSArrayOrNil(d[@"images"][@"logo_sizes"]);
+- (NSArray *)imagesLogoSizes {
+	return self.values.imagesLogoSizes;
+}
+
+- (NSArray *)changeKeys {
+	return self.values.changeKeys;
+}
+
+#pragma mark - Image Sizes
+
+- (NSString *)imageSizeClosestMatchingSize:(float)size imageType:(TMDBImageType)imageType dimension:(TMDBImageSize)dimension {
+	return [self.values.sizeIndexes[@(imageType)] sizeClosestMatchingSize:size dimension:dimension];
+}
+
+- (TMDBImageSizeIndex *)sizeIndexForSizes:(NSArray<NSString *> *)sizes {
+	for (TMDBImageSizeIndex *index in self.values.sizeIndexes.allValues) {
+		if (index.sizes == sizes) {
+			return index;
+		}
+	}
+
+	return nil;
+}
+
+- (NSString *)imageURLPrefixForSize:(NSString *)size {
+	TMDBConfigurationValues *values = self.values;
+	NSString *prefix = values.imageURLPrefixes[size];
+	if (prefix != nil) {
+		return prefix;
+	}
 
-	self.changeKeys = TMDB_NSArrayOrNil(d[@"change_keys"]);
+	// Sizes that aren't in the configuration still work, just more slowly
+	NSString *baseURLString = values.imagesBaseURLString;
+	return baseURLString != nil ? [NSString stringWithFormat:@"%@/%@", baseURLString, size] : nil;
 }
 
 @end
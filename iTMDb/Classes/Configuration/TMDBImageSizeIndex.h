@@ -0,0 +1,34 @@
+//
+//  TMDBImageSizeIndex.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBImage.h"
+
+/**
+ * The image sizes of one image type, parsed once and sorted by pixel size, so
+ * finding the best size for a view is a binary search.
+ */
+// Private class
+@interface TMDBImageSizeIndex : NSObject
+
+- (nonnull instancetype)initWithSizes:(nonnull NSArray<NSString *> *)sizes NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+/** The sizes the index was created with, in their original order. */
+@property (nonatomic, copy, nonnull, readonly) NSArray<NSString *> *sizes;
+
+/**
+ * Returns the smallest size in `dimension` that is at least `size` pixels, or
+ * the largest one if none are. Returns the first size if there are none in
+ * `dimension`, just like `+[TMDBImage sizeClosestMatchingSize:inSizes:dimension:]`.
+ */
+- (nullable NSString *)sizeClosestMatchingSize:(float)size dimension:(TMDBImageSize)dimension;
+
+@end
@@ -0,0 +1,115 @@
+//
+//  TMDBImageSizeIndex.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBImageSizeIndex.h"
+
+typedef struct {
+	float pixels;
+	// Retained by the index's sizes array
+	__unsafe_unretained NSString *name;
+} TMDBImageSizeIndexEntry;
+
+static int TMDBImageSizeIndexEntryCompare(const void *a, const void *b) {
+	float pa = ((const TMDBImageSizeIndexEntry *)a)->pixels, pb = ((const TMDBImageSizeIndexEntry *)b)->pixels;
+	return pa < pb ? -1 : (pa > pb ? 1 : 0);
+}
+
+@implementation TMDBImageSizeIndex {
+@private
+	TMDBImageSizeIndexEntry *_widths;
+	NSUInteger _widthCount;
+	TMDBImageSizeIndexEntry *_heights;
+	NSUInteger _heightCount;
+	NSString *_original;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithSizes:(NSArray<NSString *> *)sizes {
+	NSParameterAssert(sizes != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_sizes = [sizes copy];
+	_widths = calloc(MAX(_sizes.count, 1), sizeof(TMDBImageSizeIndexEntry));
+	_heights = calloc(MAX(_sizes.count, 1), sizeof(TMDBImageSizeIndexEntry));
+
+	for (NSString *size in _sizes) {
+		if (TMDB_NSStringOrNil(size) == nil) {
+			continue;
+		}
+
+		TMDBImageSize dimension = TMDBImageSizeOriginal;
+		float pixels = (float)[TMDBImage sizeFromString:size imageSize:&dimension];
+
+		if (dimension == TMDBImageSizeWidth) {
+			_widths[_widthCount++] = (TMDBImageSizeIndexEntry){pixels, size};
+		}
+		else if (dimension == TMDBImageSizeHeight) {
+			_heights[_heightCount++] = (TMDBImageSizeIndexEntry){pixels, size};
+		}
+		else if (_original == nil && pixels < 0) {
+			_original = size;
+		}
+	}
+
+	qsort(_widths, _widthCount, sizeof(TMDBImageSizeIndexEntry), TMDBImageSizeIndexEntryCompare);
+	qsort(_heights, _heightCount, sizeof(TMDBImageSizeIndexEntry), TMDBImageSizeIndexEntryCompare);
+
+	return self;
+}
+
+- (void)dealloc {
+	free(_widths);
+	free(_heights);
+}
+
+- (NSString *)sizeClosestMatchingSize:(float)size dimension:(TMDBImageSize)dimension {
+	const TMDBImageSizeIndexEntry *entries = NULL;
+	NSUInteger count = 0;
+
+	switch (dimension) {
+		case TMDBImageSizeWidth:
+			entries = _widths;
+			count = _widthCount;
+			break;
+
+		case TMDBImageSizeHeight:
+			entries = _heights;
+			count = _heightCount;
+			break;
+
+		case TMDBImageSizeOriginal:
+			return _original ?: _sizes.firstObject;
+	}
+
+	if (count == 0) {
+		return _sizes.firstObject;
+	}
+
+	// Find the first entry at least `size` pixels large
+	NSUInteger low = 0, high = count;
+	while (low < high) {
+		NSUInteger middle = low + (high - low) / 2;
+		if (entries[middle].pixels < size) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	return entries[MIN(low, count - 1)].name;
+}
+
+@end
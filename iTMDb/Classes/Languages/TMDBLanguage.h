@@ -8,10 +8,24 @@
 
 @import Foundation;
 
+@class TMDB;
+
 @interface TMDBLanguage : NSObject
 
+/**
+ * Returns the languages described by `rawLanguagesDictionaries`. Languages are
+ * shared by ISO 639-1 code, so every movie speaking English refers to the same
+ * `TMDBLanguage` object.
+ */
 + (nonnull NSArray<TMDBLanguage *> *)languagesFromArrayOfDictionaries:(nonnull NSArray<NSDictionary *> *)rawLanguagesDictionaries;
 
+/**
+ * Returns the languages described by `rawLanguagesDictionaries`, shared
+ * through the identity map of `context`. Pass `nil` to use the shared
+ * instance.
+ */
++ (nonnull NSArray<TMDBLanguage *> *)languagesFromArrayOfDictionaries:(nonnull NSArray<NSDictionary *> *)rawLanguagesDictionaries context:(nullable TMDB *)context;
+
 - (nonnull instancetype)initWithDictionary:(nonnull NSDictionary *)dictionary NS_DESIGNATED_INITIALIZER;
 
 @property (nonatomic, copy, nullable, readonly) NSString *name;
@@ -8,10 +8,16 @@
 
 #import "TMDBLanguage.h"
 #import "TMDB.h"
+#import "TMDB+Private.h"
+#import "TMDBIdentityMap.h"
 
 @implementation TMDBLanguage
 
 + (nonnull NSArray<TMDBLanguage *> *)languagesFromArrayOfDictionaries:(nonnull NSArray<NSDictionary *> *)rawLanguagesDictionaries {
+	return [self languagesFromArrayOfDictionaries:rawLanguagesDictionaries context:nil];
+}
+
++ (nonnull NSArray<TMDBLanguage *> *)languagesFromArrayOfDictionaries:(nonnull NSArray<NSDictionary *> *)rawLanguagesDictionaries context:(nullable TMDB *)context {
 	if (rawLanguagesDictionaries == nil) {
 		return nil;
 	}
@@ -31,9 +37,14 @@
 	}
 
 	NSMutableArray *languages = [NSMutableArray array];
+	TMDBIdentityMap *identityMap = (context ?: [TMDB sharedInstance]).identityMap;
 
 	for (NSDictionary *rawLanguage in rawLanguagesDictionaries) {
-		TMDBLanguage *language = [[TMDBLanguage alloc] initWithDictionary:rawLanguage];
+		if (TMDB_NSDictionaryOrNil(rawLanguage) == nil) {
+			continue;
+		}
+
+		TMDBLanguage *language = [identityMap languageWithDictionary:rawLanguage];
 
 		if (language != nil) {
 			[languages addObject:language];
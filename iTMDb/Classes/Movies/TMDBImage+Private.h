@@ -0,0 +1,29 @@
+//
+//  TMDBImage+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBImage.h"
+
+// Private methods shared with the other model classes
+@interface TMDBImage (Private)
+
+/**
+ * Like `+imageArrayWithRawImageDictionaries:ofType:`, for images whose URLs
+ * are built from the configuration of `context`.
+ */
++ (nonnull NSArray<TMDBImage *> *)imageArrayWithRawImageDictionaries:(nonnull NSArray<NSDictionary *> *)rawImages ofType:(TMDBImageType)aType context:(nullable TMDB *)context;
+
+/** The path of the image file, such as `/abc.jpg`, shared by all sizes. */
+- (nullable NSString *)filePath;
+
+/**
+ * Returns the image in the shape of a TMDb response, which
+ * `-initWithDictionary:type:` turns back into an equal image.
+ */
+- (nonnull NSDictionary *)responseDictionary;
+
+@end
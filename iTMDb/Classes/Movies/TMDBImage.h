@@ -11,7 +11,9 @@
 
 typedef NS_ENUM(NSUInteger, TMDBImageType) {
 	TMDBImageTypePoster,
-	TMDBImageTypeBackdrop
+	TMDBImageTypeBackdrop,
+	TMDBImageTypeProfile,
+	TMDBImageTypeLogo
 };
 
 /**
@@ -23,11 +25,19 @@ typedef NS_ENUM(NSUInteger, TMDBImageSize) {
 	TMDBImageSizeHeight
 };
 
+@class TMDB;
+
 /**
  * A `TMDBImage` object represents an image in one-to-many sizes.
  */
 @interface TMDBImage : NSObject
 
+/**
+ * The context whose configuration the image URLs are built from. Images of a
+ * movie share the movie's context.
+ */
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
+
 @property (nonatomic, readonly) TMDBImageType type;
 @property (nonatomic, readonly) CGSize originalSize;
 @property (nonatomic, copy, nullable, readonly) NSString *iso639_1; // Two-letter language code
@@ -43,8 +53,20 @@ typedef NS_ENUM(NSUInteger, TMDBImageSize) {
 
 /** @name Getting URLs */
 
+/**
+ * Returns the URL of the image in the given size, such as `w500`. The URL
+ * prefix of every size listed in the configuration is worked out when the
+ * configuration loads, so this is a single string join.
+ */
 - (nullable NSURL *)urlForSize:(nonnull NSString *)size;
 
+/**
+ * Returns the URL of the image in the configured size closest matching
+ * `size` pixels in `dimension`, as picked by
+ * `-[TMDBConfiguration imageSizeClosestMatchingSize:imageType:dimension:]`.
+ */
+- (nullable NSURL *)urlForClosestSize:(float)size dimension:(TMDBImageSize)dimension;
+
 /** @name Getting Sizes */
 
 /**
@@ -69,6 +91,9 @@ typedef NS_ENUM(NSUInteger, TMDBImageSize) {
  * returned.
  * @return An `NSString` representing the `size` in the specified `dimension`,
  * or nil if no such exist.
+ *
+ * Passing one of the `TMDBConfiguration` size arrays uses the index built when
+ * the configuration loaded, instead of parsing every size again.
  */
 + (nullable NSString *)sizeClosestMatchingSize:(float)size inSizes:(nonnull NSArray<NSString *> *)sizes dimension:(TMDBImageSize)dimension;
 
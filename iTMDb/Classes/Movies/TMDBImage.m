@@ -6,22 +6,33 @@
 //  Copyright (c) 2010 Devify. All rights reserved.
 //
 
-#import "TMDBImage.h"
+#import "TMDBImage+Private.h"
 #import "TMDB.h"
+#import "TMDBFootprint.h"
+#import "TMDBConfiguration+Private.h"
+#import "TMDBImageSizeIndex.h"
 
 @interface TMDBImage ()
 
 @property (nonatomic, nullable, copy) NSString *filePath;
+@property (nonatomic, strong, nonnull) TMDB *context;
 
 @end
 
 @implementation TMDBImage
 
 + (nonnull NSArray<TMDBImage *> *)imageArrayWithRawImageDictionaries:(nonnull NSArray<NSDictionary *> *)rawImages ofType:(TMDBImageType)aType {
+	return [self imageArrayWithRawImageDictionaries:rawImages ofType:aType context:nil];
+}
+
++ (nonnull NSArray<TMDBImage *> *)imageArrayWithRawImageDictionaries:(nonnull NSArray<NSDictionary *> *)rawImages ofType:(TMDBImageType)aType context:(TMDB *)context {
 	NSMutableArray *images = [NSMutableArray array];
 
 	for (NSDictionary *imageDict in rawImages) {
 		TMDBImage *currentImage = [[TMDBImage alloc] initWithDictionary:imageDict type:aType];
+		if (context != nil) {
+			currentImage.context = context;
+		}
 		[images addObject:currentImage];
 	}
 
@@ -37,6 +48,7 @@
 		return nil;
 	}
 
+	_context = [TMDB sharedInstance];
 	_type = type;
 	_filePath = [TMDB_NSStringOrNil(d[@"file_path"]) copy];
 	_originalSize = CGSizeMake(TMDB_NSNumberOrNil(d[@"width"]).doubleValue, TMDB_NSNumberOrNil(d[@"height"]).doubleValue);
@@ -47,21 +59,59 @@
 	return self;
 }
 
+- (NSDictionary *)responseDictionary {
+	NSMutableDictionary *d = [NSMutableDictionary dictionaryWithCapacity:6];
+
+	d[@"file_path"] = _filePath;
+	d[@"iso_639_1"] = _iso639_1;
+	d[@"width"] = @(_originalSize.width);
+	d[@"height"] = @(_originalSize.height);
+	d[@"vote_average"] = @(_voteAverage);
+	d[@"vote_count"] = @(_voteCount);
+
+	return d;
+}
+
+- (NSUInteger)footprint {
+	return TMDBFootprintOfObject(self) + TMDBFootprintOfString(_filePath) + TMDBFootprintOfString(_iso639_1);
+}
+
 #pragma mark - URLs
 
 - (NSURL *)urlForSize:(NSString *)size {
-	TMDB *context = [TMDB sharedInstance];
-	return [[context.configuration.imagesBaseURL URLByAppendingPathComponent:size] URLByAppendingPathComponent:self.filePath];
+	NSString *filePath = self.filePath;
+	NSString *prefix = [self.context.configuration imageURLPrefixForSize:size];
+
+	if (prefix == nil || filePath.length == 0) {
+		return nil;
+	}
+
+	// File paths from TMDb start with a slash, and prefixes never end in one.
+	if ([filePath characterAtIndex:0] != '/') {
+		return [NSURL URLWithString:[NSString stringWithFormat:@"%@/%@", prefix, filePath]];
+	}
+
+	return [NSURL URLWithString:[prefix stringByAppendingString:filePath]];
+}
+
+- (NSURL *)urlForClosestSize:(float)size dimension:(TMDBImageSize)dimension {
+	NSString *sizeString = [self.context.configuration imageSizeClosestMatchingSize:size imageType:self.type dimension:dimension];
+	if (sizeString == nil) {
+		return nil;
+	}
+
+	return [self urlForSize:sizeString];
 }
 
 #pragma mark - Sizes
 
 + (CGFloat)sizeFromString:(NSString *)s imageSize:(TMDBImageSize *)outImageSize {
-	if (s.length == 0) {
+	NSUInteger length = s.length;
+	if (length == 0) {
 		return -1.0f;
 	}
 
-	if ([s.lowercaseString isEqualToString:@"original"]) {
+	if (length == 8 && [s caseInsensitiveCompare:@"original"] == NSOrderedSame) {
 		if (outImageSize != nil) {
 			*outImageSize = TMDBImageSizeOriginal;
 		}
@@ -69,19 +119,29 @@
 		return -1.0f;
 	}
 
+	// Sizes are short, so read them straight off the characters rather than
+	// creating substrings.
+	unichar characters[16];
+	NSUInteger count = MIN(length, (NSUInteger)16);
+	[s getCharacters:characters range:NSMakeRange(0, count)];
+
 	if (outImageSize != nil) {
-		NSString *prefix = [s substringToIndex:1].lowercaseString;
+		unichar prefix = characters[0];
 
-		if ([prefix isEqualToString:@"w"]) {
+		if (prefix == 'w' || prefix == 'W') {
 			*outImageSize = TMDBImageSizeWidth;
 		}
-		else if ([prefix isEqualToString:@"h"]) {
+		else if (prefix == 'h' || prefix == 'H') {
 			*outImageSize = TMDBImageSizeHeight;
 		}
 	}
 
-	NSString *size = [s substringFromIndex:1];
-	return size.floatValue;
+	float size = 0.0f;
+	for (NSUInteger i = 1; i < count && characters[i] >= '0' && characters[i] <= '9'; i++) {
+		size = size * 10.0f + (characters[i] - '0');
+	}
+
+	return size;
 }
 
 + (nullable NSString *)sizeClosestMatchingSize:(float)size inSizes:(nonnull NSArray<NSString *> *)sizes dimension:(TMDBImageSize)dimension {
@@ -89,32 +149,12 @@
 		return nil;
 	}
 
-	CGFloat closestMatch = 0.0;
-	NSString *closestMatchString = nil;
-
-	for (NSString *s in sizes) {
-		TMDBImageSize dim = TMDBImageSizeOriginal;
-		CGFloat is = [TMDBImage sizeFromString:s imageSize:&dim];
-
-		if (dim != dimension) {
-			continue;
-		}
-
-		if (is < closestMatch || (closestMatch > size && is > size)) {
-			continue;
-		}
-
-		closestMatch = is;
-		closestMatchString = s;
-
-		// Don't break, as the sizes might not be in order
-	}
-
-	if (closestMatchString == nil) {
-		return sizes.firstObject;
+	TMDBImageSizeIndex *index = [[TMDB sharedInstance].configuration sizeIndexForSizes:sizes];
+	if (index == nil) {
+		index = [[TMDBImageSizeIndex alloc] initWithSizes:sizes];
 	}
 
-	return closestMatchString;
+	return [index sizeClosestMatchingSize:size dimension:dimension];
 }
 
 #pragma mark -
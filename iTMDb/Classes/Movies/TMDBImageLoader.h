@@ -0,0 +1,99 @@
+//
+//  TMDBImageLoader.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBImage.h"
+
+typedef void (^TMDBImageLoadCompletionBlock)(NSData * _Nullable data, NSError * _Nullable error);
+
+/**
+ * A caller's interest in an image being loaded by a `TMDBImageLoader`.
+ */
+@interface TMDBImageLoadToken : NSObject
+
+/**
+ * The priority of the load. Changing it reorders the load among those still
+ * waiting to start. Identical loads share a single download, which runs at
+ * the highest priority of its tokens.
+ */
+@property (atomic) NSOperationQueuePriority priority;
+
+/** A Boolean value indicating if the token has been cancelled. */
+@property (atomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ * Stops the completion block from being called, even if the load has already
+ * finished and the block is about to be called. The download itself is only
+ * cancelled once no other tokens are waiting for it.
+ */
+- (void)cancel;
+
+@end
+
+/**
+ * A `TMDBImageLoader` downloads the image data of `TMDBImage` objects, such as
+ * posters and backdrops.
+ *
+ * Images are keyed by file path and size. Requests for an image already being
+ * loaded share the download, and loaded images are kept in a memory cache and
+ * a disk cache, each with a byte budget. The data is returned as is, so it can
+ * be turned into an image by the platform's own image class.
+ */
+@interface TMDBImageLoader : NSObject
+
+/** @name Getting the Shared Loader */
+
+/** The loader shared by the whole process, caching in the caches directory. */
++ (nonnull instancetype)sharedLoader;
+
+/**
+ * Creates a loader that caches on disk in `directoryURL`, or only in memory if
+ * `directoryURL` is `nil`.
+ */
+- (nonnull instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL NS_DESIGNATED_INITIALIZER;
+
+/** @name Configuring the Loader */
+
+/** The number of images downloaded at the same time. Default `4`. */
+@property (atomic) NSUInteger maximumConcurrentLoads;
+
+/** The number of bytes of image data kept in memory. Default 20 MB. */
+@property (atomic) NSUInteger memoryCapacity;
+
+/** The number of bytes of image data kept on disk. Default 100 MB. */
+@property (atomic) NSUInteger diskCapacity;
+
+/**
+ * The queue on which completion blocks are called. Default is the context's
+ * `completionQueue`.
+ */
+@property (atomic, strong, null_resettable) dispatch_queue_t completionQueue;
+
+/** @name Loading Images */
+
+/**
+ * Loads `image` in the given size, such as `w500`.
+ *
+ * @return A token for changing the priority of the load or cancelling it.
+ */
+- (nonnull TMDBImageLoadToken *)loadImage:(nonnull TMDBImage *)image size:(nonnull NSString *)size priority:(NSOperationQueuePriority)priority completion:(nonnull TMDBImageLoadCompletionBlock)completionBlock;
+
+/**
+ * Loads `image` in the configured size closest matching `size` pixels in
+ * `dimension`, as picked by
+ * `-[TMDBConfiguration imageSizeClosestMatchingSize:imageType:dimension:]`.
+ */
+- (nonnull TMDBImageLoadToken *)loadImage:(nonnull TMDBImage *)image closestToSize:(float)size dimension:(TMDBImageSize)dimension priority:(NSOperationQueuePriority)priority completion:(nonnull TMDBImageLoadCompletionBlock)completionBlock;
+
+/** @name Managing the Caches */
+
+/** Removes all images from memory and disk. */
+- (void)removeAllImages;
+
+@end
@@ -0,0 +1,588 @@
+//
+//  TMDBImageLoader.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBImageLoader.h"
+#import "TMDBImage+Private.h"
+#import "TMDB.h"
+#import "TMDBRequest.h"
+#import "TMDBResponseCache.h"
+
+@class TMDBImageLoadOperation;
+
+@interface TMDBImageLoader ()
+
+- (void)cancelToken:(nonnull TMDBImageLoadToken *)token;
+- (void)updatePriorityOfOperation:(nonnull TMDBImageLoadOperation *)operation;
+- (void)operation:(nonnull TMDBImageLoadOperation *)operation didFinishWithData:(nullable NSData *)data error:(nullable NSError *)error fromDisk:(BOOL)fromDisk;
+
+@end
+
+@interface TMDBImageLoadToken ()
+
+- (nonnull instancetype)initWithLoader:(nullable TMDBImageLoader *)loader completion:(nonnull TMDBImageLoadCompletionBlock)completionBlock NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, weak, nullable) TMDBImageLoader *loader;
+@property (nonatomic, copy, nonnull, readonly) TMDBImageLoadCompletionBlock completionBlock;
+
+// Only touched while holding the loader's lock
+@property (nonatomic, strong, nullable) TMDBImageLoadOperation *operation;
+
+@end
+
+#pragma mark -
+
+// Private class
+@interface TMDBImageLoadOperation : NSOperation <TMDBTransportDelegate>
+
+- (nonnull instancetype)initWithKey:(nonnull NSString *)key URL:(nonnull NSURL *)url loader:(nonnull TMDBImageLoader *)loader NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, copy, nonnull, readonly) NSString *key;
+@property (nonatomic, copy, nonnull, readonly) NSURL *url;
+
+// Only touched while holding the loader's lock
+@property (nonatomic, strong, nonnull, readonly) NSMutableArray<TMDBImageLoadToken *> *tokens;
+
+@end
+
+@implementation TMDBImageLoadOperation {
+@private
+	__weak TMDBImageLoader *_loader;
+	id<TMDBTransportTask> _task;
+	NSMutableData *_data;
+	NSInteger _statusCode;
+	BOOL _isExecuting;
+	BOOL _isFinished;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithKey:(NSString *)key URL:(NSURL *)url loader:(TMDBImageLoader *)loader {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_key = [key copy];
+	_url = [url copy];
+	_loader = loader;
+	_tokens = [NSMutableArray array];
+	self.name = url.description;
+
+	return self;
+}
+
+- (BOOL)isAsynchronous {
+	return YES;
+}
+
+- (BOOL)isExecuting {
+	@synchronized(self) {
+		return _isExecuting;
+	}
+}
+
+- (BOOL)isFinished {
+	@synchronized(self) {
+		return _isFinished;
+	}
+}
+
+- (void)start {
+	if (self.isCancelled) {
+		[self finishWithData:nil error:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+		return;
+	}
+
+	[self willChangeValueForKey:@"isExecuting"];
+	@synchronized(self) {
+		_isExecuting = YES;
+	}
+	[self didChangeValueForKey:@"isExecuting"];
+
+	_data = [NSMutableData data];
+
+	NSMutableURLRequest *req = [NSMutableURLRequest requestWithURL:self.url
+													   cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+												   timeoutInterval:30.0];
+	[req setValue:@"image/*" forHTTPHeaderField:@"Accept"];
+
+	id<TMDBTransportTask> task = [[TMDBRequest transport] startTaskWithRequest:req delegate:self];
+
+	@synchronized(self) {
+		_task = task;
+	}
+
+	if (task == nil) {
+		[self finishWithData:nil error:[NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidURL userInfo:nil]];
+	}
+	else if (self.isCancelled) {
+		[task cancel];
+	}
+}
+
+- (void)cancel {
+	[super cancel];
+
+	id<TMDBTransportTask> task = nil;
+	@synchronized(self) {
+		task = _task;
+	}
+	[task cancel];
+}
+
+- (void)finishWithData:(NSData *)data error:(NSError *)error {
+	[_loader operation:self didFinishWithData:data error:error fromDisk:NO];
+
+	[self willChangeValueForKey:@"isExecuting"];
+	[self willChangeValueForKey:@"isFinished"];
+	@synchronized(self) {
+		_task = nil;
+		_isExecuting = NO;
+		_isFinished = YES;
+	}
+	[self didChangeValueForKey:@"isFinished"];
+	[self didChangeValueForKey:@"isExecuting"];
+}
+
+#pragma mark - TMDBTransportDelegate
+
+- (void)transportTask:(id<TMDBTransportTask>)task didReceiveResponse:(NSURLResponse *)response {
+	_data.length = 0;
+	_statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 200;
+}
+
+- (void)transportTask:(id<TMDBTransportTask>)task didReceiveData:(NSData *)data {
+	[_data appendData:data];
+}
+
+- (void)transportTask:(id<TMDBTransportTask>)task didCompleteWithError:(NSError *)error {
+	if (error == nil && (_statusCode != 200 || _data.length == 0)) {
+		error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeReceivedInvalidData userInfo:nil];
+	}
+
+	[self finishWithData:(error == nil ? [_data copy] : nil) error:error];
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBImageLoadToken {
+@private
+	NSOperationQueuePriority _priority;
+	BOOL _isCancelled;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithLoader:(TMDBImageLoader *)loader completion:(TMDBImageLoadCompletionBlock)completionBlock {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_loader = loader;
+	_completionBlock = [completionBlock copy];
+
+	return self;
+}
+
+- (NSOperationQueuePriority)priority {
+	@synchronized(self) {
+		return _priority;
+	}
+}
+
+- (void)setPriority:(NSOperationQueuePriority)priority {
+	@synchronized(self) {
+		_priority = priority;
+	}
+
+	TMDBImageLoadOperation *operation = self.operation;
+	if (operation != nil) {
+		[self.loader updatePriorityOfOperation:operation];
+	}
+}
+
+- (BOOL)isCancelled {
+	@synchronized(self) {
+		return _isCancelled;
+	}
+}
+
+- (void)cancel {
+	@synchronized(self) {
+		_isCancelled = YES;
+	}
+
+	[self.loader cancelToken:self];
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBImageLoader {
+@private
+	NSLock *_lock;
+	NSMutableDictionary<NSString *, TMDBImageLoadOperation *> *_operations;
+	NSOperationQueue *_queue;
+	NSCache<NSString *, NSData *> *_memoryCache;
+	dispatch_queue_t _completionQueue;
+
+	NSURL *_directoryURL;
+	dispatch_queue_t _ioQueue;
+	unsigned long long _diskUsage;
+	BOOL _diskUsageKnown;
+}
+
++ (instancetype)sharedLoader {
+	static TMDBImageLoader *sharedLoader;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		NSURL *cachesURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+		NSURL *directoryURL = [cachesURL URLByAppendingPathComponent:@"dk.devify.tmdb/Images" isDirectory:YES];
+		sharedLoader = [[self alloc] initWithDirectoryURL:directoryURL];
+	});
+	return sharedLoader;
+}
+
+- (instancetype)init {
+	return (self = [self initWithDirectoryURL:nil]);
+}
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_lock = [[NSLock alloc] init];
+	_operations = [NSMutableDictionary dictionary];
+
+	_queue = [[NSOperationQueue alloc] init];
+	_queue.name = [NSStringFromClass(self.class) stringByAppendingString:@"Queue"];
+	_queue.maxConcurrentOperationCount = 4;
+
+	// NSCache also gives up its contents when the system is low on memory
+	_memoryCache = [[NSCache alloc] init];
+	_memoryCache.totalCostLimit = 20 * 1024 * 1024;
+
+	_diskCapacity = 100 * 1024 * 1024;
+	_directoryURL = [directoryURL copy];
+	_ioQueue = dispatch_queue_create("dk.devify.tmdb.imageloader", DISPATCH_QUEUE_SERIAL);
+
+	if (_directoryURL != nil) {
+		[[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+	}
+
+	return self;
+}
+
+#pragma mark - Configuration
+
+- (NSUInteger)maximumConcurrentLoads {
+	return (NSUInteger)_queue.maxConcurrentOperationCount;
+}
+
+- (void)setMaximumConcurrentLoads:(NSUInteger)maximumConcurrentLoads {
+	_queue.maxConcurrentOperationCount = (NSInteger)MAX(maximumConcurrentLoads, (NSUInteger)1);
+}
+
+- (NSUInteger)memoryCapacity {
+	return _memoryCache.totalCostLimit;
+}
+
+- (void)setMemoryCapacity:(NSUInteger)memoryCapacity {
+	_memoryCache.totalCostLimit = memoryCapacity;
+}
+
+- (dispatch_queue_t)completionQueue {
+	@synchronized(self) {
+		return _completionQueue ?: [TMDB sharedInstance].completionQueue;
+	}
+}
+
+- (void)setCompletionQueue:(dispatch_queue_t)completionQueue {
+	@synchronized(self) {
+		_completionQueue = completionQueue;
+	}
+}
+
+#pragma mark - Loading Images
+
+- (TMDBImageLoadToken *)loadImage:(TMDBImage *)image closestToSize:(float)size dimension:(TMDBImageSize)dimension priority:(NSOperationQueuePriority)priority completion:(TMDBImageLoadCompletionBlock)completionBlock {
+	NSString *sizeString = [image.context.configuration imageSizeClosestMatchingSize:size imageType:image.type dimension:dimension];
+
+	return [self loadImage:image size:sizeString ?: @"original" priority:priority completion:completionBlock];
+}
+
+- (TMDBImageLoadToken *)loadImage:(TMDBImage *)image size:(NSString *)size priority:(NSOperationQueuePriority)priority completion:(TMDBImageLoadCompletionBlock)completionBlock {
+	NSParameterAssert(image != nil);
+	NSParameterAssert(size != nil);
+	NSParameterAssert(completionBlock != nil);
+
+	TMDBImageLoadToken *token = [[TMDBImageLoadToken alloc] initWithLoader:self completion:completionBlock];
+	token.priority = priority;
+
+	dispatch_queue_t completionQueue = self.completionQueue;
+	NSString *filePath = image.filePath;
+	NSURL *url = [image urlForSize:size];
+
+	if (filePath.length == 0 || url == nil) {
+		NSError *error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidURL userInfo:nil];
+		dispatch_async(completionQueue, ^{
+			if (!token.isCancelled) {
+				completionBlock(nil, error);
+			}
+		});
+		return token;
+	}
+
+	// Keyed by path rather than URL, so a new image host in the configuration
+	// doesn't invalidate the caches.
+	NSString *key = [NSString stringWithFormat:@"%@%@", size, filePath];
+
+	NSData *data = [_memoryCache objectForKey:key];
+	if (data != nil) {
+		dispatch_async(completionQueue, ^{
+			if (!token.isCancelled) {
+				completionBlock(data, nil);
+			}
+		});
+		return token;
+	}
+
+	TMDBImageLoadOperation *operation = nil;
+	BOOL isNewOperation = NO;
+
+	[_lock lock];
+	operation = _operations[key];
+	if (operation == nil || operation.isCancelled) {
+		operation = [[TMDBImageLoadOperation alloc] initWithKey:key URL:url loader:self];
+		_operations[key] = operation;
+		isNewOperation = YES;
+	}
+	[operation.tokens addObject:token];
+	token.operation = operation;
+	[_lock unlock];
+
+	[self updatePriorityOfOperation:operation];
+
+	if (isNewOperation) {
+		// Look on disk before queuing the download, so disk hits don't wait
+		// behind downloads for a free slot.
+		dispatch_async(_ioQueue, ^{
+			NSData *diskData = [self diskDataForKey:key];
+			if (diskData != nil) {
+				[self operation:operation didFinishWithData:diskData error:nil fromDisk:YES];
+			}
+			else {
+				[self->_queue addOperation:operation];
+			}
+		});
+	}
+
+	return token;
+}
+
+- (void)cancelToken:(TMDBImageLoadToken *)token {
+	TMDBImageLoadOperation *cancelledOperation = nil;
+
+	[_lock lock];
+	TMDBImageLoadOperation *operation = token.operation;
+	if (operation != nil) {
+		[operation.tokens removeObjectIdenticalTo:token];
+		token.operation = nil;
+
+		if (operation.tokens.count == 0) {
+			if (_operations[operation.key] == operation) {
+				[_operations removeObjectForKey:operation.key];
+			}
+			cancelledOperation = operation;
+		}
+	}
+	[_lock unlock];
+
+	if (cancelledOperation != nil) {
+		[cancelledOperation cancel];
+	}
+	else if (operation != nil) {
+		[self updatePriorityOfOperation:operation];
+	}
+}
+
+- (void)updatePriorityOfOperation:(TMDBImageLoadOperation *)operation {
+	NSOperationQueuePriority priority = NSOperationQueuePriorityVeryLow;
+
+	[_lock lock];
+	for (TMDBImageLoadToken *token in operation.tokens) {
+		priority = MAX(priority, token.priority);
+	}
+	[_lock unlock];
+
+	operation.queuePriority = priority;
+}
+
+- (void)operation:(TMDBImageLoadOperation *)operation didFinishWithData:(NSData *)data error:(NSError *)error fromDisk:(BOOL)fromDisk {
+	NSArray<TMDBImageLoadToken *> *tokens = nil;
+
+	[_lock lock];
+	if (_operations[operation.key] == operation) {
+		[_operations removeObjectForKey:operation.key];
+	}
+	tokens = [operation.tokens copy];
+	[operation.tokens removeAllObjects];
+	for (TMDBImageLoadToken *token in tokens) {
+		token.operation = nil;
+	}
+	[_lock unlock];
+
+	if (data != nil) {
+		[_memoryCache setObject:data forKey:operation.key cost:data.length];
+
+		if (!fromDisk) {
+			[self writeData:data forKey:operation.key];
+		}
+	}
+
+	if (tokens.count == 0) {
+		return;
+	}
+
+	dispatch_queue_t completionQueue = self.completionQueue;
+	// A token may be cancelled after it was detached above, but before its
+	// block runs.
+	for (TMDBImageLoadToken *token in tokens) {
+		dispatch_async(completionQueue, ^{
+			if (!token.isCancelled) {
+				token.completionBlock(data, error);
+			}
+		});
+	}
+}
+
+#pragma mark - Managing the Caches
+
+- (void)removeAllImages {
+	[_memoryCache removeAllObjects];
+
+	if (_directoryURL == nil) {
+		return;
+	}
+
+	dispatch_async(_ioQueue, ^{
+		NSFileManager *fileManager = [NSFileManager defaultManager];
+		[fileManager removeItemAtURL:self->_directoryURL error:nil];
+		[fileManager createDirectoryAtURL:self->_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+		self->_diskUsage = 0;
+		self->_diskUsageKnown = YES;
+	});
+}
+
+#pragma mark - Disk
+
+- (NSURL *)fileURLForKey:(NSString *)key {
+	return [_directoryURL URLByAppendingPathComponent:TMDBCacheFileNameForKey(key) isDirectory:NO];
+}
+
+// Must be called on _ioQueue
+- (NSData *)diskDataForKey:(NSString *)key {
+	if (_directoryURL == nil) {
+		return nil;
+	}
+
+	NSURL *fileURL = [self fileURLForKey:key];
+	NSData *data = [NSData dataWithContentsOfURL:fileURL options:NSDataReadingMappedIfSafe error:nil];
+
+	if (data != nil) {
+		// Touch the file, so trimming removes the least recently used files first
+		[[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate: [NSDate date]} ofItemAtPath:fileURL.path error:nil];
+	}
+
+	return data;
+}
+
+- (void)writeData:(NSData *)data forKey:(NSString *)key {
+	if (_directoryURL == nil || self.diskCapacity == 0) {
+		return;
+	}
+
+	NSURL *fileURL = [self fileURLForKey:key];
+
+	dispatch_async(_ioQueue, ^{
+		[self calculateDiskUsageIfNeeded];
+
+		NSNumber *previousSize = [[NSFileManager defaultManager] attributesOfItemAtPath:fileURL.path error:nil][NSFileSize];
+		if ([data writeToURL:fileURL atomically:YES]) {
+			self->_diskUsage = self->_diskUsage - MIN(previousSize.unsignedLongLongValue, self->_diskUsage) + data.length;
+		}
+
+		[self trimDiskIfNeeded];
+	});
+}
+
+// Must be called on _ioQueue
+- (void)calculateDiskUsageIfNeeded {
+	if (_diskUsageKnown) {
+		return;
+	}
+
+	_diskUsage = 0;
+	for (NSURL *fileURL in [self diskFileURLs]) {
+		NSNumber *size = nil;
+		[fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+		_diskUsage += size.unsignedLongLongValue;
+	}
+	_diskUsageKnown = YES;
+}
+
+// Must be called on _ioQueue
+- (void)trimDiskIfNeeded {
+	unsigned long long diskCapacity = self.diskCapacity;
+	if (_diskUsage <= diskCapacity) {
+		return;
+	}
+
+	// Trim a little further than needed, so not every write ends up trimming
+	unsigned long long targetUsage = diskCapacity / 4 * 3;
+
+	NSArray<NSURL *> *fileURLs = [[self diskFileURLs] sortedArrayUsingComparator:^NSComparisonResult(NSURL *url1, NSURL *url2) {
+		NSDate *date1 = nil, *date2 = nil;
+		[url1 getResourceValue:&date1 forKey:NSURLContentModificationDateKey error:nil];
+		[url2 getResourceValue:&date2 forKey:NSURLContentModificationDateKey error:nil];
+		return [date1 compare:date2];
+	}];
+
+	NSFileManager *fileManager = [NSFileManager defaultManager];
+	for (NSURL *fileURL in fileURLs) {
+		if (_diskUsage <= targetUsage) {
+			break;
+		}
+
+		NSNumber *size = nil;
+		[fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+
+		if ([fileManager removeItemAtURL:fileURL error:nil]) {
+			_diskUsage -= MIN(size.unsignedLongLongValue, _diskUsage);
+		}
+	}
+}
+
+- (NSArray<NSURL *> *)diskFileURLs {
+	NSArray *keys = @[NSURLFileSizeKey, NSURLContentModificationDateKey];
+	return [[NSFileManager defaultManager] contentsOfDirectoryAtURL:_directoryURL
+										 includingPropertiesForKeys:keys
+															options:NSDirectoryEnumerationSkipsHiddenFiles
+															  error:nil] ?: @[];
+}
+
+@end
@@ -0,0 +1,49 @@
+//
+//  TMDBMovie+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMovie.h"
+
+@class TMDBRequestSubscription;
+
+// Private methods shared with the other model classes
+@interface TMDBMovie (Private)
+
+/**
+ * Loads movies like `+loadMoviesWithIDs:options:context:completionQueue:progress:completion:`,
+ * spreading them over `contexts`.
+ */
++ (nonnull NSProgress *)loadMoviesWithIDs:(nonnull NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options contexts:(nonnull NSArray<TMDB *> *)contexts completionQueue:(nonnull dispatch_queue_t)completionQueue progress:(nullable TMDBMovieBatchProgressBlock)progressBlock completion:(nullable TMDBMovieBatchCompletionBlock)completionBlock;
+
+/**
+ * Loads the movie like `-load:completionQueue:completion:`, and returns the
+ * subscription to the underlying request, or `nil` if the request couldn't be
+ * created. The completion block is called on `completionQueue` either way.
+ */
+- (nullable TMDBRequestSubscription *)subscribeToLoad:(TMDBMovieFetchOptions)options completionQueue:(nonnull dispatch_queue_t)completionQueue completion:(nullable TMDBMovieFetchCompletionBlock)completionBlock;
+
+/**
+ * Loads the movie like `-subscribeToLoad:completionQueue:completion:`. When
+ * reloading, every group in `options` is requested, including those the movie
+ * already holds.
+ */
+- (nullable TMDBRequestSubscription *)subscribeToLoad:(TMDBMovieFetchOptions)options reloading:(BOOL)reloading completionQueue:(nonnull dispatch_queue_t)completionQueue completion:(nullable TMDBMovieFetchCompletionBlock)completionBlock;
+
+/**
+ * Returns the movie's information in the shape of a TMDb response, which
+ * `-populate:` turns back into an equal movie. Lazily decoded collections are
+ * decoded first.
+ */
+- (nonnull NSDictionary *)responseDictionary;
+
+/** How popular the movie is on TMDb, which search results are ordered by. */
+- (double)popularity;
+
+/** The release date in the `yyyy-MM-dd` form TMDb uses, or `nil` if unknown. */
+- (nullable NSString *)releaseDateString;
+
+@end
@@ -8,22 +8,75 @@
 
 @import Foundation;
 
+@class TMDB;
 @class TMDBImage;
 @class TMDBLanguage;
 @class TMDBPerson;
+@class TMDBCredit;
+@class TMDBRequestToken;
 
+/**
+ * The groups of information a movie can be loaded with. Every load includes
+ * the basic information.
+ */
 typedef NS_OPTIONS(NSUInteger, TMDBMovieFetchOptions) {
-	TMDBMovieFetchOptionBasic    = 1 << 1,
-	TMDBMovieFetchOptionCasts    = 1 << 2,
-	TMDBMovieFetchOptionKeywords = 1 << 3,
-	TMDBMovieFetchOptionImages   = 1 << 4,
-	TMDBMovieFetchOptionAll      = TMDBMovieFetchOptionBasic    |
-								   TMDBMovieFetchOptionCasts    |
-								   TMDBMovieFetchOptionKeywords |
-								   TMDBMovieFetchOptionImages
+	TMDBMovieFetchOptionBasic        = 1 << 1,
+	TMDBMovieFetchOptionCasts        = 1 << 2,
+	TMDBMovieFetchOptionKeywords     = 1 << 3,
+	TMDBMovieFetchOptionImages       = 1 << 4,
+	TMDBMovieFetchOptionVideos       = 1 << 5,
+	TMDBMovieFetchOptionReleaseDates = 1 << 6,
+	TMDBMovieFetchOptionTranslations = 1 << 7,
+	TMDBMovieFetchOptionSimilar      = 1 << 8,
+	TMDBMovieFetchOptionExternalIDs  = 1 << 9,
+	TMDBMovieFetchOptionAll          = TMDBMovieFetchOptionBasic        |
+									   TMDBMovieFetchOptionCasts        |
+									   TMDBMovieFetchOptionKeywords     |
+									   TMDBMovieFetchOptionImages       |
+									   TMDBMovieFetchOptionVideos       |
+									   TMDBMovieFetchOptionReleaseDates |
+									   TMDBMovieFetchOptionTranslations |
+									   TMDBMovieFetchOptionSimilar      |
+									   TMDBMovieFetchOptionExternalIDs
+};
+
+/**
+ * Options for how `-populate:options:` turns a response into a movie.
+ */
+typedef NS_OPTIONS(NSUInteger, TMDBMoviePopulateOptions) {
+	/**
+	 * Decodes `posters`, `backdrops`, `cast`, `languagesSpoken`, `keywords`
+	 * and `similarMovies` the first time each is read, instead of while
+	 * populating. Cheaper when
+	 * most movies are only used for their title, year and ID.
+	 */
+	TMDBMoviePopulateOptionLazy              = 1 << 0,
+	/** Doesn't keep the response around in `rawResults`. */
+	TMDBMoviePopulateOptionDiscardRawResults = 1 << 1
 };
 
+/**
+ * The approximate number of bytes retained by a movie, by kind of data.
+ */
+typedef struct TMDBMovieFootprint {
+	/** Posters and backdrops. */
+	NSUInteger images;
+	/** Credits and their persons, including `cast`. */
+	NSUInteger credits;
+	/**
+	 * `rawResults`, and the parts of the response kept for lazy decoding or
+	 * as they come, such as `videos`.
+	 */
+	NSUInteger rawResults;
+	/** Titles, overview, keywords, URLs and other strings, and languages. */
+	NSUInteger strings;
+	/** All of the above, plus the movie object itself. */
+	NSUInteger total;
+} TMDBMovieFootprint;
+
 typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
+typedef void (^TMDBMovieBatchProgressBlock)(TMDBMovie * _Nonnull movie, NSUInteger index, NSError * _Nullable error);
+typedef void (^TMDBMovieBatchCompletionBlock)(NSArray<TMDBMovie *> * _Nonnull movies, NSDictionary<NSNumber *, NSError *> * _Nonnull errors);
 
 /**
  * A `TMDBMovie` object represents information about a movie from the
@@ -40,8 +93,8 @@ typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
 /** @name Creating an Instance */
 
 /**
- * Creates an empty movie object ready to be loaded, based on the provided TMDb
- * ID.
+ * Creates an empty movie object ready to be loaded through the shared context,
+ * based on the provided TMDb ID.
  *
  * You must call either `-load` or `-populate:` to populate the object with
  * data.
@@ -49,17 +102,117 @@ typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
  * @param tmdbID The TMDb ID of the movie to be looked up.
  * @return An empty movie object ready to be loaded.
  */
-- (nonnull instancetype)initWithID:(NSUInteger)tmdbID NS_DESIGNATED_INITIALIZER;
+- (nonnull instancetype)initWithID:(NSUInteger)tmdbID;
+
+/**
+ * Creates an empty movie object ready to be loaded through `context`, based on
+ * the provided TMDb ID.
+ *
+ * @param tmdbID The TMDb ID of the movie to be looked up.
+ * @param context The context through which the movie is loaded. Pass `nil` to
+ * use the shared instance.
+ * @return An empty movie object ready to be loaded.
+ */
+- (nonnull instancetype)initWithID:(NSUInteger)tmdbID context:(nullable TMDB *)context NS_DESIGNATED_INITIALIZER;
+
+/**
+ * The context through which the movie is loaded. Its credits, persons and
+ * images use the same context.
+ */
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
 
 /** @name Loading Data */
 
-- (void)load:(TMDBMovieFetchOptions)options completion:(nullable TMDBMovieFetchCompletionBlock)completionBlock;
+/**
+ * Loads the movie information specified by `options`. The completion block
+ * is called on the context's `completionQueue`.
+ *
+ * Only the groups of information the movie doesn't hold yet are requested,
+ * and merged into what it already holds, so loading a movie with more options
+ * than before transfers just the new information. If the movie already holds
+ * every group in `options`, no request is made.
+ *
+ * @return A token for changing the priority of the request or cancelling it.
+ */
+- (nonnull TMDBRequestToken *)load:(TMDBMovieFetchOptions)options completion:(nullable TMDBMovieFetchCompletionBlock)completionBlock;
+
+/**
+ * Loads the movie information specified by `options`.
+ *
+ * The response is decoded and the movie populated on a background queue, and
+ * only the completion block is called on `completionQueue`. Don't read the
+ * movie's properties from other threads while it is loading.
+ *
+ * A change to `year` is announced to key-value observers on the context's
+ * `completionQueue` once the movie has been populated, so observers get the
+ * new value but not the old one.
+ *
+ * @param completionQueue The queue on which to call the completion block. Pass
+ * `nil` to use the context's `completionQueue`.
+ * @return A token for changing the priority of the request or cancelling it.
+ */
+- (nonnull TMDBRequestToken *)load:(TMDBMovieFetchOptions)options completionQueue:(nullable dispatch_queue_t)completionQueue completion:(nullable TMDBMovieFetchCompletionBlock)completionBlock;
+
+/**
+ * Loads the movies with the given TMDb IDs.
+ *
+ * The requests go through the same rate limiter, cache and coalescing as
+ * `-load:completion:`, with no more than a handful in flight at a time, so a
+ * batch of thousands of IDs doesn't flood the request queue.
+ *
+ * @param tmdbIDs The TMDb IDs of the movies to load.
+ * @param options The information to load for every movie.
+ * @param completionQueue The queue on which to call both blocks. Pass `nil` to
+ * use the context's `completionQueue`.
+ * @param progressBlock Called once for every movie as it finishes loading,
+ * with its index in `tmdbIDs` and an error if it failed. Movies finish in no
+ * particular order.
+ * @param completionBlock Called once all movies have finished loading or the
+ * batch has been cancelled. `movies` has a movie for every ID, in the same
+ * order as `tmdbIDs`, and `errors` maps the indexes of the movies that failed
+ * to their errors. Movies that were never loaded because the batch was
+ * cancelled fail with `NSURLErrorCancelled`.
+ * @return A progress object counting finished movies. Cancel it to cancel the
+ * whole batch.
+ */
++ (nonnull NSProgress *)loadMoviesWithIDs:(nonnull NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options completionQueue:(nullable dispatch_queue_t)completionQueue progress:(nullable TMDBMovieBatchProgressBlock)progressBlock completion:(nullable TMDBMovieBatchCompletionBlock)completionBlock;
+
+/**
+ * Loads the movies with the given TMDb IDs like
+ * `+loadMoviesWithIDs:options:completionQueue:progress:completion:`, through
+ * `context` rather than the shared instance.
+ *
+ * @param context The context to load the movies through. Pass `nil` to use the
+ * shared instance.
+ * @param completionQueue The queue on which to call both blocks. Pass `nil` to
+ * use the `completionQueue` of `context`.
+ */
++ (nonnull NSProgress *)loadMoviesWithIDs:(nonnull NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options context:(nullable TMDB *)context completionQueue:(nullable dispatch_queue_t)completionQueue progress:(nullable TMDBMovieBatchProgressBlock)progressBlock completion:(nullable TMDBMovieBatchCompletionBlock)completionBlock;
 
+/**
+ * Populates the movie with the given TMDb response, using the
+ * `moviePopulateOptions` of the movie's context.
+ */
 - (void)populate:(nonnull NSDictionary *)d;
 
+/**
+ * Populates the movie with the given TMDb response, replacing everything it
+ * held before, and sets `options` to the groups of information found in the
+ * response.
+ *
+ * In lazy mode, the sub-collections keep hold of their part of the response
+ * until they are read, even if `rawResults` is discarded.
+ */
+- (void)populate:(nonnull NSDictionary *)d options:(TMDBMoviePopulateOptions)options;
+
 #pragma mark - Basic Information
 /** @name Basic Information */
 
+/**
+ * The groups of information the movie holds. Movies from search results
+ * hold none, not even `TMDBMovieFetchOptionBasic`, as search results leave
+ * out most of the basic information.
+ */
 @property (nonatomic, readonly) TMDBMovieFetchOptions options;
 
 /** The TMDb ID of the movie. */
@@ -85,13 +238,19 @@ typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
 
 /** @name Times and Dates */
 
-/** The release date of the movie. */
+/**
+ * The release date of the movie, at midnight in the local time zone.
+ *
+ * The date is created the first time this property is read.
+ */
 @property (nonatomic, copy, nullable, readonly) NSDate *released;
 
 /**
- * The year in which the movie was released.
+ * The year in which the movie was released, or `0` if the release date is
+ * unknown.
  *
- * This is simply a convenience property that uses the `released` date property.
+ * The year is stored when the movie is populated, so reading it doesn't
+ * require creating the `released` date.
  */
 @property (nonatomic, readonly) NSUInteger year;
 
@@ -110,7 +269,8 @@ typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
  * The raw contents from the API itself. This is most likely an `NSDictionary`.
  *
  * You can use this property to extract values that iTMDb does not already wrap
- * in the TMDBMovie object.
+ * in the TMDBMovie object. It is `nil` if the movie was populated with
+ * `TMDBMoviePopulateOptionDiscardRawResults`.
  */
 @property (nonatomic, strong, nullable, readonly) id rawResults;
 
@@ -141,6 +301,27 @@ typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
  */
 @property (nonatomic, copy, nullable, readonly) NSString *imdbID;
 
+/**
+ * The movie's IDs on other sites, keyed as in the TMDb response, such as
+ * `imdb_id` and `facebook_id`. Set by loading with
+ * `TMDBMovieFetchOptionExternalIDs`.
+ */
+@property (nonatomic, copy, nullable, readonly) NSDictionary<NSString *, NSString *> *externalIDs;
+
+/**
+ * The trailers, teasers and clips of the movie, as the dictionaries of the
+ * TMDb response, with keys such as `key`, `site` and `type`. Set by loading
+ * with `TMDBMovieFetchOptionVideos`.
+ */
+@property (nonatomic, copy, nullable, readonly) NSArray<NSDictionary *> *videos;
+
+/**
+ * Movies similar to this one. Like search results, they are only populated
+ * with their basic information, and have to be loaded before use. Set by
+ * loading with `TMDBMovieFetchOptionSimilar`.
+ */
+@property (nonatomic, strong, nullable, readonly) NSArray<TMDBMovie *> *similarMovies;
+
 /** @name Localization */
 
 /**
@@ -155,19 +336,63 @@ typedef void (^TMDBMovieFetchCompletionBlock)(NSError * _Nullable error);
  */
 @property (nonatomic, strong, nullable, readonly) NSArray<NSString *> *countries;
 
+/**
+ * The release dates and certifications of the movie by country, as the
+ * dictionaries of the TMDb response, each with an `iso_3166_1` country code
+ * and its `release_dates`. Set by loading with
+ * `TMDBMovieFetchOptionReleaseDates`.
+ */
+@property (nonatomic, copy, nullable, readonly) NSArray<NSDictionary *> *releaseDates;
+
+/**
+ * The languages the movie's information has been translated to, as the
+ * dictionaries of the TMDb response. Set by loading with
+ * `TMDBMovieFetchOptionTranslations`.
+ */
+@property (nonatomic, copy, nullable, readonly) NSArray<NSDictionary *> *translations;
+
 /** @name Getting the Cast and Crew */
 /**
- * An array of `TMDBPerson` objects representing the cast and crew of the movie.
+ * An array of `TMDBCredit` objects representing the cast and crew of the
+ * movie. The credited persons are shared with every other movie they appear
+ * in.
+ */
+@property (nonatomic, strong, nullable, readonly) NSArray<TMDBCredit *> *credits;
+
+/**
+ * An array of `TMDBPerson` objects representing the cast and crew of the movie,
+ * the `person` of every credit in `credits`, in the same order.
+ *
+ * The persons are shared with other movies, so they don't carry this movie's
+ * character or job; read those from `credits`.
+ *
+ * @warning Deprecated. Use `credits`, which has each person's character and
+ * job in this movie.
  */
-@property (nonatomic, strong, nullable, readonly) NSArray<TMDBPerson *> *cast;
+@property (nonatomic, strong, nullable, readonly) NSArray<TMDBPerson *> *cast __attribute__((deprecated("Use credits, which has each person's character and job in this movie.")));
+
+/** @name Memory Footprint */
+
+/**
+ * Measures the memory retained by the movie and the objects it holds.
+ *
+ * Persons and languages shared with other movies are counted in full, so the
+ * footprints of many movies add up to more than they retain together. Lazily
+ * decoded collections are measured as the raw data they are still kept as.
+ */
+- (TMDBMovieFootprint)footprint;
 
 // TODO: Move out of TMDBMovie
 + (NSUInteger)yearFromDate:(nonnull NSDate *)date;
 + (nullable NSDate *)dateFromString:(nonnull NSString *)dateString;
 
-@end
+/**
+ * Returns the year of a `yyyy-MM-dd` date string, or `0` if the string isn't
+ * a valid date, without creating an `NSDate`.
+ */
++ (NSUInteger)yearFromString:(nonnull NSString *)dateString;
 
-@class TMDB;
+@end
 
 @interface TMDBMovie (UnavailableMethods)
 
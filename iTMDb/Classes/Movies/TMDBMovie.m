@@ -8,15 +8,144 @@
 
 #import "TMDB.h"
 #import "TMDBMovie.h"
+#import "TMDBMovie+Private.h"
 #import "TMDBMovieSearch.h"
+#import "TMDBMovieSearch+Private.h"
+#import "TMDBMovieTitleIndex.h"
 #import "TMDBImage.h"
+#import "TMDBImage+Private.h"
 #import "TMDBPerson.h"
+#import "TMDBPerson+Private.h"
+#import "TMDBCredit.h"
+#import "TMDBCredit+Private.h"
+#import "TMDB+Private.h"
+#import "TMDBIdentityMap.h"
+#import "TMDBFootprint.h"
 #import "TMDBRequest.h"
+#import "TMDBBatch.h"
+#import "TMDBRequestToken+Private.h"
+#import "TMDBRequestMetrics+Private.h"
 #import "TMDBLanguage.h"
 
+#include <time.h>
+
+// Parses a `yyyy-MM-dd` date without going through NSDateFormatter, which is
+// slow and can't be shared between threads. Returns NO for anything else,
+// including the empty strings TMDb uses for unknown dates.
+static BOOL TMDBMovieParseDate(NSString *string, NSInteger *outYear, NSInteger *outMonth, NSInteger *outDay) {
+	if (string.length != 10) {
+		return NO;
+	}
+
+	unichar c[10];
+	[string getCharacters:c range:NSMakeRange(0, 10)];
+
+	if (c[4] != '-' || c[7] != '-') {
+		return NO;
+	}
+
+	NSInteger values[3] = {0, 0, 0};
+	static const NSUInteger starts[3] = {0, 5, 8}, lengths[3] = {4, 2, 2};
+
+	for (NSUInteger part = 0; part < 3; part++) {
+		for (NSUInteger i = starts[part]; i < starts[part] + lengths[part]; i++) {
+			if (c[i] < '0' || c[i] > '9') {
+				return NO;
+			}
+			values[part] = values[part] * 10 + (c[i] - '0');
+		}
+	}
+
+	if (values[0] == 0 || values[1] < 1 || values[1] > 12 || values[2] < 1 || values[2] > 31) {
+		return NO;
+	}
+
+	*outYear = values[0];
+	*outMonth = values[1];
+	*outDay = values[2];
+
+	return YES;
+}
+
+// Midnight of the given day in the local time zone, which is what the
+// `yyyy-MM-dd` date formatter used to produce.
+static NSDate *TMDBMovieDateFromComponents(NSInteger year, NSInteger month, NSInteger day) {
+	struct tm components = {0};
+	components.tm_year = (int)year - 1900;
+	components.tm_mon = (int)month - 1;
+	components.tm_mday = (int)day;
+	components.tm_isdst = -1;
+
+	time_t time = mktime(&components);
+	if (time == -1) {
+		return nil;
+	}
+
+	return [NSDate dateWithTimeIntervalSince1970:time];
+}
+
+// The groups of information in a movie response. Only the movie's own
+// endpoint returns `runtime`, which search results leave out, even when TMDb
+// doesn't know it.
+static TMDBMovieFetchOptions TMDBMovieFetchOptionsOfResponse(NSDictionary *d) {
+	TMDBMovieFetchOptions options = d[@"runtime"] != nil ? TMDBMovieFetchOptionBasic : 0;
+
+	for (TMDBMovieFetchOptions option = TMDBMovieFetchOptionCasts; option <= TMDBMovieFetchOptionExternalIDs; option <<= 1) {
+		NSString *name = [TMDBMovieSearch appendToResponseNameForFetchOption:option];
+		if (name != nil && TMDB_NSDictionaryOrNil(d[name]) != nil) {
+			options |= option;
+		}
+	}
+
+	return options;
+}
+
+// The dictionaries in an array of the response, or nil if it isn't an array
+static NSArray<NSDictionary *> *TMDBMovieDictionariesOrNil(id object) {
+	NSArray *array = TMDB_NSArrayOrNil(object);
+	if (array == nil) {
+		return nil;
+	}
+
+	NSMutableArray<NSDictionary *> *dictionaries = [NSMutableArray arrayWithCapacity:array.count];
+	for (id element in array) {
+		if (TMDB_NSDictionaryOrNil(element) != nil) {
+			[dictionaries addObject:element];
+		}
+	}
+
+	return [dictionaries copy];
+}
+
+// The sub-collections that may be decoded lazily
+typedef NS_OPTIONS(NSUInteger, TMDBMovieCollection) {
+	TMDBMovieCollectionLanguages = 1 << 0,
+	TMDBMovieCollectionImages    = 1 << 1,
+	TMDBMovieCollectionCast      = 1 << 2,
+	TMDBMovieCollectionKeywords  = 1 << 3,
+	TMDBMovieCollectionSimilar   = 1 << 4,
+	TMDBMovieCollectionAll       = TMDBMovieCollectionLanguages |
+								   TMDBMovieCollectionImages    |
+								   TMDBMovieCollectionCast      |
+								   TMDBMovieCollectionKeywords  |
+								   TMDBMovieCollectionSimilar
+};
+
 @implementation TMDBMovie {
 @private
-	NSInteger        _year;
+	// The parts of the response still to be decoded, guarded by self
+	TMDBMovieCollection	_pendingCollections;
+	NSArray			*_rawSpokenLanguages;
+	NSDictionary	*_rawImages;
+	NSDictionary	*_rawCasts;
+	NSArray			*_rawKeywords;
+	NSArray			*_rawSimilar;
+
+	// The release date as parsed by populate:. The NSDate is only created
+	// when `released` is read.
+	NSInteger		_year;
+	NSInteger		_releaseMonth;
+	NSInteger		_releaseDay;
 	float			_rating;
 	NSInteger		_revenue;
 	NSURL			*_trailer;
@@ -25,7 +154,8 @@
 	NSDate			*_modified;
 }
 
-@synthesize adult=_isAdult;
+@synthesize options=_options, adult=_isAdult, released=_released;
+@synthesize posters=_posters, backdrops=_backdrops, credits=_credits, cast=_cast, languagesSpoken=_languagesSpoken, keywords=_keywords, similarMovies=_similarMovies;
 
 #pragma mark - Initializers
 
@@ -34,42 +164,150 @@
 }
 
 - (instancetype)initWithID:(NSUInteger)tmdbID {
+	return (self = [self initWithID:tmdbID context:nil]);
+}
+
+- (instancetype)initWithID:(NSUInteger)tmdbID context:(TMDB *)context {
 	if (!(self = [super init])) {
 		return nil;
 	}
 
 	_tmdbID = tmdbID;
+	_context = context ?: [TMDB sharedInstance];
 
 	return self;
 }
 
 #pragma mark - Data Fetching
 
-- (void)load:(TMDBMovieFetchOptions)options completion:(TMDBMovieFetchCompletionBlock)completionBlock {
-	NSURL *url = [TMDBMovieSearch fetchURLWithMovieID:_tmdbID options:options];
+- (TMDBRequestToken *)load:(TMDBMovieFetchOptions)options completion:(TMDBMovieFetchCompletionBlock)completionBlock {
+	return [self load:options completionQueue:nil completion:completionBlock];
+}
+
+- (TMDBRequestToken *)load:(TMDBMovieFetchOptions)options completionQueue:(dispatch_queue_t)completionQueue completion:(TMDBMovieFetchCompletionBlock)completionBlock {
+	TMDBRequestToken *token = [[TMDBRequestToken alloc] init];
+	__weak TMDBRequestToken *weakToken = token;
+
+	TMDBRequestSubscription *subscription = [self subscribeToLoad:options completionQueue:completionQueue ?: _context.completionQueue completion:^(NSError *error) {
+		// The request may have finished just before the token was cancelled
+		if (completionBlock != nil && !weakToken.isCancelled) {
+			completionBlock(error);
+		}
+	}];
+	[token setSubscription:subscription];
+
+	return token;
+}
+
++ (NSProgress *)loadMoviesWithIDs:(NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options completionQueue:(dispatch_queue_t)completionQueue progress:(TMDBMovieBatchProgressBlock)progressBlock completion:(TMDBMovieBatchCompletionBlock)completionBlock {
+	return [self loadMoviesWithIDs:tmdbIDs options:options context:nil completionQueue:completionQueue progress:progressBlock completion:completionBlock];
+}
+
++ (NSProgress *)loadMoviesWithIDs:(NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options context:(TMDB *)context completionQueue:(dispatch_queue_t)completionQueue progress:(TMDBMovieBatchProgressBlock)progressBlock completion:(TMDBMovieBatchCompletionBlock)completionBlock {
+	context = context ?: [TMDB sharedInstance];
+
+	return [self loadMoviesWithIDs:tmdbIDs options:options contexts:@[context] completionQueue:completionQueue ?: context.completionQueue progress:progressBlock completion:completionBlock];
+}
+
++ (NSProgress *)loadMoviesWithIDs:(NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options contexts:(NSArray<TMDB *> *)contexts completionQueue:(dispatch_queue_t)completionQueue progress:(TMDBMovieBatchProgressBlock)progressBlock completion:(TMDBMovieBatchCompletionBlock)completionBlock {
+	NSParameterAssert(tmdbIDs != nil);
+
+	tmdbIDs = [tmdbIDs copy];
+	TMDBBatch *batch = [[TMDBBatch alloc] initWithCount:tmdbIDs.count contexts:contexts completionQueue:completionQueue itemBlock:^id(NSUInteger index, TMDB *context) {
+		return [[TMDBMovie alloc] initWithID:TMDB_NSNumberOrNil(tmdbIDs[index]).unsignedIntegerValue context:context];
+	} subscribeBlock:^TMDBRequestSubscription *(TMDBMovie *movie, dispatch_queue_t queue, TMDBBatchItemCompletionBlock itemCompletionBlock) {
+		return [movie subscribeToLoad:options completionQueue:queue completion:itemCompletionBlock];
+	}];
+	batch.progressBlock = progressBlock;
+	batch.completionBlock = completionBlock;
+	[batch start];
+
+	return batch.progress;
+}
+
+- (TMDBRequestSubscription *)subscribeToLoad:(TMDBMovieFetchOptions)options completionQueue:(dispatch_queue_t)queue completion:(TMDBMovieFetchCompletionBlock)completionBlock {
+	return [self subscribeToLoad:options reloading:NO completionQueue:queue completion:completionBlock];
+}
+
+- (TMDBRequestSubscription *)subscribeToLoad:(TMDBMovieFetchOptions)options reloading:(BOOL)reloading completionQueue:(dispatch_queue_t)queue completion:(TMDBMovieFetchCompletionBlock)completionBlock {
+	// Every request includes the basic information
+	options |= TMDBMovieFetchOptionBasic;
+
+	TMDBMovieFetchOptions missingOptions = options;
+	if (!reloading) {
+		@synchronized(self) {
+			missingOptions &= ~_options;
+		}
+	}
+
+	if (missingOptions == 0) {
+		if (completionBlock != nil) {
+			dispatch_async(queue, ^{
+				completionBlock(nil);
+			});
+		}
+		return nil;
+	}
+
+	// A single missing group is requested from its own endpoint, which leaves
+	// out the basic information the movie already holds. Several are appended
+	// to one request for the movie instead, as a request costs more than the
+	// basic information does.
+	NSString *appendedKey = [TMDBMovieSearch appendToResponseNameForFetchOption:missingOptions];
+	NSURL *url;
+	if (appendedKey != nil) {
+		url = [TMDBMovieSearch fetchURLWithMovieID:_tmdbID option:missingOptions context:_context];
+	}
+	else {
+		url = [TMDBMovieSearch fetchURLWithMovieID:_tmdbID options:missingOptions context:_context];
+	}
 
 	if (url == nil) {
 		if (completionBlock != nil) {
 			NSError *error = [NSError errorWithDomain:TMDBErrorDomain
 												 code:TMDBErrorCodeInvalidURL
 											 userInfo:nil];
-			completionBlock(error);
+			dispatch_async(queue, ^{
+				completionBlock(error);
+			});
 		}
-		return;
+		return nil;
 	}
 
-	[TMDBRequest requestWithURL:url completionBlock:^(id parsedData, NSError *error) {
-		if (error != nil) {
-			if (completionBlock != nil) {
-				completionBlock(error);
-			}
-			return;
+	return [TMDBRequest requestWithURL:url context:_context completionBlock:^(id parsedData, NSError *error) {
+		// Called on the request work queue, so populating doesn't block the
+		// main thread
+		TMDBRequestMetrics *metrics = TMDBRequestMetricsCurrent();
+
+		if (error == nil && TMDB_NSDictionaryOrNil(parsedData) == nil) {
+			error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeReceivedInvalidData userInfo:nil];
 		}
 
-		[self populate:parsedData];
+		if (error == nil) {
+			// Put the group back under its key, as if it had been appended
+			NSDictionary *d = appendedKey != nil ? @{@"id": @(_tmdbID), appendedKey: parsedData} : parsedData;
+
+			CFAbsoluteTime populateStart = CFAbsoluteTimeGetCurrent();
+			BOOL yearChanged;
+			@synchronized(self) {
+				yearChanged = [self populate:d options:_context.moviePopulateOptions merging:YES notifyingYear:NO];
+			}
+			[metrics addDuration:CFAbsoluteTimeGetCurrent() - populateStart toPhase:TMDBRequestPhasePopulate];
+
+			// Observers are told on the context's completion queue, like they
+			// were when movies were populated on the main thread
+			if (yearChanged) {
+				dispatch_async(_context.completionQueue, ^{
+					[self willChangeValueForKey:@"year"];
+					[self didChangeValueForKey:@"year"];
+				});
+			}
+		}
 
 		if (completionBlock != nil) {
-			completionBlock(error);
+			TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+				completionBlock(error);
+			});
 		}
 	}];
 }
@@ -81,7 +319,7 @@
 		return [NSString stringWithFormat:@"<%@ %p>", NSStringFromClass(self.class), self];
 	}
 
-	if (self.released == nil) {
+	if (self.year == 0) {
 		return [NSString stringWithFormat:@"<%@ %p: \"%@\">", NSStringFromClass(self.class), self, self.title];
 	}
 
@@ -90,120 +328,329 @@
 
 #pragma mark - Getters and Setters
 
-// Private
-- (void)calculateYear {
-	_year = [TMDBMovie yearFromDate:self.released];
+- (TMDBMovieFetchOptions)options {
+	@synchronized(self) {
+		return _options;
+	}
 }
 
 - (NSUInteger)year {
-	if (_year > 0) {
-		return _year;
+	return _year;
+}
+
+- (double)popularity {
+	return _popularity;
+}
+
+- (NSString *)releaseDateString {
+	if (_year == 0) {
+		return nil;
 	}
+	return [NSString stringWithFormat:@"%04zd-%02zd-%02zd", _year, _releaseMonth, _releaseDay];
+}
 
-	[self calculateYear];
+- (NSDate *)released {
+	@synchronized(self) {
+		if (_released == nil && _year > 0) {
+			_released = TMDBMovieDateFromComponents(_year, _releaseMonth, _releaseDay);
+		}
+		return _released;
+	}
+}
 
-	return _year;
+- (NSArray *)posters {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionImages];
+		return _posters;
+	}
 }
 
-- (void)setReleased:(NSDate *)released {
-	_released = released;
+- (NSArray *)backdrops {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionImages];
+		return _backdrops;
+	}
+}
 
-	[self willChangeValueForKey:@"year"];
-	[self calculateYear];
-	[self didChangeValueForKey:@"year"];
+- (NSArray *)credits {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionCast];
+		return _credits;
+	}
+}
+
+- (NSArray *)cast {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionCast];
+
+		// The credits' own persons, which are shared with other movies
+		if (_cast == nil && _credits.count > 0) {
+			NSMutableArray *cast = [NSMutableArray arrayWithCapacity:_credits.count];
+			for (TMDBCredit *credit in _credits) {
+				TMDBPerson *person = credit.person;
+				if (person != nil) {
+					[cast addObject:person];
+				}
+			}
+			_cast = [cast copy];
+		}
+
+		return _cast;
+	}
+}
+
+- (NSArray *)languagesSpoken {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionLanguages];
+		return _languagesSpoken;
+	}
+}
+
+- (NSArray *)keywords {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionKeywords];
+		return _keywords;
+	}
+}
+
+- (NSArray *)similarMovies {
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionSimilar];
+		return _similarMovies;
+	}
 }
 
 #pragma mark - Data Population
 
 - (void)populate:(NSDictionary *)d {
-	_rawResults = d;
+	[self populate:d options:_context.moviePopulateOptions];
+}
+
+- (void)populate:(NSDictionary *)d options:(TMDBMoviePopulateOptions)options {
+	[self populate:d options:options merging:NO notifyingYear:YES];
+}
 
-	// SIMPLE DATA
-	_tmdbID   = TMDB_NSNumberOrNil((NSNumber *)d[@"id"]).integerValue;
-	_title    = TMDB_NSStringOrNil(d[@"title"]);
-	_overview = TMDB_NSStringOrNil(d[@"overview"]);
-	_tagline  = TMDB_NSStringOrNil(d[@"tagline"]);
-	_imdbID   = TMDB_NSStringOrNil(d[@"imdb_id"]);
+// Private. When merging, only the groups of information found in the response
+// replace what the movie holds, and it keeps the rest. Returns YES if the year
+// changed; unless notifyingYear is set, it's up to the caller to tell the
+// observers of `year`.
+- (BOOL)populate:(NSDictionary *)d options:(TMDBMoviePopulateOptions)options merging:(BOOL)merging notifyingYear:(BOOL)notifyingYear {
+	TMDBMovieFetchOptions groups = TMDBMovieFetchOptionsOfResponse(d);
+	TMDBMovieFetchOptions replacedGroups = merging ? groups : TMDBMovieFetchOptionAll;
 
-	// COMPLEX DATA
+	if (options & TMDBMoviePopulateOptionDiscardRawResults) {
+		_rawResults = nil;
+	}
+	else if (merging && TMDB_NSDictionaryOrNil(_rawResults) != nil) {
+		NSMutableDictionary *rawResults = [_rawResults mutableCopy];
+		[rawResults addEntriesFromDictionary:d];
+		_rawResults = [rawResults copy];
+	}
+	else {
+		_rawResults = d;
+	}
 
-	// Original name
-	_originalTitle = TMDB_NSStringOrNil(d[@"original_title"]);
+	// Sub-collections, which are the bulk of the work, are decoded from just
+	// their own part of the response.
+	TMDBMovieCollection collections = 0;
+	BOOL yearChanged = NO;
 
-	// Alternative name
-//	if (d[@"alternative_name"])
-//		_alternativeName = [d[@"alternative_name"] copy];
+	if (replacedGroups & TMDBMovieFetchOptionBasic) {
+		// SIMPLE DATA
+		_tmdbID   = TMDB_NSNumberOrNil((NSNumber *)d[@"id"]).integerValue;
+		_title    = TMDB_NSStringOrNil(d[@"title"]);
+		_overview = TMDB_NSStringOrNil(d[@"overview"]);
+		_tagline  = TMDB_NSStringOrNil(d[@"tagline"]);
+		_imdbID   = TMDB_NSStringOrNil(d[@"imdb_id"]);
 
-	// Keywords
-	_keywords = [TMDB_NSArrayOrNil(d[@"keywords"]) copy];
+		// COMPLEX DATA
 
-	// URL
-	_url = TMDB_NSURLOrNilFromStringOrNil(d[@"url"]);
+		// Original name
+		_originalTitle = TMDB_NSStringOrNil(d[@"original_title"]);
 
-	// Popularity
-	_popularity = TMDB_NSNumberOrNil(d[@"popularity"]).doubleValue;
+		// Alternative name
+//		if (d[@"alternative_name"])
+//			_alternativeName = [d[@"alternative_name"] copy];
 
-	// Votes
-	_votes = TMDB_NSNumberOrNil(d[@"votes"]).integerValue;
+		// URL
+		_url = TMDB_NSURLOrNilFromStringOrNil(d[@"url"]);
 
-	// Rating
-	_rating = TMDB_NSNumberOrNil(d[@"rating"]).floatValue;
+		// Popularity
+		_popularity = TMDB_NSNumberOrNil(d[@"popularity"]).doubleValue;
 
-	// Adult
-	_isAdult = TMDB_NSNumberOrNil(d[@"adult"]).boolValue;
+		// Votes
+		_votes = TMDB_NSNumberOrNil(d[@"votes"]).integerValue;
 
-	// Spoken Languages
-	_languagesSpoken = [TMDBLanguage languagesFromArrayOfDictionaries:TMDB_NSArrayOrNil(d[@"spoken_languages"])];
+		// Rating
+		_rating = TMDB_NSNumberOrNil(d[@"rating"]).floatValue;
+
+		// Adult
+		_isAdult = TMDB_NSNumberOrNil(d[@"adult"]).boolValue;
+
+		// Release date
+		NSInteger year = 0, month = 0, day = 0;
+		TMDBMovieParseDate(TMDB_NSStringOrNil(d[@"release_date"]), &year, &month, &day);
+		if (year != _year || month != _releaseMonth || day != _releaseDay) {
+			yearChanged = (year != _year);
+			if (yearChanged && notifyingYear) {
+				[self willChangeValueForKey:@"year"];
+			}
+			_year = year;
+			_releaseMonth = month;
+			_releaseDay = day;
+			_released = nil;
+			if (yearChanged && notifyingYear) {
+				[self didChangeValueForKey:@"year"];
+			}
+		}
+
+		// Runtime
+		_runtime = TMDB_NSNumberOrNil(d[@"runtime"]).unsignedIntegerValue;
+
+		// Homepage
+		_homepage = TMDB_NSURLOrNilFromStringOrNil(d[@"homepage"]);
+
+		_rawSpokenLanguages = TMDB_NSArrayOrNil(d[@"spoken_languages"]);
+		collections |= TMDBMovieCollectionLanguages;
+	}
 
-	// Release date
-	NSString *released = TMDB_NSStringOrNil(d[@"release_date"]);
-	if (released != nil) {
-		_released = [TMDBMovie dateFromString:released];
+	if (replacedGroups & TMDBMovieFetchOptionImages) {
+		_rawImages = TMDB_NSDictionaryOrNil(d[@"images"]);
+		collections |= TMDBMovieCollectionImages;
 	}
 
-	// Runtime
-	_runtime = TMDB_NSNumberOrNil(d[@"runtime"]).unsignedIntegerValue;
+	if (replacedGroups & TMDBMovieFetchOptionCasts) {
+		_rawCasts = TMDB_NSDictionaryOrNil(d[@"casts"]);
+		collections |= TMDBMovieCollectionCast;
+	}
 
-	// Homepage
-	_homepage = TMDB_NSURLOrNilFromStringOrNil(d[@"homepage"]);
+	if (replacedGroups & TMDBMovieFetchOptionKeywords) {
+		_rawKeywords = TMDB_NSArrayOrNil(TMDB_NSDictionaryOrNil(d[@"keywords"])[@"keywords"]);
+		collections |= TMDBMovieCollectionKeywords;
+	}
 
-	// Images
-	NSDictionary *images = TMDB_NSDictionaryOrNil(d[@"images"]);
+	if (replacedGroups & TMDBMovieFetchOptionSimilar) {
+		_rawSimilar = TMDB_NSArrayOrNil(TMDB_NSDictionaryOrNil(d[@"similar"])[@"results"]);
+		collections |= TMDBMovieCollectionSimilar;
+	}
 
-	// Posters
-	if (images != nil && images[@"posters"] != nil) {
-		_posters = [TMDBImage imageArrayWithRawImageDictionaries:images[@"posters"] ofType:TMDBImageTypePoster];
+	// The other groups are kept as they come
+	if (replacedGroups & TMDBMovieFetchOptionVideos) {
+		_videos = TMDBMovieDictionariesOrNil(TMDB_NSDictionaryOrNil(d[@"videos"])[@"results"]);
 	}
-	else {
-		_posters = nil;
+
+	if (replacedGroups & TMDBMovieFetchOptionReleaseDates) {
+		_releaseDates = TMDBMovieDictionariesOrNil(TMDB_NSDictionaryOrNil(d[@"release_dates"])[@"results"]);
 	}
 
-	// Backdrops
-	if (images != nil && images[@"backdrops"] != nil) {
-		_backdrops = [TMDBImage imageArrayWithRawImageDictionaries:images[@"backdrops"] ofType:TMDBImageTypeBackdrop];
+	if (replacedGroups & TMDBMovieFetchOptionTranslations) {
+		_translations = TMDBMovieDictionariesOrNil(TMDB_NSDictionaryOrNil(d[@"translations"])[@"translations"]);
 	}
-	else {
-		_backdrops = nil;
+
+	if (replacedGroups & TMDBMovieFetchOptionExternalIDs) {
+		_externalIDs = [TMDBPerson externalIDsFromDictionary:TMDB_NSDictionaryOrNil(d[@"external_ids"])];
+	}
+
+	_pendingCollections |= collections;
+	_options = merging ? _options | groups : groups;
+
+	if ((options & TMDBMoviePopulateOptionLazy) == 0) {
+		[self decodeCollections:TMDBMovieCollectionAll];
+	}
+
+	if (replacedGroups & TMDBMovieFetchOptionBasic) {
+		[_context.titleIndex addMovie:self];
+	}
+
+	return yearChanged;
+}
+
+// Private. Must be called while synchronized on self, or while populating.
+- (void)decodeCollections:(TMDBMovieCollection)collections {
+	collections &= _pendingCollections;
+	if (collections == 0) {
+		return;
+	}
+	_pendingCollections &= ~collections;
+
+	// Spoken Languages
+	if (collections & TMDBMovieCollectionLanguages) {
+		_languagesSpoken = [TMDBLanguage languagesFromArrayOfDictionaries:_rawSpokenLanguages context:_context];
+		_rawSpokenLanguages = nil;
+	}
+
+	if (collections & TMDBMovieCollectionImages) {
+		NSDictionary *images = _rawImages;
+		_rawImages = nil;
+
+		// Posters
+		if (images != nil && images[@"posters"] != nil) {
+			_posters = [TMDBImage imageArrayWithRawImageDictionaries:images[@"posters"] ofType:TMDBImageTypePoster context:_context];
+		}
+		else {
+			_posters = nil;
+		}
+
+		// Backdrops
+		if (images != nil && images[@"backdrops"] != nil) {
+			_backdrops = [TMDBImage imageArrayWithRawImageDictionaries:images[@"backdrops"] ofType:TMDBImageTypeBackdrop context:_context];
+		}
+		else {
+			_backdrops = nil;
+		}
+	}
+
+	if (collections & TMDBMovieCollectionCast) {
+		[self decodeCredits];
 	}
 
+	if (collections & TMDBMovieCollectionKeywords) {
+		[self decodeKeywords];
+	}
+
+	if (collections & TMDBMovieCollectionSimilar) {
+		[self decodeSimilarMovies];
+	}
+}
+
+// Private
+- (void)decodeCredits {
 	// Cast and Crew
-	NSDictionary *rawCasts = TMDB_NSDictionaryOrNil(d[@"casts"]);
+	NSDictionary *rawCasts = _rawCasts;
+	_rawCasts = nil;
+	_cast = nil;
+
 	if (rawCasts != nil && rawCasts.count > 0) {
-		NSMutableArray *casts = [NSMutableArray array];
-		for (NSString *key in rawCasts) {
-			NSArray *castsPart = [TMDBPerson personsWithMovie:self personsInfo:rawCasts[key]];
-			if (castsPart.count > 0) {
-				[casts addObjectsFromArray:castsPart];
+		TMDBIdentityMap *identityMap = _context.identityMap;
+		NSMutableArray *credits = [NSMutableArray array];
+
+		for (NSString *key in @[@"cast", @"crew"]) {
+			BOOL castMember = [key isEqualToString:@"cast"];
+
+			for (NSDictionary *rawCredit in TMDB_NSArrayOrNil(rawCasts[key])) {
+				if (TMDB_NSDictionaryOrNil(rawCredit) == nil) {
+					continue;
+				}
+
+				TMDBPerson *person = [identityMap personWithInfo:rawCredit];
+				TMDBCredit *credit = [[TMDBCredit alloc] initWithPerson:person movie:self creditInfo:rawCredit];
+				[credit setCastMember:castMember];
+				[credits addObject:credit];
 			}
 		}
-		_cast = [casts copy];
+		_credits = [credits copy];
 	}
 	else {
-		_cast = nil;
+		_credits = nil;
 	}
+}
 
+// Private
+- (void)decodeKeywords {
 	// Keywords
-	NSArray *rawKeywords = TMDB_NSArrayOrNil(TMDB_NSDictionaryOrNil(d[@"keywords"])[@"keywords"]);
+	NSArray *rawKeywords = _rawKeywords;
+	_rawKeywords = nil;
+
 	if (rawKeywords != nil && rawKeywords.count > 0) {
 		NSMutableArray *keywords = [NSMutableArray arrayWithCapacity:rawKeywords.count];
 		for (NSDictionary *keyword in rawKeywords) {
@@ -216,26 +663,230 @@
 	}
 }
 
+// Private
+- (void)decodeSimilarMovies {
+	// Similar movies, which are search results
+	NSArray *rawSimilar = _rawSimilar;
+	_rawSimilar = nil;
+
+	if (rawSimilar != nil) {
+		NSMutableArray *similarMovies = [NSMutableArray arrayWithCapacity:rawSimilar.count];
+		for (id rawMovie in rawSimilar) {
+			if (TMDB_NSDictionaryOrNil(rawMovie) == nil) {
+				continue;
+			}
+
+			TMDBMovie *movie = [[TMDBMovie alloc] initWithID:0 context:_context];
+			[movie populate:rawMovie];
+			[similarMovies addObject:movie];
+		}
+		_similarMovies = [similarMovies copy];
+	}
+	else {
+		_similarMovies = nil;
+	}
+}
+
+#pragma mark - Response Dictionary
+
+- (NSDictionary *)responseDictionary {
+	NSMutableDictionary *d = [NSMutableDictionary dictionary];
+
+	@synchronized(self) {
+		[self decodeCollections:TMDBMovieCollectionAll];
+
+		// Setting nil leaves the key out
+		d[@"id"] = @(_tmdbID);
+		d[@"title"] = _title;
+		d[@"original_title"] = _originalTitle;
+		d[@"overview"] = _overview;
+		d[@"tagline"] = _tagline;
+		d[@"imdb_id"] = _imdbID;
+		d[@"url"] = _url.absoluteString;
+		d[@"homepage"] = _homepage.absoluteString;
+		d[@"popularity"] = @(_popularity);
+		d[@"votes"] = @(_votes);
+		d[@"rating"] = @(_rating);
+		d[@"adult"] = @(_isAdult);
+
+		// Only the movie's own endpoint returns a runtime, so it marks the
+		// basic information as held.
+		if (_options & TMDBMovieFetchOptionBasic) {
+			d[@"runtime"] = @(_runtime);
+		}
+
+		d[@"release_date"] = [self releaseDateString];
+
+		if (_languagesSpoken != nil) {
+			NSMutableArray *languages = [NSMutableArray arrayWithCapacity:_languagesSpoken.count];
+			for (TMDBLanguage *language in _languagesSpoken) {
+				NSMutableDictionary *rawLanguage = [NSMutableDictionary dictionaryWithCapacity:2];
+				rawLanguage[@"iso_639_1"] = language.iso639_1;
+				rawLanguage[@"name"] = language.name;
+				[languages addObject:rawLanguage];
+			}
+			d[@"spoken_languages"] = languages;
+		}
+
+		// The groups held are kept even if empty, so they aren't loaded again
+		if (_options & TMDBMovieFetchOptionKeywords) {
+			NSMutableArray *keywords = [NSMutableArray arrayWithCapacity:_keywords.count];
+			for (NSString *keyword in _keywords) {
+				[keywords addObject:@{@"name": keyword}];
+			}
+			d[@"keywords"] = @{@"keywords": keywords};
+		}
+
+		if (_options & TMDBMovieFetchOptionImages) {
+			d[@"images"] = @{@"posters": [_posters valueForKey:@"responseDictionary"] ?: @[],
+							 @"backdrops": [_backdrops valueForKey:@"responseDictionary"] ?: @[]};
+		}
+
+		if (_options & TMDBMovieFetchOptionCasts) {
+			NSMutableArray *cast = [NSMutableArray array];
+			NSMutableArray *crew = [NSMutableArray array];
+
+			for (TMDBCredit *credit in _credits) {
+				NSMutableDictionary *rawCredit = [NSMutableDictionary dictionaryWithCapacity:8];
+				TMDBPerson *person = credit.person;
+
+				@synchronized(person) {
+					if (person.id > 0) {
+						rawCredit[@"id"] = @(person.id);
+					}
+					rawCredit[@"name"] = person.name;
+					rawCredit[@"url"] = person.url.absoluteString;
+					rawCredit[@"profile_path"] = person.imageURL.absoluteString;
+				}
+
+				rawCredit[@"character"] = credit.character;
+				rawCredit[@"job"] = credit.job;
+				rawCredit[@"department"] = credit.department;
+				rawCredit[@"order"] = @(credit.order);
+				rawCredit[@"cast_id"] = @(credit.castID);
+
+				if (credit.isCastMember) {
+					[cast addObject:rawCredit];
+				}
+				else {
+					[crew addObject:rawCredit];
+				}
+			}
+
+			d[@"casts"] = @{@"cast": cast, @"crew": crew};
+		}
+
+		if (_options & TMDBMovieFetchOptionVideos) {
+			d[@"videos"] = @{@"results": _videos ?: @[]};
+		}
+
+		if (_options & TMDBMovieFetchOptionReleaseDates) {
+			d[@"release_dates"] = @{@"results": _releaseDates ?: @[]};
+		}
+
+		if (_options & TMDBMovieFetchOptionTranslations) {
+			d[@"translations"] = @{@"translations": _translations ?: @[]};
+		}
+
+		if (_options & TMDBMovieFetchOptionSimilar) {
+			d[@"similar"] = @{@"results": [_similarMovies valueForKey:@"responseDictionary"] ?: @[]};
+		}
+
+		if (_options & TMDBMovieFetchOptionExternalIDs) {
+			d[@"external_ids"] = _externalIDs ?: @{};
+		}
+	}
+
+	return d;
+}
+
+#pragma mark - Memory Footprint
+
+- (TMDBMovieFootprint)footprint {
+	TMDBMovieFootprint footprint = {0};
+
+	@synchronized(self) {
+		for (TMDBImage *image in _posters) {
+			footprint.images += image.footprint;
+		}
+		for (TMDBImage *image in _backdrops) {
+			footprint.images += image.footprint;
+		}
+		footprint.images += TMDBFootprintOfObject(_posters) + TMDBFootprintOfObject(_backdrops);
+
+		for (TMDBCredit *credit in _credits) {
+			footprint.credits += credit.footprint;
+		}
+		// The cast holds the same persons as the credits
+		footprint.credits += TMDBFootprintOfObject(_credits) + TMDBFootprintOfObject(_cast);
+
+		// The parts kept for lazy decoding are inside rawResults, unless it
+		// was discarded.
+		if (_rawResults != nil) {
+			footprint.rawResults = TMDBFootprintOfJSONObject(_rawResults);
+		}
+		else {
+			footprint.rawResults = TMDBFootprintOfJSONObject(_rawSpokenLanguages) +
+								   TMDBFootprintOfJSONObject(_rawImages) +
+								   TMDBFootprintOfJSONObject(_rawCasts) +
+								   TMDBFootprintOfJSONObject(_rawKeywords) +
+								   TMDBFootprintOfJSONObject(_rawSimilar) +
+								   TMDBFootprintOfJSONObject(_videos) +
+								   TMDBFootprintOfJSONObject(_releaseDates) +
+								   TMDBFootprintOfJSONObject(_translations);
+		}
+
+		footprint.strings = TMDBFootprintOfString(_title) +
+							TMDBFootprintOfString(_originalTitle) +
+							TMDBFootprintOfString(_overview) +
+							TMDBFootprintOfString(_tagline) +
+							TMDBFootprintOfString(_imdbID) +
+							TMDBFootprintOfObject(_homepage) +
+							TMDBFootprintOfObject(_url) +
+							TMDBFootprintOfJSONObject(_keywords) +
+							TMDBFootprintOfJSONObject(_categories) +
+							TMDBFootprintOfJSONObject(_countries) +
+							TMDBFootprintOfJSONObject(_externalIDs);
+
+		for (TMDBLanguage *language in _languagesSpoken) {
+			footprint.strings += language.footprint;
+		}
+		footprint.strings += TMDBFootprintOfObject(_languagesSpoken);
+	}
+
+	footprint.total = TMDBFootprintOfObject(self) + footprint.images + footprint.credits + footprint.rawResults + footprint.strings;
+
+	return footprint;
+}
+
 #pragma mark - Helper methods
 
 + (NSUInteger)yearFromDate:(NSDate *)date {
-	static NSDateFormatter *df; // NSDateFormatters are expensive to create
-	static dispatch_once_t onceToken;
-	dispatch_once(&onceToken, ^{
-		df = [[NSDateFormatter alloc] init];
-		df.dateFormat = @"yyyy";
-	});
-	return [df stringFromDate:date].integerValue;
+	if (date == nil) {
+		return 0;
+	}
+
+	time_t time = (time_t)date.timeIntervalSince1970;
+	struct tm components;
+	if (localtime_r(&time, &components) == NULL) {
+		return 0;
+	}
+
+	return (NSUInteger)(components.tm_year + 1900);
+}
+
++ (NSUInteger)yearFromString:(NSString *)dateString {
+	NSInteger year = 0, month = 0, day = 0;
+	TMDBMovieParseDate(TMDB_NSStringOrNil(dateString), &year, &month, &day);
+	return (NSUInteger)year;
 }
 
 + (NSDate *)dateFromString:(NSString *)dateString {
-	static NSDateFormatter *releasedFormatter;
-	static dispatch_once_t onceToken;
-	dispatch_once(&onceToken, ^{
-		releasedFormatter = [[NSDateFormatter alloc] init];
-		releasedFormatter.dateFormat = @"yyyy-MM-dd";
-	});
-	return [releasedFormatter dateFromString:dateString];
+	NSInteger year = 0, month = 0, day = 0;
+	if (!TMDBMovieParseDate(TMDB_NSStringOrNil(dateString), &year, &month, &day)) {
+		return nil;
+	}
+	return TMDBMovieDateFromComponents(year, month, day);
 }
 
 @end
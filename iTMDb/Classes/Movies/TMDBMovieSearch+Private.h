@@ -0,0 +1,28 @@
+//
+//  TMDBMovieSearch+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMovieSearch.h"
+
+// Private methods shared with the other model classes
+@interface TMDBMovieSearch (Private)
+
+/**
+ * The `append_to_response` name of a single fetch option, which is also the
+ * key of its part of a movie response, or `nil` for `TMDBMovieFetchOptionBasic`
+ * and combinations of options.
+ */
++ (nullable NSString *)appendToResponseNameForFetchOption:(TMDBMovieFetchOptions)option;
+
+/**
+ * Populates a movie for every result in a page of search results, loaded
+ * through `context`. Fails with `TMDBErrorCodeReceivedInvalidData` if the
+ * page holds no results.
+ */
++ (nullable NSArray<TMDBMovie *> *)moviesFromSearchData:(nullable NSDictionary *)parsedData context:(nullable TMDB *)context error:(NSError * _Nullable * _Nullable)outError;
+
+@end
@@ -8,20 +8,102 @@
 
 @import Foundation;
 #import "TMDBMovie.h"
+#import "TMDBRequestToken.h"
 
 typedef void (^TMDBMoviesFetchCompletionBlock)(NSArray<TMDBMovie *> * _Nullable movies, NSError * _Nullable error);
+typedef void (^TMDBMovieSearchResultBlock)(TMDBMovie * _Nonnull movie);
 
 @interface TMDBMovieSearch : NSObject
 
 + (nullable NSURL *)fetchURLWithMovieID:(NSUInteger)tmdbID options:(TMDBMovieFetchOptions)options;
 
+/**
+ * The URL of the movie with the given TMDb ID, using the API key and language
+ * of `context`. Pass `nil` to use the shared instance.
+ */
++ (nullable NSURL *)fetchURLWithMovieID:(NSUInteger)tmdbID options:(TMDBMovieFetchOptions)options context:(nullable TMDB *)context;
+
+/**
+ * The URL of just the information of a single fetch option other than
+ * `TMDBMovieFetchOptionBasic`, such as `/movie/{id}/videos`, using the API key
+ * and language of `context`. Returns `nil` for `TMDBMovieFetchOptionBasic` and
+ * combinations of options.
+ */
++ (nullable NSURL *)fetchURLWithMovieID:(NSUInteger)tmdbID option:(TMDBMovieFetchOptions)option context:(nullable TMDB *)context;
+
 + (nullable NSURL *)searchURLWithMovieTitle:(nonnull NSString *)title year:(NSUInteger)year;
 
+/** The URL of the given page of search results. Pages are numbered from `1`. */
++ (nullable NSURL *)searchURLWithMovieTitle:(nonnull NSString *)title year:(NSUInteger)year page:(NSUInteger)page;
+
+/**
+ * The URL of the given page of search results, using the API key and language
+ * of `context`. Pass `nil` to use the shared instance.
+ */
++ (nullable NSURL *)searchURLWithMovieTitle:(nonnull NSString *)title year:(NSUInteger)year page:(NSUInteger)page context:(nullable TMDB *)context;
+
+/**
+ * The URL of the given page of the IDs of movies changed between the two
+ * dates, using the API key of `context`. TMDb accepts windows of up to 14
+ * days. Pages are numbered from `1`.
+ *
+ * @param context The context to use. Pass `nil` to use the shared instance.
+ */
++ (nullable NSURL *)changesURLWithStartDate:(nonnull NSDate *)startDate endDate:(nonnull NSDate *)endDate page:(NSUInteger)page context:(nullable TMDB *)context;
+
 #pragma mark - Searching
 /** @name Searching */
 
-+ (void)moviesWithTitle:(nonnull NSString *)title completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
++ (nonnull TMDBRequestToken *)moviesWithTitle:(nonnull NSString *)title completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
+
++ (nonnull TMDBRequestToken *)moviesWithTitle:(nonnull NSString *)title year:(NSUInteger)year completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
+
+/**
+ * Searches for movies with the given title and, if not `0`, year.
+ *
+ * Results are decoded into `TMDBMovie` objects on a background queue, and only
+ * the completion block is called on `completionQueue`.
+ *
+ * @param completionQueue The queue on which to call the completion block. Pass
+ * `nil` to use the context's `completionQueue`.
+ * @return A token for changing the priority of the search or cancelling it.
+ * Cancel superseded searches, such as those of a search field being typed
+ * in, so they don't use up the rate limit.
+ */
++ (nonnull TMDBRequestToken *)moviesWithTitle:(nonnull NSString *)title year:(NSUInteger)year completionQueue:(nullable dispatch_queue_t)completionQueue completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
+
+/**
+ * Searches for movies with the given title and, if not `0`, year, handing
+ * each result to `resultBlock` as soon as it has been downloaded instead of
+ * waiting for the whole response.
+ *
+ * Results are delivered in order on `completionQueue`, each exactly once, and
+ * always before the completion block is called with the full list. Results
+ * served from the cache, or by a search already in flight, are all delivered
+ * right before the completion block. Passing `nil` for `resultBlock` is the
+ * same as calling `moviesWithTitle:year:completionQueue:completion:`.
+ *
+ * @param completionQueue The queue on which to call both blocks. Pass `nil` to
+ * use the context's `completionQueue`.
+ * @return A token for changing the priority of the search or cancelling it.
+ */
++ (nonnull TMDBRequestToken *)moviesWithTitle:(nonnull NSString *)title year:(NSUInteger)year completionQueue:(nullable dispatch_queue_t)completionQueue resultBlock:(nullable TMDBMovieSearchResultBlock)resultBlock completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
 
-+ (void)moviesWithTitle:(nonnull NSString *)title year:(NSUInteger)year completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
+/**
+ * Searches like `moviesWithTitle:year:completionQueue:resultBlock:completion:`,
+ * through `context` rather than the shared instance. The movies found are
+ * loaded through `context` too.
+ *
+ * If the context has a `titleIndex`, it is searched first, and TMDb is only
+ * asked if it has no matches, or in the background if its `searchPolicy` is
+ * `TMDBMovieTitleIndexSearchPolicyRefresh`.
+ *
+ * @param context The context to search through. Pass `nil` to use the shared
+ * instance.
+ * @param completionQueue The queue on which to call both blocks. Pass `nil` to
+ * use the `completionQueue` of `context`.
+ * @return A token for changing the priority of the search or cancelling it.
+ */
++ (nonnull TMDBRequestToken *)moviesWithTitle:(nonnull NSString *)title year:(NSUInteger)year context:(nullable TMDB *)context completionQueue:(nullable dispatch_queue_t)completionQueue resultBlock:(nullable TMDBMovieSearchResultBlock)resultBlock completion:(nullable TMDBMoviesFetchCompletionBlock)completionBlock;
 
 @end
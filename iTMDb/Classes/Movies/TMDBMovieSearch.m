@@ -7,9 +7,28 @@
 //
 
 #import "TMDBMovieSearch.h"
+#import "TMDBMovieSearch+Private.h"
+#import "TMDBMovieTitleIndex.h"
 #import "TMDB.h"
 #import "TMDBRequest.h"
+#import "TMDBRequestToken+Private.h"
+#import "TMDBRequestMetrics+Private.h"
 #import "TMDBError.h"
+#import "TMDBJSONStreamParser.h"
+
+#include <time.h>
+
+// The day of `date` in UTC as `yyyy-MM-dd`, which is how the changes feed
+// takes its dates.
+static NSString *TMDBMovieSearchDateString(NSDate *date) {
+	time_t time = (time_t)date.timeIntervalSince1970;
+	struct tm components;
+	if (gmtime_r(&time, &components) == NULL) {
+		return nil;
+	}
+
+	return [NSString stringWithFormat:@"%04d-%02d-%02d", components.tm_year + 1900, components.tm_mon + 1, components.tm_mday];
+}
 
 @implementation TMDBMovieSearch
 
@@ -20,30 +39,43 @@
 
 #pragma mark - Fetch URLs
 
-+ (NSString *)appendToResponseStringFromFetchOptions:(TMDBMovieFetchOptions)options {
-	if (options == 0 || options == TMDBMovieFetchOptionBasic) {
-		return @"";
++ (NSString *)appendToResponseNameForFetchOption:(TMDBMovieFetchOptions)option {
+	switch (option) {
+		case TMDBMovieFetchOptionCasts:        return @"casts";
+		case TMDBMovieFetchOptionKeywords:     return @"keywords";
+		case TMDBMovieFetchOptionImages:       return @"images";
+		case TMDBMovieFetchOptionVideos:       return @"videos";
+		case TMDBMovieFetchOptionReleaseDates: return @"release_dates";
+		case TMDBMovieFetchOptionTranslations: return @"translations";
+		case TMDBMovieFetchOptionSimilar:      return @"similar";
+		case TMDBMovieFetchOptionExternalIDs:  return @"external_ids";
+		default:                               return nil;
 	}
+}
 
++ (NSString *)appendToResponseStringFromFetchOptions:(TMDBMovieFetchOptions)options {
 	NSMutableArray *optionsArray = [NSMutableArray array];
 
-	if ((options & TMDBMovieFetchOptionCasts) == TMDBMovieFetchOptionCasts) {
-		[optionsArray addObject:@"casts"];
-	}
-
-	if ((options & TMDBMovieFetchOptionKeywords) == TMDBMovieFetchOptionKeywords) {
-		[optionsArray addObject:@"keywords"];
+	for (TMDBMovieFetchOptions option = TMDBMovieFetchOptionCasts; option <= TMDBMovieFetchOptionExternalIDs; option <<= 1) {
+		NSString *name = (options & option) ? [self appendToResponseNameForFetchOption:option] : nil;
+		if (name != nil) {
+			[optionsArray addObject:name];
+		}
 	}
 
-	if ((options & TMDBMovieFetchOptionImages) == TMDBMovieFetchOptionImages) {
-		[optionsArray addObject:@"images"];
+	if (optionsArray.count == 0) {
+		return @"";
 	}
 
 	return [NSString stringWithFormat:@"&append_to_response=%@", [optionsArray componentsJoinedByString:@","]];
 }
 
 + (NSURL *)fetchURLWithMovieID:(NSUInteger)tmdbID options:(TMDBMovieFetchOptions)options {
-	TMDB *context = [TMDB sharedInstance];
+	return [self fetchURLWithMovieID:tmdbID options:options context:nil];
+}
+
++ (NSURL *)fetchURLWithMovieID:(NSUInteger)tmdbID options:(TMDBMovieFetchOptions)options context:(TMDB *)context {
+	context = context ?: [TMDB sharedInstance];
 	NSString *apiKey = context.apiKey,
 			 *language = context.language,
 			 *additionalQueries = [self appendToResponseStringFromFetchOptions:options];
@@ -53,8 +85,31 @@
 	return [NSURL URLWithString:urlString];
 }
 
++ (NSURL *)fetchURLWithMovieID:(NSUInteger)tmdbID option:(TMDBMovieFetchOptions)option context:(TMDB *)context {
+	NSString *name = [self appendToResponseNameForFetchOption:option];
+	if (name == nil) {
+		return nil;
+	}
+
+	context = context ?: [TMDB sharedInstance];
+	NSString *apiKey = context.apiKey,
+			 *language = context.language;
+
+	NSString *urlString = [TMDBAPIURLBase stringByAppendingFormat:@"%@/movie/%tu/%@?api_key=%@&language=%@", TMDBAPIVersion, tmdbID, name, apiKey, language];
+
+	return [NSURL URLWithString:urlString];
+}
+
 + (NSURL *)searchURLWithMovieTitle:(NSString *)title year:(NSUInteger)year {
-	TMDB *context = [TMDB sharedInstance];
+	return [self searchURLWithMovieTitle:title year:year page:1];
+}
+
++ (NSURL *)searchURLWithMovieTitle:(NSString *)title year:(NSUInteger)year page:(NSUInteger)page {
+	return [self searchURLWithMovieTitle:title year:year page:page context:nil];
+}
+
++ (NSURL *)searchURLWithMovieTitle:(NSString *)title year:(NSUInteger)year page:(NSUInteger)page context:(TMDB *)context {
+	context = context ?: [TMDB sharedInstance];
 
 	NSString *apiKey = context.apiKey,
 			 *language = context.language,
@@ -62,59 +117,262 @@
 
 	NSString *yearQuery = year > 0 ? [NSString stringWithFormat:@"&year=%lu", year] : @"";
 
-	NSString *urlString = [TMDBAPIURLBase stringByAppendingFormat:@"%@/search/movie?api_key=%@&query=%@%@&language=%@",
-						   TMDBAPIVersion, apiKey, titleEscaped, yearQuery, language];
+	// The first page is requested without a page parameter, so it shares its
+	// cache entry with plain searches.
+	NSString *pageQuery = page > 1 ? [NSString stringWithFormat:@"&page=%lu", page] : @"";
+
+	NSString *urlString = [TMDBAPIURLBase stringByAppendingFormat:@"%@/search/movie?api_key=%@&query=%@%@%@&language=%@",
+						   TMDBAPIVersion, apiKey, titleEscaped, yearQuery, pageQuery, language];
+
+	return [NSURL URLWithString:urlString];
+}
+
++ (NSURL *)changesURLWithStartDate:(NSDate *)startDate endDate:(NSDate *)endDate page:(NSUInteger)page context:(TMDB *)context {
+	context = context ?: [TMDB sharedInstance];
+
+	NSString *startString = TMDBMovieSearchDateString(startDate),
+			 *endString = TMDBMovieSearchDateString(endDate);
+	if (startString == nil || endString == nil) {
+		return nil;
+	}
+
+	NSString *pageQuery = page > 1 ? [NSString stringWithFormat:@"&page=%lu", page] : @"";
+
+	NSString *urlString = [TMDBAPIURLBase stringByAppendingFormat:@"%@/movie/changes?api_key=%@&start_date=%@&end_date=%@%@",
+						   TMDBAPIVersion, context.apiKey, startString, endString, pageQuery];
 
 	return [NSURL URLWithString:urlString];
 }
 
 #pragma mark - Searching
 
-+ (void)moviesWithTitle:(NSString *)title completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
-	[self moviesWithTitle:title year:0 completion:completionBlock];
++ (TMDBRequestToken *)moviesWithTitle:(NSString *)title completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	return [self moviesWithTitle:title year:0 completion:completionBlock];
 }
 
-+ (void)moviesWithTitle:(NSString *)title year:(NSUInteger)year completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
-	NSURL *url = [TMDBMovieSearch searchURLWithMovieTitle:title year:year];
++ (TMDBRequestToken *)moviesWithTitle:(NSString *)title year:(NSUInteger)year completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	return [self moviesWithTitle:title year:year completionQueue:nil completion:completionBlock];
+}
+
++ (TMDBRequestToken *)moviesWithTitle:(NSString *)title year:(NSUInteger)year completionQueue:(dispatch_queue_t)completionQueue completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	return [self moviesWithTitle:title year:year completionQueue:completionQueue resultBlock:nil completion:completionBlock];
+}
+
++ (TMDBRequestToken *)moviesWithTitle:(NSString *)title year:(NSUInteger)year completionQueue:(dispatch_queue_t)completionQueue resultBlock:(TMDBMovieSearchResultBlock)resultBlock completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	return [self moviesWithTitle:title year:year context:nil completionQueue:completionQueue resultBlock:resultBlock completion:completionBlock];
+}
+
++ (TMDBRequestToken *)moviesWithTitle:(NSString *)title year:(NSUInteger)year context:(TMDB *)context completionQueue:(dispatch_queue_t)completionQueue resultBlock:(TMDBMovieSearchResultBlock)resultBlock completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	context = context ?: [TMDB sharedInstance];
+	dispatch_queue_t queue = completionQueue ?: context.completionQueue;
+	NSURL *url = [TMDBMovieSearch searchURLWithMovieTitle:title year:year page:1 context:context];
+	TMDBRequestToken *token = [[TMDBRequestToken alloc] init];
 
 	if (url == nil) {
 		if (completionBlock != nil) {
 			NSError *error = [NSError errorWithDomain:TMDBErrorDomain
 												 code:TMDBErrorCodeInvalidURL
 											 userInfo:nil];
-			completionBlock(nil, error);
+			dispatch_async(queue, ^{
+				completionBlock(nil, error);
+			});
 		}
-		return;
+		return token;
 	}
 
-	[TMDBMovieSearch loadSearchURL:url completion:completionBlock];
+	TMDBMovieTitleIndex *titleIndex = context.titleIndex;
+	if (titleIndex != nil) {
+		[TMDBMovieSearch searchTitleIndex:titleIndex title:title year:year url:url context:context completionQueue:queue token:token resultBlock:resultBlock completion:completionBlock];
+	}
+	else {
+		[token setSubscription:[TMDBMovieSearch subscribeToSearchURL:url context:context completionQueue:queue token:token resultBlock:resultBlock completion:completionBlock]];
+	}
+
+	return token;
+}
+
+#pragma mark - Searching Locally
+
+// Private. Searches the title index on the work queue, so large indexes don't
+// hold up the caller, and falls back to TMDb if it has no matches.
++ (void)searchTitleIndex:(TMDBMovieTitleIndex *)titleIndex title:(NSString *)title year:(NSUInteger)year url:(NSURL *)url context:(TMDB *)context completionQueue:(dispatch_queue_t)queue token:(TMDBRequestToken *)token resultBlock:(TMDBMovieSearchResultBlock)resultBlock completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	dispatch_async([TMDBRequest workQueue], ^{
+		if (token.isCancelled) {
+			return;
+		}
+
+		NSArray<TMDBMovie *> *movies = [titleIndex moviesMatchingTitle:title year:year context:context];
+		if (movies.count == 0) {
+			[token setSubscription:[TMDBMovieSearch subscribeToSearchURL:url context:context completionQueue:queue token:token resultBlock:resultBlock completion:completionBlock]];
+			return;
+		}
+
+		dispatch_async(queue, ^{
+			if (token.isCancelled) {
+				return;
+			}
+
+			if (resultBlock != nil) {
+				for (TMDBMovie *movie in movies) {
+					resultBlock(movie);
+				}
+			}
+
+			if (completionBlock != nil) {
+				completionBlock(movies, nil);
+			}
+		});
+
+		// The results populate movies through the context, which adds them
+		// to the index for the next search.
+		if (titleIndex.searchPolicy == TMDBMovieTitleIndexSearchPolicyRefresh) {
+			[token setSubscription:[TMDBMovieSearch loadSearchURL:url context:context completionQueue:queue token:token completion:nil]];
+		}
+	});
 }
 
 #pragma mark - Fetching
 
 // Private
-+ (void)loadSearchURL:(NSURL *)url completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
-	[TMDBRequest requestWithURL:url completionBlock:^(id parsedData, NSError *error) {
++ (TMDBRequestSubscription *)subscribeToSearchURL:(NSURL *)url context:(TMDB *)context completionQueue:(dispatch_queue_t)queue token:(TMDBRequestToken *)token resultBlock:(TMDBMovieSearchResultBlock)resultBlock completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	if (resultBlock != nil) {
+		return [TMDBMovieSearch streamSearchURL:url context:context completionQueue:queue token:token resultBlock:resultBlock completion:completionBlock];
+	}
+
+	return [TMDBMovieSearch loadSearchURL:url context:context completionQueue:queue token:token completion:completionBlock];
+}
+
+// Private
++ (TMDBRequestSubscription *)loadSearchURL:(NSURL *)url context:(TMDB *)context completionQueue:(dispatch_queue_t)queue token:(TMDBRequestToken *)token completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	__weak TMDBRequestToken *weakToken = token;
+
+	return [TMDBRequest requestWithURL:url context:context completionBlock:^(id parsedData, NSError *error) {
+		if (weakToken.isCancelled) {
+			return;
+		}
+
+		TMDBRequestMetrics *metrics = TMDBRequestMetricsCurrent();
+
 		if (error != nil) {
 			if (completionBlock != nil) {
-				completionBlock(nil, error);
+				TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+					if (!weakToken.isCancelled) {
+						completionBlock(nil, error);
+					}
+				});
 			}
 			return;
 		}
 
+		CFAbsoluteTime populateStart = CFAbsoluteTimeGetCurrent();
 		NSError *error2 = nil;
-		NSArray *movies = [TMDBMovieSearch moviesFromSearchData:parsedData error:&error2];
+		NSArray *movies = [TMDBMovieSearch moviesFromSearchData:parsedData context:context error:&error2];
+		[metrics addDuration:CFAbsoluteTimeGetCurrent() - populateStart toPhase:TMDBRequestPhasePopulate];
 
 		if (completionBlock != nil) {
-			completionBlock(movies, error2);
+			TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+				if (!weakToken.isCancelled) {
+					completionBlock(movies, error2);
+				}
+			});
 		}
 	}];
 }
 
+// Private
++ (TMDBRequestSubscription *)streamSearchURL:(NSURL *)url context:(TMDB *)context completionQueue:(dispatch_queue_t)queue token:(TMDBRequestToken *)token resultBlock:(TMDBMovieSearchResultBlock)resultBlock completion:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	// Chunks and the final response are handled one after another on this
+	// queue, so results can't overtake each other or the completion block.
+	dispatch_queue_t streamQueue = dispatch_queue_create("dk.devify.tmdb.search.stream", DISPATCH_QUEUE_SERIAL);
+	dispatch_set_target_queue(streamQueue, [TMDBRequest workQueue]);
+
+	TMDBJSONStreamParser *parser = [[TMDBJSONStreamParser alloc] initWithArrayKey:@"results"];
+	NSMutableArray<TMDBMovie *> *streamedMovies = [NSMutableArray array];
+	__weak TMDBRequestToken *weakToken = token;
+
+	// Blocks already on their way to the completion queue check the token
+	// again, so nothing is delivered once the search has been cancelled.
+	void (^deliver)(TMDBMovie *) = ^(TMDBMovie *movie) {
+		dispatch_async(queue, ^{
+			if (!weakToken.isCancelled) {
+				resultBlock(movie);
+			}
+		});
+	};
+
+	TMDBRequestDataBlock dataBlock = ^(NSData *data) {
+		dispatch_async(streamQueue, ^{
+			if (weakToken.isCancelled) {
+				return;
+			}
+
+			for (NSData *objectData in [parser objectsByAppendingData:data]) {
+				NSDictionary *rawResult = TMDB_NSDictionaryOrNil([NSJSONSerialization JSONObjectWithData:objectData options:0 error:nil]);
+				if (rawResult == nil) {
+					continue;
+				}
+
+				TMDBMovie *movie = [[TMDBMovie alloc] initWithID:0 context:context];
+				[movie populate:rawResult];
+				[streamedMovies addObject:movie];
+
+				deliver(movie);
+			}
+		});
+	};
+
+	return [TMDBRequest requestWithURL:url context:context dataBlock:dataBlock completionBlock:^(id parsedData, NSError *error) {
+		// The hop to the stream queue is counted as completion dispatch too
+		TMDBRequestMetrics *metrics = TMDBRequestMetricsCurrent();
+
+		TMDBRequestMetricsDispatchAsync(metrics, streamQueue, ^{
+			if (weakToken.isCancelled) {
+				return;
+			}
+
+			if (error != nil) {
+				if (completionBlock != nil) {
+					TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+						if (!weakToken.isCancelled) {
+							completionBlock(nil, error);
+						}
+					});
+				}
+				return;
+			}
+
+			CFAbsoluteTime populateStart = CFAbsoluteTimeGetCurrent();
+			NSError *error2 = nil;
+			NSArray *movies = [TMDBMovieSearch moviesFromSearchData:parsedData context:context existingMovies:streamedMovies error:&error2];
+			[metrics addDuration:CFAbsoluteTimeGetCurrent() - populateStart toPhase:TMDBRequestPhasePopulate];
+
+			// Deliver whatever didn't arrive through the stream, which is
+			// everything for cached and shared responses.
+			for (NSUInteger i = streamedMovies.count; i < movies.count; i++) {
+				deliver(movies[i]);
+			}
+
+			if (completionBlock != nil) {
+				TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+					if (!weakToken.isCancelled) {
+						completionBlock(movies, error2);
+					}
+				});
+			}
+		});
+	}];
+}
+
 #pragma mark - Parsing
 
 // Private
-+ (NSArray *)moviesFromSearchData:(NSDictionary *)parsedData error:(NSError **)outError {
++ (NSArray *)moviesFromSearchData:(NSDictionary *)parsedData context:(TMDB *)context error:(NSError **)outError {
+	return [self moviesFromSearchData:parsedData context:context existingMovies:nil error:outError];
+}
+
+// Private. The first results are taken from `existingMovies`, which holds
+// movies already populated from those same results.
++ (NSArray *)moviesFromSearchData:(NSDictionary *)parsedData context:(TMDB *)context existingMovies:(NSArray<TMDBMovie *> *)existingMovies error:(NSError **)outError {
 	NSArray *rawResults = (NSArray *)parsedData[@"results"];
 
 	if (rawResults == nil || rawResults.count == 0 || ![rawResults.firstObject isKindOfClass:[NSDictionary class]]) {
@@ -138,7 +396,12 @@
 			continue;
 		}
 
-		TMDBMovie *movie = [[TMDBMovie alloc] init];
+		if (movies.count < existingMovies.count) {
+			[movies addObject:existingMovies[movies.count]];
+			continue;
+		}
+
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:0 context:context];
 		[movie populate:rawResult];
 
 		if (movie != nil) {
@@ -157,8 +420,7 @@
 	// said year, if any.
 	if (isSearching && expectedYear != 0) {
 		for (NSDictionary *result in rawResults) {
-			NSDate *releaseDate = [TMDBMovie dateFromString:(NSString *)result[@"release_date"]];
-			NSUInteger releaseYear = [TMDBMovie yearFromDate:releaseDate];
+			NSUInteger releaseYear = [TMDBMovie yearFromString:(NSString *)result[@"release_date"]];
 
 			if (releaseYear == expectedYear) {
 				d = result;
@@ -0,0 +1,102 @@
+//
+//  TMDBMovieSearchCursor.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBMovieSearch.h"
+
+typedef void (^TMDBMovieSearchEnumerationBlock)(TMDBMovie * _Nonnull movie, NSUInteger index, BOOL * _Nonnull stop);
+typedef void (^TMDBMovieSearchEnumerationCompletionBlock)(NSError * _Nullable error);
+
+/**
+ * A `TMDBMovieSearchCursor` walks through all pages of the results of a movie
+ * search.
+ *
+ * While you work through one page, the cursor loads the following pages in the
+ * background, so walking deep into the results is limited by how fast you
+ * process them rather than by the round trip of every request.
+ */
+@interface TMDBMovieSearchCursor : NSObject
+
+/** @name Creating a Cursor */
+
+/**
+ * Creates a cursor for the movies with the given title and, if not `0`, year,
+ * searching through the shared context. No requests are made until the first
+ * page is asked for.
+ */
+- (nonnull instancetype)initWithTitle:(nonnull NSString *)title year:(NSUInteger)year;
+
+/**
+ * Creates a cursor for the movies with the given title and, if not `0`, year,
+ * searching through `context`. Pass `nil` to use the shared instance.
+ */
+- (nonnull instancetype)initWithTitle:(nonnull NSString *)title year:(NSUInteger)year context:(nullable TMDB *)context NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+/** @name Configuring the Cursor */
+
+/** The context the cursor searches through. */
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
+
+/**
+ * The number of pages loaded ahead of the last page asked for. Set to `0` to
+ * only load a page when it's asked for. Default `1`.
+ */
+@property (atomic) NSUInteger lookahead;
+
+/**
+ * The highest page the cursor will load, or `0` for no limit. Default `0`.
+ * TMDb serves no more than 500 pages of results, so the cursor never goes
+ * past page 500 either way.
+ */
+@property (atomic) NSUInteger maximumPages;
+
+/**
+ * The queue on which completion and enumeration blocks are called. Default is
+ * the `completionQueue` of `context`.
+ */
+@property (atomic, strong, null_resettable) dispatch_queue_t completionQueue;
+
+/** @name Reading Results */
+
+/** The total number of pages of results, or `0` until the first page has loaded. */
+@property (atomic, readonly) NSUInteger totalPages;
+
+/** The total number of results, or `0` until the first page has loaded. */
+@property (atomic, readonly) NSUInteger totalResults;
+
+/** The number of the last page delivered, or `0` if none has been. */
+@property (atomic, readonly) NSUInteger currentPage;
+
+/**
+ * Loads the next page of results, or delivers it right away if it has already
+ * been loaded ahead.
+ *
+ * Once all pages, or `maximumPages` pages, have been delivered, the completion
+ * block is called with an empty array. If a page fails to load, the completion
+ * block gets the error, and the next call tries the same page again.
+ */
+- (void)nextPage:(nonnull TMDBMoviesFetchCompletionBlock)completionBlock;
+
+/**
+ * Calls `block` with every remaining result, page by page, in order.
+ *
+ * @param completionBlock Called once all results have been enumerated, `stop`
+ * has been set, or a page failed to load.
+ */
+- (void)enumerateMoviesUsingBlock:(nonnull TMDBMovieSearchEnumerationBlock)block completion:(nullable TMDBMovieSearchEnumerationCompletionBlock)completionBlock;
+
+/**
+ * Cancels all page requests. Pending completion blocks are called with an
+ * `NSURLErrorCancelled` error.
+ */
+- (void)cancel;
+
+@end
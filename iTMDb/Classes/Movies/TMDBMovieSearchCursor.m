@@ -0,0 +1,277 @@
+//
+//  TMDBMovieSearchCursor.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMovieSearchCursor.h"
+#import "TMDBMovieSearch+Private.h"
+#import "TMDB.h"
+#import "TMDBRequest.h"
+
+// TMDb rejects search pages past this one, however many results there are
+static const NSUInteger TMDBMovieSearchCursorMaximumPage = 500;
+
+@implementation TMDBMovieSearchCursor {
+@private
+	NSString *_title;
+	NSUInteger _year;
+	dispatch_queue_t _completionQueue;
+
+	// All state below is only touched on this queue
+	dispatch_queue_t _queue;
+	NSMutableDictionary<NSNumber *, TMDBRequestSubscription *> *_pendingPages;
+	NSMutableDictionary<NSNumber *, NSArray<TMDBMovie *> *> *_loadedPages;
+	NSMutableDictionary<NSNumber *, NSError *> *_failedPages;
+	NSMutableArray<TMDBMoviesFetchCompletionBlock> *_waiting;
+	NSUInteger _nextPage;
+}
+
+@synthesize totalPages=_totalPages, totalResults=_totalResults, currentPage=_currentPage;
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithTitle:(NSString *)title year:(NSUInteger)year {
+	return (self = [self initWithTitle:title year:year context:nil]);
+}
+
+- (instancetype)initWithTitle:(NSString *)title year:(NSUInteger)year context:(TMDB *)context {
+	NSParameterAssert(title != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_context = context ?: [TMDB sharedInstance];
+	_title = [title copy];
+	_year = year;
+	_lookahead = 1;
+
+	_queue = dispatch_queue_create("dk.devify.tmdb.searchcursor", DISPATCH_QUEUE_SERIAL);
+	dispatch_set_target_queue(_queue, [TMDBRequest workQueue]);
+	_pendingPages = [NSMutableDictionary dictionary];
+	_loadedPages = [NSMutableDictionary dictionary];
+	_failedPages = [NSMutableDictionary dictionary];
+	_waiting = [NSMutableArray array];
+	_nextPage = 1;
+
+	return self;
+}
+
+- (dispatch_queue_t)completionQueue {
+	@synchronized(self) {
+		return _completionQueue ?: _context.completionQueue;
+	}
+}
+
+- (void)setCompletionQueue:(dispatch_queue_t)completionQueue {
+	@synchronized(self) {
+		_completionQueue = completionQueue;
+	}
+}
+
+#pragma mark - Reading Results
+
+- (void)nextPage:(TMDBMoviesFetchCompletionBlock)completionBlock {
+	NSParameterAssert(completionBlock != nil);
+
+	dispatch_async(_queue, ^{
+		[self->_waiting addObject:[completionBlock copy]];
+		[self deliverPages];
+		[self loadPages];
+	});
+}
+
+- (void)enumerateMoviesUsingBlock:(TMDBMovieSearchEnumerationBlock)block completion:(TMDBMovieSearchEnumerationCompletionBlock)completionBlock {
+	NSParameterAssert(block != nil);
+
+	[self enumerateFromIndex:0 usingBlock:block completion:completionBlock];
+}
+
+// Private
+- (void)enumerateFromIndex:(NSUInteger)index usingBlock:(TMDBMovieSearchEnumerationBlock)block completion:(TMDBMovieSearchEnumerationCompletionBlock)completionBlock {
+	[self nextPage:^(NSArray<TMDBMovie *> *movies, NSError *error) {
+		if (error != nil || movies.count == 0) {
+			if (completionBlock != nil) {
+				completionBlock(error);
+			}
+			return;
+		}
+
+		// The following page is already being loaded while this one is
+		// enumerated.
+		BOOL stop = NO;
+		NSUInteger nextIndex = index;
+		for (TMDBMovie *movie in movies) {
+			block(movie, nextIndex++, &stop);
+			if (stop) {
+				if (completionBlock != nil) {
+					completionBlock(nil);
+				}
+				return;
+			}
+		}
+
+		[self enumerateFromIndex:nextIndex usingBlock:block completion:completionBlock];
+	}];
+}
+
+- (void)cancel {
+	dispatch_async(_queue, ^{
+		for (TMDBRequestSubscription *subscription in self->_pendingPages.allValues) {
+			[subscription cancel];
+		}
+		[self->_pendingPages removeAllObjects];
+
+		NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+		dispatch_queue_t completionQueue = self.completionQueue;
+		for (TMDBMoviesFetchCompletionBlock completionBlock in self->_waiting) {
+			dispatch_async(completionQueue, ^{
+				completionBlock(nil, error);
+			});
+		}
+		[self->_waiting removeAllObjects];
+	});
+}
+
+#pragma mark - Private
+
+// The last page that may be loaded. Until the total number of pages is known,
+// only `maximumPages` and TMDb's own limit apply.
+- (NSUInteger)lastPage {
+	NSUInteger lastPage = TMDBMovieSearchCursorMaximumPage;
+	NSUInteger totalPages = self.totalPages;
+	NSUInteger maximumPages = self.maximumPages;
+
+	if (totalPages > 0) {
+		lastPage = MIN(lastPage, totalPages);
+	}
+	if (maximumPages > 0) {
+		lastPage = MIN(lastPage, maximumPages);
+	}
+
+	return lastPage;
+}
+
+- (void)loadPages {
+	// Every waiting caller needs a page of its own, starting at _nextPage, and
+	// the lookahead pages follow the last of them. With nobody waiting, only
+	// the lookahead pages are loaded, so a lookahead of 0 loads on demand.
+	// Until the first page has told us how many there are, don't guess.
+	BOOL totalKnown = self.totalPages > 0;
+	NSUInteger lookahead = totalKnown ? MIN(self.lookahead, TMDBMovieSearchCursorMaximumPage) : 0;
+	NSUInteger lastWanted = _nextPage + MIN(_waiting.count, TMDBMovieSearchCursorMaximumPage) + lookahead - 1;
+	lastWanted = MIN(lastWanted, self.lastPage);
+
+	if (!totalKnown) {
+		lastWanted = MIN(lastWanted, _nextPage);
+	}
+
+	for (NSUInteger page = _nextPage; page <= lastWanted; page++) {
+		NSNumber *key = @(page);
+		if (_pendingPages[key] != nil || _loadedPages[key] != nil || _failedPages[key] != nil) {
+			continue;
+		}
+
+		[self loadPage:page];
+	}
+}
+
+- (void)loadPage:(NSUInteger)page {
+	NSURL *url = [TMDBMovieSearch searchURLWithMovieTitle:_title year:_year page:page context:_context];
+
+	if (url == nil) {
+		_failedPages[@(page)] = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidURL userInfo:nil];
+		return;
+	}
+
+	TMDBRequestSubscription *subscription = [TMDBRequest requestWithURL:url context:_context completionBlock:^(id parsedData, NSError *error) {
+		// Decode on the work queue, and only update the cursor's state on its
+		// own queue.
+		NSDictionary *rawPage = TMDB_NSDictionaryOrNil(parsedData);
+		NSUInteger totalResults = TMDB_NSNumberOrNil(rawPage[@"total_results"]).unsignedIntegerValue;
+		NSUInteger totalPages = TMDB_NSNumberOrNil(rawPage[@"total_pages"]).unsignedIntegerValue;
+		NSArray *movies = nil;
+
+		if (error == nil && rawPage != nil && totalResults == 0) {
+			movies = @[];
+		}
+		else if (error == nil) {
+			movies = [TMDBMovieSearch moviesFromSearchData:rawPage context:self->_context error:&error];
+		}
+
+		dispatch_async(self->_queue, ^{
+			if (self->_pendingPages[@(page)] == nil) {
+				return; // Cancelled
+			}
+
+			[self->_pendingPages removeObjectForKey:@(page)];
+
+			if (movies != nil) {
+				// A search without results still has the one, empty page
+				[self setTotalPages:MAX(totalPages, 1) totalResults:totalResults];
+				self->_loadedPages[@(page)] = movies;
+			}
+			else {
+				self->_failedPages[@(page)] = error;
+			}
+
+			[self deliverPages];
+			[self loadPages];
+		});
+	}];
+
+	if (subscription != nil) {
+		_pendingPages[@(page)] = subscription;
+	}
+}
+
+- (void)setTotalPages:(NSUInteger)totalPages totalResults:(NSUInteger)totalResults {
+	if (totalPages != _totalPages) {
+		TMDBSetIvarValue(totalPages, _totalPages, totalPages);
+	}
+	if (totalResults != _totalResults) {
+		TMDBSetIvarValue(totalResults, _totalResults, totalResults);
+	}
+}
+
+- (void)deliverPages {
+	dispatch_queue_t completionQueue = self.completionQueue;
+
+	while (_waiting.count > 0) {
+		TMDBMoviesFetchCompletionBlock completionBlock = _waiting.firstObject;
+		NSNumber *key = @(_nextPage);
+		NSArray *movies = nil;
+		NSError *error = nil;
+
+		if (_nextPage > self.lastPage) {
+			movies = @[];
+		}
+		else if (_loadedPages[key] != nil) {
+			movies = _loadedPages[key];
+			[_loadedPages removeObjectForKey:key];
+			TMDBSetIvarValue(currentPage, _currentPage, _nextPage);
+			_nextPage++;
+		}
+		else if (_failedPages[key] != nil) {
+			// Forget the failure so the next call tries again
+			error = _failedPages[key];
+			[_failedPages removeObjectForKey:key];
+		}
+		else {
+			break;
+		}
+
+		[_waiting removeObjectAtIndex:0];
+		dispatch_async(completionQueue, ^{
+			completionBlock(movies, error);
+		});
+	}
+}
+
+@end
@@ -0,0 +1,116 @@
+//
+//  TMDBMovieSnapshot.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBMovie.h"
+
+/** The version of the snapshot format written by `TMDBMovieSnapshotWriter`. */
+extern const NSUInteger TMDBMovieSnapshotVersion;
+
+/**
+ * A `TMDBMovieSnapshotWriter` collects movies, including their credits,
+ * images and spoken languages, and writes them to a compact binary snapshot
+ * that `TMDBMovieSnapshot` can read back.
+ *
+ * Videos, release dates, translations, similar movies and external IDs
+ * aren't stored, so a movie read back doesn't hold them in its `options`.
+ *
+ * Every distinct string is stored once, however many movies and credits use
+ * it. Movies are indexed by their TMDb ID, so a reader can find and decode a
+ * single movie without reading the rest of the file.
+ *
+ * The writer isn't safe to use from several threads at once.
+ */
+@interface TMDBMovieSnapshotWriter : NSObject
+
+/**
+ * Adds a movie to the snapshot. A movie with the same TMDb ID added earlier is
+ * replaced. The movie is encoded right away, so it may be changed or released
+ * afterwards.
+ */
+- (void)addMovie:(nonnull TMDBMovie *)movie;
+
+/** The number of movies added so far. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** Returns the snapshot of the movies added so far. */
+- (nonnull NSData *)snapshotData;
+
+/**
+ * Writes the snapshot of the movies added so far to `url`, replacing any file
+ * already there.
+ */
+- (BOOL)writeToURL:(nonnull NSURL *)url error:(NSError * _Nullable * _Nullable)outError;
+
+@end
+
+/**
+ * A `TMDBMovieSnapshot` reads movies from a snapshot written by
+ * `TMDBMovieSnapshotWriter`.
+ *
+ * Snapshots read from a file are memory-mapped, and opening one only checks
+ * its header. Looking up a movie searches the index in place, and only the
+ * movie asked for is decoded. The strings of a decoded movie are copied, so
+ * movies don't refer back to the snapshot and can outlive it. Enumerating
+ * titles reads them in place instead.
+ *
+ * Snapshots are immutable, and safe to read from any thread.
+ */
+@interface TMDBMovieSnapshot : NSObject
+
+/** @name Opening a Snapshot */
+
+/**
+ * Memory-maps the snapshot at `url`. Fails with
+ * `TMDBErrorCodeInvalidSnapshot` if the file isn't a snapshot, or was written
+ * by a newer version of the format.
+ */
+- (nullable instancetype)initWithContentsOfURL:(nonnull NSURL *)url error:(NSError * _Nullable * _Nullable)outError;
+
+/**
+ * Reads the snapshot in `data`, which is used in place rather than copied.
+ */
+- (nullable instancetype)initWithData:(nonnull NSData *)data error:(NSError * _Nullable * _Nullable)outError NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+/** @name Reading Movies */
+
+/** The version of the format the snapshot was written in. */
+@property (nonatomic, readonly) NSUInteger version;
+
+/** The number of movies in the snapshot. */
+@property (nonatomic, readonly) NSUInteger count;
+
+- (BOOL)containsMovieWithID:(NSUInteger)tmdbID;
+
+/**
+ * Decodes the movie with the given TMDb ID into a new movie object, populated
+ * using the context's `moviePopulateOptions`.
+ *
+ * @param context The context the movie is loaded through afterwards. Pass
+ * `nil` to use the shared instance.
+ * @return The movie, or `nil` if the snapshot doesn't contain it, or its
+ * record is damaged.
+ */
+- (nullable TMDBMovie *)movieWithID:(NSUInteger)tmdbID context:(nullable TMDB *)context;
+
+/** Calls `block` with the TMDb ID of every movie, in ascending order. */
+- (void)enumerateMovieIDsUsingBlock:(nonnull void (^)(NSUInteger tmdbID, BOOL * _Nonnull stop))block;
+
+/**
+ * Calls `block` with the TMDb ID and title of every movie, in ascending order
+ * of ID, without decoding the rest of the movies.
+ *
+ * The titles aren't copied out of the snapshot, so they're only valid within
+ * the block. Copy a title to keep it.
+ */
+- (void)enumerateMovieTitlesUsingBlock:(nonnull void (^)(NSUInteger tmdbID, NSString * _Nullable title, BOOL * _Nonnull stop))block;
+
+@end
@@ -0,0 +1,693 @@
+//
+//  TMDBMovieSnapshot.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMovieSnapshot.h"
+#import "TMDBMovie+Private.h"
+#import "TMDB.h"
+#import "TMDBError.h"
+
+// A snapshot is laid out as follows, with all integers little-endian:
+//
+// Header, 64 bytes:
+//    0  char[8]  "TMDBSNAP"
+//    8  uint32   format version
+//   12  uint32   number of movies
+//   16  uint32   number of strings
+//   20  uint32   reserved, 0
+//   24  uint64   offset of the index
+//   32  uint64   offset of the string offsets
+//   40  uint64   offset of the string bytes
+//   48  uint64   offset of the movie records
+//   56  uint64   length of the file
+//
+// Index: for every movie, sorted by TMDb ID, a uint64 TMDb ID and the uint64
+// offset of its record.
+//
+// Strings: the number of strings plus one uint32 offsets into the string
+// bytes, followed by the UTF-8 bytes of every string, not terminated. Records
+// refer to strings by their uint32 index, or TMDBSnapshotNoString.
+//
+// Records: one per movie, as written by -encodeMovieDictionary:.
+
+const NSUInteger TMDBMovieSnapshotVersion = 1;
+
+static const char TMDBSnapshotMagic[8] = {'T', 'M', 'D', 'B', 'S', 'N', 'A', 'P'};
+static const NSUInteger TMDBSnapshotHeaderLength = 64;
+static const NSUInteger TMDBSnapshotIndexEntryLength = 16;
+static const uint32_t TMDBSnapshotNoString = UINT32_MAX;
+
+// Which optional parts a movie record holds. Absent parts are left out of the
+// response the movie is populated with, which isn't the same as being empty.
+typedef NS_OPTIONS(uint32_t, TMDBSnapshotMovieFlags) {
+	TMDBSnapshotMovieFlagAdult     = 1 << 0,
+	TMDBSnapshotMovieFlagLanguages = 1 << 1,
+	TMDBSnapshotMovieFlagKeywords  = 1 << 2,
+	TMDBSnapshotMovieFlagPosters   = 1 << 3,
+	TMDBSnapshotMovieFlagBackdrops = 1 << 4,
+	TMDBSnapshotMovieFlagCredits   = 1 << 5,
+	// The runtime is from the movie's own endpoint, not a search result
+	TMDBSnapshotMovieFlagBasic     = 1 << 6
+};
+
+#pragma mark - Encoding
+
+static void TMDBSnapshotAppendUInt32(NSMutableData *data, uint32_t value) {
+	value = CFSwapInt32HostToLittle(value);
+	[data appendBytes:&value length:sizeof(value)];
+}
+
+static void TMDBSnapshotAppendUInt64(NSMutableData *data, uint64_t value) {
+	value = CFSwapInt64HostToLittle(value);
+	[data appendBytes:&value length:sizeof(value)];
+}
+
+static void TMDBSnapshotAppendFloat(NSMutableData *data, float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	TMDBSnapshotAppendUInt32(data, bits);
+}
+
+static void TMDBSnapshotAppendDouble(NSMutableData *data, double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	TMDBSnapshotAppendUInt64(data, bits);
+}
+
+static void TMDBSnapshotWriteUInt32(NSMutableData *data, NSUInteger offset, uint32_t value) {
+	value = CFSwapInt32HostToLittle(value);
+	[data replaceBytesInRange:NSMakeRange(offset, sizeof(value)) withBytes:&value];
+}
+
+static void TMDBSnapshotWriteUInt64(NSMutableData *data, NSUInteger offset, uint64_t value) {
+	value = CFSwapInt64HostToLittle(value);
+	[data replaceBytesInRange:NSMakeRange(offset, sizeof(value)) withBytes:&value];
+}
+
+#pragma mark - Decoding
+
+// Reads values one after another, and fails rather than reading past the end
+typedef struct TMDBSnapshotCursor {
+	const uint8_t *bytes;
+	NSUInteger length;
+	NSUInteger position;
+	BOOL failed;
+} TMDBSnapshotCursor;
+
+static BOOL TMDBSnapshotCursorCanRead(TMDBSnapshotCursor *cursor, NSUInteger length) {
+	if (cursor->failed || cursor->position > cursor->length || cursor->length - cursor->position < length) {
+		cursor->failed = YES;
+		return NO;
+	}
+	return YES;
+}
+
+static uint32_t TMDBSnapshotReadUInt32(TMDBSnapshotCursor *cursor) {
+	uint32_t value = 0;
+	if (TMDBSnapshotCursorCanRead(cursor, sizeof(value))) {
+		memcpy(&value, cursor->bytes + cursor->position, sizeof(value));
+		cursor->position += sizeof(value);
+	}
+	return CFSwapInt32LittleToHost(value);
+}
+
+static uint64_t TMDBSnapshotReadUInt64(TMDBSnapshotCursor *cursor) {
+	uint64_t value = 0;
+	if (TMDBSnapshotCursorCanRead(cursor, sizeof(value))) {
+		memcpy(&value, cursor->bytes + cursor->position, sizeof(value));
+		cursor->position += sizeof(value);
+	}
+	return CFSwapInt64LittleToHost(value);
+}
+
+static float TMDBSnapshotReadFloat(TMDBSnapshotCursor *cursor) {
+	uint32_t bits = TMDBSnapshotReadUInt32(cursor);
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static double TMDBSnapshotReadDouble(TMDBSnapshotCursor *cursor) {
+	uint64_t bits = TMDBSnapshotReadUInt64(cursor);
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// Reads an element count, failing if the remaining bytes can't possibly hold
+// that many elements of at least `minimumLength` bytes each.
+static uint32_t TMDBSnapshotReadCount(TMDBSnapshotCursor *cursor, NSUInteger minimumLength) {
+	uint32_t count = TMDBSnapshotReadUInt32(cursor);
+	if (!cursor->failed && (cursor->length - cursor->position) / minimumLength < count) {
+		cursor->failed = YES;
+		return 0;
+	}
+	return count;
+}
+
+#pragma mark -
+
+@implementation TMDBMovieSnapshotWriter {
+@private
+	NSMutableArray<NSString *> *_strings;
+	NSMutableDictionary<NSString *, NSNumber *> *_stringIndexes;
+	NSMutableDictionary<NSNumber *, NSData *> *_records;
+}
+
+- (instancetype)init {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_strings = [NSMutableArray array];
+	_stringIndexes = [NSMutableDictionary dictionary];
+	_records = [NSMutableDictionary dictionary];
+
+	return self;
+}
+
+- (NSUInteger)count {
+	return _records.count;
+}
+
+- (void)addMovie:(TMDBMovie *)movie {
+	NSParameterAssert(movie != nil);
+
+	NSDictionary *d = [movie responseDictionary];
+	_records[@((uint64_t)movie.tmdbID)] = [self encodeMovieDictionary:d];
+}
+
+#pragma mark - Writing
+
+- (NSData *)snapshotData {
+	NSArray<NSNumber *> *tmdbIDs = [_records.allKeys sortedArrayUsingSelector:@selector(compare:)];
+	NSMutableData *data = [NSMutableData dataWithLength:TMDBSnapshotHeaderLength];
+
+	// Index, with the record offsets filled in once they are known
+	uint64_t indexOffset = data.length;
+	for (NSNumber *tmdbID in tmdbIDs) {
+		TMDBSnapshotAppendUInt64(data, tmdbID.unsignedLongLongValue);
+		TMDBSnapshotAppendUInt64(data, 0);
+	}
+
+	// Strings
+	uint64_t stringOffsetsOffset = data.length;
+	NSMutableData *stringBytes = [NSMutableData data];
+	for (NSString *string in _strings) {
+		TMDBSnapshotAppendUInt32(data, (uint32_t)stringBytes.length);
+		NSData *utf8 = [string dataUsingEncoding:NSUTF8StringEncoding];
+		[stringBytes appendData:utf8];
+	}
+	TMDBSnapshotAppendUInt32(data, (uint32_t)stringBytes.length);
+
+	uint64_t stringBytesOffset = data.length;
+	[data appendData:stringBytes];
+
+	// Records
+	uint64_t recordsOffset = data.length;
+	for (NSUInteger i = 0; i < tmdbIDs.count; i++) {
+		TMDBSnapshotWriteUInt64(data, (NSUInteger)indexOffset + i * TMDBSnapshotIndexEntryLength + 8, data.length);
+		[data appendData:_records[tmdbIDs[i]]];
+	}
+
+	// Header
+	[data replaceBytesInRange:NSMakeRange(0, sizeof(TMDBSnapshotMagic)) withBytes:TMDBSnapshotMagic];
+	TMDBSnapshotWriteUInt32(data, 8, (uint32_t)TMDBMovieSnapshotVersion);
+	TMDBSnapshotWriteUInt32(data, 12, (uint32_t)tmdbIDs.count);
+	TMDBSnapshotWriteUInt32(data, 16, (uint32_t)_strings.count);
+	TMDBSnapshotWriteUInt64(data, 24, indexOffset);
+	TMDBSnapshotWriteUInt64(data, 32, stringOffsetsOffset);
+	TMDBSnapshotWriteUInt64(data, 40, stringBytesOffset);
+	TMDBSnapshotWriteUInt64(data, 48, recordsOffset);
+	TMDBSnapshotWriteUInt64(data, 56, data.length);
+
+	return data;
+}
+
+- (BOOL)writeToURL:(NSURL *)url error:(NSError **)outError {
+	return [[self snapshotData] writeToURL:url options:NSDataWritingAtomic error:outError];
+}
+
+#pragma mark - Encoding
+
+// Private
+- (uint32_t)indexOfString:(id)object {
+	NSString *string = TMDB_NSStringOrNil(object);
+	if (string == nil) {
+		return TMDBSnapshotNoString;
+	}
+
+	NSNumber *index = _stringIndexes[string];
+	if (index == nil) {
+		index = @((uint32_t)_strings.count);
+		string = [string copy];
+		[_strings addObject:string];
+		_stringIndexes[string] = index;
+	}
+
+	return index.unsignedIntValue;
+}
+
+// Private
+- (void)appendString:(id)object toData:(NSMutableData *)data {
+	TMDBSnapshotAppendUInt32(data, [self indexOfString:object]);
+}
+
+// Private
+- (NSData *)encodeMovieDictionary:(NSDictionary *)d {
+	NSMutableData *data = [NSMutableData data];
+
+	NSArray *languages = TMDB_NSArrayOrNil(d[@"spoken_languages"]);
+	NSArray *keywords = TMDB_NSArrayOrNil(TMDB_NSDictionaryOrNil(d[@"keywords"])[@"keywords"]);
+	NSDictionary *images = TMDB_NSDictionaryOrNil(d[@"images"]);
+	NSArray *posters = TMDB_NSArrayOrNil(images[@"posters"]);
+	NSArray *backdrops = TMDB_NSArrayOrNil(images[@"backdrops"]);
+	NSDictionary *casts = TMDB_NSDictionaryOrNil(d[@"casts"]);
+
+	TMDBSnapshotMovieFlags flags = 0;
+	if (TMDB_NSNumberOrNil(d[@"adult"]).boolValue) {
+		flags |= TMDBSnapshotMovieFlagAdult;
+	}
+	if (languages != nil) {
+		flags |= TMDBSnapshotMovieFlagLanguages;
+	}
+	if (keywords != nil) {
+		flags |= TMDBSnapshotMovieFlagKeywords;
+	}
+	if (posters != nil) {
+		flags |= TMDBSnapshotMovieFlagPosters;
+	}
+	if (backdrops != nil) {
+		flags |= TMDBSnapshotMovieFlagBackdrops;
+	}
+	if (casts != nil) {
+		flags |= TMDBSnapshotMovieFlagCredits;
+	}
+	if (d[@"runtime"] != nil) {
+		flags |= TMDBSnapshotMovieFlagBasic;
+	}
+
+	TMDBSnapshotAppendUInt64(data, TMDB_NSNumberOrNil(d[@"id"]).unsignedLongLongValue);
+	for (NSString *key in @[@"title", @"original_title", @"overview", @"tagline", @"imdb_id", @"url", @"homepage", @"release_date"]) {
+		[self appendString:d[key] toData:data];
+	}
+	TMDBSnapshotAppendUInt32(data, TMDB_NSNumberOrNil(d[@"runtime"]).unsignedIntValue);
+	TMDBSnapshotAppendUInt32(data, (uint32_t)TMDB_NSNumberOrNil(d[@"votes"]).intValue);
+	TMDBSnapshotAppendFloat(data, TMDB_NSNumberOrNil(d[@"rating"]).floatValue);
+	TMDBSnapshotAppendDouble(data, TMDB_NSNumberOrNil(d[@"popularity"]).doubleValue);
+	TMDBSnapshotAppendUInt32(data, flags);
+
+	if (flags & TMDBSnapshotMovieFlagLanguages) {
+		TMDBSnapshotAppendUInt32(data, (uint32_t)languages.count);
+		for (NSDictionary *language in languages) {
+			[self appendString:TMDB_NSDictionaryOrNil(language)[@"iso_639_1"] toData:data];
+			[self appendString:TMDB_NSDictionaryOrNil(language)[@"name"] toData:data];
+		}
+	}
+
+	if (flags & TMDBSnapshotMovieFlagKeywords) {
+		TMDBSnapshotAppendUInt32(data, (uint32_t)keywords.count);
+		for (NSDictionary *keyword in keywords) {
+			[self appendString:TMDB_NSDictionaryOrNil(keyword)[@"name"] toData:data];
+		}
+	}
+
+	if (flags & TMDBSnapshotMovieFlagPosters) {
+		[self appendImageDictionaries:posters toData:data];
+	}
+
+	if (flags & TMDBSnapshotMovieFlagBackdrops) {
+		[self appendImageDictionaries:backdrops toData:data];
+	}
+
+	if (flags & TMDBSnapshotMovieFlagCredits) {
+		NSArray *cast = TMDB_NSArrayOrNil(casts[@"cast"]) ?: @[];
+		NSArray *crew = TMDB_NSArrayOrNil(casts[@"crew"]) ?: @[];
+
+		TMDBSnapshotAppendUInt32(data, (uint32_t)cast.count);
+		TMDBSnapshotAppendUInt32(data, (uint32_t)crew.count);
+		for (NSDictionary *credit in [cast arrayByAddingObjectsFromArray:crew]) {
+			[self appendCreditDictionary:TMDB_NSDictionaryOrNil(credit) toData:data];
+		}
+	}
+
+	return data;
+}
+
+// Private
+- (void)appendImageDictionaries:(NSArray *)images toData:(NSMutableData *)data {
+	TMDBSnapshotAppendUInt32(data, (uint32_t)images.count);
+
+	for (id image in images) {
+		NSDictionary *d = TMDB_NSDictionaryOrNil(image);
+		[self appendString:d[@"file_path"] toData:data];
+		[self appendString:d[@"iso_639_1"] toData:data];
+		TMDBSnapshotAppendFloat(data, TMDB_NSNumberOrNil(d[@"width"]).floatValue);
+		TMDBSnapshotAppendFloat(data, TMDB_NSNumberOrNil(d[@"height"]).floatValue);
+		TMDBSnapshotAppendFloat(data, TMDB_NSNumberOrNil(d[@"vote_average"]).floatValue);
+		TMDBSnapshotAppendUInt32(data, TMDB_NSNumberOrNil(d[@"vote_count"]).unsignedIntValue);
+	}
+}
+
+// Private
+- (void)appendCreditDictionary:(NSDictionary *)d toData:(NSMutableData *)data {
+	TMDBSnapshotAppendUInt64(data, TMDB_NSNumberOrNil(d[@"id"]).unsignedLongLongValue);
+	for (NSString *key in @[@"name", @"url", @"profile_path", @"character", @"job", @"department"]) {
+		[self appendString:d[key] toData:data];
+	}
+	TMDBSnapshotAppendUInt32(data, TMDB_NSNumberOrNil(d[@"order"]).unsignedIntValue);
+	TMDBSnapshotAppendUInt32(data, (uint32_t)TMDB_NSNumberOrNil(d[@"cast_id"]).intValue);
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBMovieSnapshot {
+@private
+	NSData *_data;
+	const uint8_t *_bytes;
+
+	const uint8_t *_index;
+	const uint8_t *_stringOffsets;
+	const uint8_t *_stringBytes;
+	NSUInteger _stringCount;
+	NSUInteger _stringBytesLength;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithContentsOfURL:(NSURL *)url error:(NSError **)outError {
+	NSData *data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedAlways error:outError];
+	if (data == nil) {
+		return nil;
+	}
+
+	return (self = [self initWithData:data error:outError]);
+}
+
+- (instancetype)initWithData:(NSData *)data error:(NSError **)outError {
+	NSParameterAssert(data != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_data = data;
+	_bytes = data.bytes;
+
+	if (![self readHeader]) {
+		if (outError != nil) {
+			*outError = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidSnapshot userInfo:nil];
+		}
+		return nil;
+	}
+
+	return self;
+}
+
+// Private. Checks that every section lies within the data, so lookups only
+// need to check the records they read.
+- (BOOL)readHeader {
+	NSUInteger length = _data.length;
+	if (length < TMDBSnapshotHeaderLength || memcmp(_bytes, TMDBSnapshotMagic, sizeof(TMDBSnapshotMagic)) != 0) {
+		return NO;
+	}
+
+	TMDBSnapshotCursor cursor = {_bytes, length, sizeof(TMDBSnapshotMagic), NO};
+	_version = TMDBSnapshotReadUInt32(&cursor);
+	_count = TMDBSnapshotReadUInt32(&cursor);
+	_stringCount = TMDBSnapshotReadUInt32(&cursor);
+	TMDBSnapshotReadUInt32(&cursor);
+	uint64_t indexOffset = TMDBSnapshotReadUInt64(&cursor);
+	uint64_t stringOffsetsOffset = TMDBSnapshotReadUInt64(&cursor);
+	uint64_t stringBytesOffset = TMDBSnapshotReadUInt64(&cursor);
+	uint64_t recordsOffset = TMDBSnapshotReadUInt64(&cursor);
+	uint64_t fileLength = TMDBSnapshotReadUInt64(&cursor);
+
+	if (_version == 0 || _version > TMDBMovieSnapshotVersion || fileLength != length) {
+		return NO;
+	}
+
+	// The sections follow each other in this order
+	if (indexOffset < TMDBSnapshotHeaderLength ||
+		stringOffsetsOffset < indexOffset || (stringOffsetsOffset - indexOffset) / TMDBSnapshotIndexEntryLength != _count ||
+		stringBytesOffset < stringOffsetsOffset || (stringBytesOffset - stringOffsetsOffset) / sizeof(uint32_t) != _stringCount + 1 ||
+		recordsOffset < stringBytesOffset || recordsOffset > length) {
+		return NO;
+	}
+
+	_index = _bytes + indexOffset;
+	_stringOffsets = _bytes + stringOffsetsOffset;
+	_stringBytes = _bytes + stringBytesOffset;
+	_stringBytesLength = (NSUInteger)(recordsOffset - stringBytesOffset);
+
+	return YES;
+}
+
+#pragma mark - Reading Movies
+
+- (BOOL)containsMovieWithID:(NSUInteger)tmdbID {
+	return [self recordOffsetForID:tmdbID] != 0;
+}
+
+- (void)enumerateMovieIDsUsingBlock:(void (^)(NSUInteger, BOOL *))block {
+	NSParameterAssert(block != nil);
+
+	BOOL stop = NO;
+	for (NSUInteger i = 0; i < _count && !stop; i++) {
+		uint64_t tmdbID;
+		memcpy(&tmdbID, _index + i * TMDBSnapshotIndexEntryLength, sizeof(tmdbID));
+		block((NSUInteger)CFSwapInt64LittleToHost(tmdbID), &stop);
+	}
+}
+
+- (void)enumerateMovieTitlesUsingBlock:(void (^)(NSUInteger, NSString *, BOOL *))block {
+	NSParameterAssert(block != nil);
+
+	// The titles point into the data, which is held on to until they're done
+	NSData *data = _data;
+	BOOL stop = NO;
+
+	for (NSUInteger i = 0; i < _count && !stop; i++) {
+		uint64_t entry[2];
+		memcpy(entry, _index + i * TMDBSnapshotIndexEntryLength, sizeof(entry));
+		NSUInteger tmdbID = (NSUInteger)CFSwapInt64LittleToHost(entry[0]);
+
+		// A record starts with the movie's ID and its title
+		TMDBSnapshotCursor cursor = {_bytes, data.length, (NSUInteger)CFSwapInt64LittleToHost(entry[1]), NO};
+		TMDBSnapshotReadUInt64(&cursor);
+
+		@autoreleasepool {
+			NSString *title = [self stringWithCursor:&cursor copy:NO];
+			if (cursor.failed) {
+				TMDBLog(@"iTMDb: Snapshot record of movie %tu is damaged", tmdbID);
+				continue;
+			}
+			block(tmdbID, title, &stop);
+		}
+	}
+}
+
+- (TMDBMovie *)movieWithID:(NSUInteger)tmdbID context:(TMDB *)context {
+	uint64_t offset = [self recordOffsetForID:tmdbID];
+	if (offset == 0) {
+		return nil;
+	}
+
+	TMDBSnapshotCursor cursor = {_bytes, _data.length, (NSUInteger)offset, NO};
+	NSDictionary *d = [self decodeMovieDictionaryWithCursor:&cursor];
+	if (d == nil) {
+		TMDBLog(@"iTMDb: Snapshot record of movie %tu is damaged", tmdbID);
+		return nil;
+	}
+
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:tmdbID context:context];
+	[movie populate:d];
+
+	return movie;
+}
+
+#pragma mark - Decoding
+
+// Private. Binary search of the index in place, returning 0 if not found,
+// which is never a valid record offset.
+- (uint64_t)recordOffsetForID:(NSUInteger)tmdbID {
+	NSUInteger low = 0, high = _count;
+
+	while (low < high) {
+		NSUInteger middle = low + (high - low) / 2;
+		uint64_t entry[2];
+		memcpy(entry, _index + middle * TMDBSnapshotIndexEntryLength, sizeof(entry));
+		uint64_t entryID = CFSwapInt64LittleToHost(entry[0]);
+
+		if (entryID == tmdbID) {
+			return CFSwapInt64LittleToHost(entry[1]);
+		}
+		else if (entryID < tmdbID) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	return 0;
+}
+
+// Private. Strings are copied out of the snapshot, so movies can outlive it.
+- (NSString *)stringWithCursor:(TMDBSnapshotCursor *)cursor {
+	return [self stringWithCursor:cursor copy:YES];
+}
+
+// Private. A string that isn't copied refers to the snapshot's bytes, and
+// mustn't outlive _data.
+- (NSString *)stringWithCursor:(TMDBSnapshotCursor *)cursor copy:(BOOL)copy {
+	uint32_t index = TMDBSnapshotReadUInt32(cursor);
+	if (cursor->failed || index == TMDBSnapshotNoString) {
+		return nil;
+	}
+
+	if (index >= _stringCount) {
+		cursor->failed = YES;
+		return nil;
+	}
+
+	uint32_t bounds[2];
+	memcpy(bounds, _stringOffsets + index * sizeof(uint32_t), sizeof(bounds));
+	uint32_t start = CFSwapInt32LittleToHost(bounds[0]), end = CFSwapInt32LittleToHost(bounds[1]);
+
+	if (start > end || end > _stringBytesLength) {
+		cursor->failed = YES;
+		return nil;
+	}
+
+	if (!copy) {
+		return [[NSString alloc] initWithBytesNoCopy:(void *)(_stringBytes + start) length:end - start encoding:NSUTF8StringEncoding freeWhenDone:NO];
+	}
+	return [[NSString alloc] initWithBytes:_stringBytes + start length:end - start encoding:NSUTF8StringEncoding];
+}
+
+// Private
+- (void)setStringWithCursor:(TMDBSnapshotCursor *)cursor forKey:(NSString *)key inDictionary:(NSMutableDictionary *)d {
+	d[key] = [self stringWithCursor:cursor];
+}
+
+// Private. Returns the record in the shape of a TMDb response, or nil if it
+// runs past the end of the snapshot.
+- (NSDictionary *)decodeMovieDictionaryWithCursor:(TMDBSnapshotCursor *)cursor {
+	NSMutableDictionary *d = [NSMutableDictionary dictionary];
+
+	d[@"id"] = @(TMDBSnapshotReadUInt64(cursor));
+	for (NSString *key in @[@"title", @"original_title", @"overview", @"tagline", @"imdb_id", @"url", @"homepage", @"release_date"]) {
+		[self setStringWithCursor:cursor forKey:key inDictionary:d];
+	}
+	uint32_t runtime = TMDBSnapshotReadUInt32(cursor);
+	d[@"votes"] = @((int32_t)TMDBSnapshotReadUInt32(cursor));
+	d[@"rating"] = @(TMDBSnapshotReadFloat(cursor));
+	d[@"popularity"] = @(TMDBSnapshotReadDouble(cursor));
+
+	TMDBSnapshotMovieFlags flags = TMDBSnapshotReadUInt32(cursor);
+	d[@"adult"] = @((flags & TMDBSnapshotMovieFlagAdult) != 0);
+	if (flags & TMDBSnapshotMovieFlagBasic) {
+		d[@"runtime"] = @(runtime);
+	}
+
+	if (flags & TMDBSnapshotMovieFlagLanguages) {
+		uint32_t count = TMDBSnapshotReadCount(cursor, 2 * sizeof(uint32_t));
+		NSMutableArray *languages = [NSMutableArray arrayWithCapacity:count];
+		for (uint32_t i = 0; i < count; i++) {
+			NSMutableDictionary *language = [NSMutableDictionary dictionaryWithCapacity:2];
+			[self setStringWithCursor:cursor forKey:@"iso_639_1" inDictionary:language];
+			[self setStringWithCursor:cursor forKey:@"name" inDictionary:language];
+			[languages addObject:language];
+		}
+		d[@"spoken_languages"] = languages;
+	}
+
+	if (flags & TMDBSnapshotMovieFlagKeywords) {
+		uint32_t count = TMDBSnapshotReadCount(cursor, sizeof(uint32_t));
+		NSMutableArray *keywords = [NSMutableArray arrayWithCapacity:count];
+		for (uint32_t i = 0; i < count; i++) {
+			NSMutableDictionary *keyword = [NSMutableDictionary dictionaryWithCapacity:1];
+			[self setStringWithCursor:cursor forKey:@"name" inDictionary:keyword];
+			[keywords addObject:keyword];
+		}
+		d[@"keywords"] = @{@"keywords": keywords};
+	}
+
+	if (flags & (TMDBSnapshotMovieFlagPosters | TMDBSnapshotMovieFlagBackdrops)) {
+		NSMutableDictionary *images = [NSMutableDictionary dictionaryWithCapacity:2];
+		if (flags & TMDBSnapshotMovieFlagPosters) {
+			images[@"posters"] = [self decodeImagesWithCursor:cursor];
+		}
+		if (flags & TMDBSnapshotMovieFlagBackdrops) {
+			images[@"backdrops"] = [self decodeImagesWithCursor:cursor];
+		}
+		d[@"images"] = images;
+	}
+
+	if (flags & TMDBSnapshotMovieFlagCredits) {
+		// A credit is a person ID, six strings, the order and the cast ID
+		const NSUInteger creditLength = sizeof(uint64_t) + 8 * sizeof(uint32_t);
+		uint32_t castCount = TMDBSnapshotReadCount(cursor, creditLength);
+		uint32_t crewCount = TMDBSnapshotReadCount(cursor, creditLength);
+		NSMutableArray *cast = [NSMutableArray arrayWithCapacity:castCount];
+		NSMutableArray *crew = [NSMutableArray arrayWithCapacity:crewCount];
+
+		for (uint32_t i = 0; i < castCount && !cursor->failed; i++) {
+			[cast addObject:[self decodeCreditWithCursor:cursor]];
+		}
+		for (uint32_t i = 0; i < crewCount && !cursor->failed; i++) {
+			[crew addObject:[self decodeCreditWithCursor:cursor]];
+		}
+		d[@"casts"] = @{@"cast": cast, @"crew": crew};
+	}
+
+	return cursor->failed ? nil : d;
+}
+
+// Private
+- (NSArray *)decodeImagesWithCursor:(TMDBSnapshotCursor *)cursor {
+	uint32_t count = TMDBSnapshotReadCount(cursor, 6 * sizeof(uint32_t));
+	NSMutableArray *images = [NSMutableArray arrayWithCapacity:count];
+
+	for (uint32_t i = 0; i < count; i++) {
+		NSMutableDictionary *image = [NSMutableDictionary dictionaryWithCapacity:6];
+		[self setStringWithCursor:cursor forKey:@"file_path" inDictionary:image];
+		[self setStringWithCursor:cursor forKey:@"iso_639_1" inDictionary:image];
+		image[@"width"] = @(TMDBSnapshotReadFloat(cursor));
+		image[@"height"] = @(TMDBSnapshotReadFloat(cursor));
+		image[@"vote_average"] = @(TMDBSnapshotReadFloat(cursor));
+		image[@"vote_count"] = @(TMDBSnapshotReadUInt32(cursor));
+		[images addObject:image];
+	}
+
+	return images;
+}
+
+// Private
+- (NSDictionary *)decodeCreditWithCursor:(TMDBSnapshotCursor *)cursor {
+	NSMutableDictionary *credit = [NSMutableDictionary dictionaryWithCapacity:9];
+
+	uint64_t personID = TMDBSnapshotReadUInt64(cursor);
+	if (personID > 0) {
+		credit[@"id"] = @(personID);
+	}
+	for (NSString *key in @[@"name", @"url", @"profile_path", @"character", @"job", @"department"]) {
+		[self setStringWithCursor:cursor forKey:key inDictionary:credit];
+	}
+	credit[@"order"] = @(TMDBSnapshotReadUInt32(cursor));
+	credit[@"cast_id"] = @((int32_t)TMDBSnapshotReadUInt32(cursor));
+
+	return credit;
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  TMDBMovieSync.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBMovie.h"
+
+/**
+ * Called when a sync has finished.
+ *
+ * @param updatedMovies The movies loaded again because they had changed.
+ * @param error The first error the sync ran into, if any. Movies updated
+ * before the error are still passed in `updatedMovies`.
+ */
+typedef void (^TMDBMovieSyncCompletionBlock)(NSArray<TMDBMovie *> * _Nonnull updatedMovies, NSError * _Nullable error);
+
+/**
+ * A `TMDBMovieSync` keeps a set of movies up to date using the TMDb changes
+ * feed, rather than loading all of them again.
+ *
+ * A sync reads the IDs of every movie changed since `highWaterMark`, page by
+ * page, and loads only the tracked movies among them. Movies are loaded again
+ * in place, so objects already holding on to them see the new information.
+ * Once every changed movie has been loaded, `highWaterMark` is moved to the
+ * time the sync started.
+ *
+ * The number of requests a sync makes depends on the number of changes, and
+ * not on the number of tracked movies.
+ */
+@interface TMDBMovieSync : NSObject
+
+/**
+ * Creates a sync reading the changes feed through `context`. Pass `nil` to
+ * use the shared instance. Tracked movies are loaded through their own
+ * context.
+ */
+- (nonnull instancetype)initWithContext:(nullable TMDB *)context NS_DESIGNATED_INITIALIZER;
+
+/** The context the changes feed is read through. */
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
+
+/**
+ * The information changed movies are loaded with. Default
+ * `TMDBMovieFetchOptionAll`.
+ */
+@property (atomic) TMDBMovieFetchOptions options;
+
+/**
+ * The time up to which changes have been synced. Store it between launches
+ * to pick up where the last sync left off. If `nil`, a sync reads the changes
+ * of the last 14 days.
+ *
+ * TMDb lists changes by day, so a sync reads the changes of the day of the
+ * high-water mark again.
+ */
+@property (atomic, copy, nullable) NSDate *highWaterMark;
+
+/** @name Tracking Movies */
+
+/**
+ * Adds a movie to be kept up to date. Movies are held weakly, and stop being
+ * tracked once they are deallocated. A movie with the same TMDb ID added
+ * earlier is replaced.
+ */
+- (void)addMovie:(nonnull TMDBMovie *)movie;
+
+- (void)removeMovie:(nonnull TMDBMovie *)movie;
+
+/** The number of movies being tracked. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** @name Syncing */
+
+/**
+ * Reads the changes since `highWaterMark` and loads the tracked movies that
+ * changed. If a sync is already in progress, the completion block is called
+ * when that sync has finished instead.
+ *
+ * @param completionQueue The queue on which to call the completion block.
+ * Pass `nil` to use the `completionQueue` of `context`.
+ */
+- (void)syncWithCompletionQueue:(nullable dispatch_queue_t)completionQueue completion:(nullable TMDBMovieSyncCompletionBlock)completionBlock;
+
+/**
+ * Cancels the sync in progress, if any. Its completion blocks are called with
+ * an `NSURLErrorCancelled` error, and `highWaterMark` is left as it was.
+ */
+- (void)cancel;
+
+/** A Boolean value indicating if a sync is in progress. */
+@property (nonatomic, readonly, getter=isSyncing) BOOL syncing;
+
+@end
@@ -0,0 +1,307 @@
+//
+//  TMDBMovieSync.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMovieSync.h"
+#import "TMDBMovie+Private.h"
+#import "TMDBMovieSearch.h"
+#import "TMDB+Private.h"
+#import "TMDBRequest.h"
+#import "TMDBResponseCache.h"
+#import "TMDBError.h"
+
+// The longest window of days the changes feed accepts
+static const NSTimeInterval TMDBMovieSyncMaximumWindow = 14.0 * 24.0 * 60.0 * 60.0;
+
+@implementation TMDBMovieSync {
+@private
+	NSMapTable<NSNumber *, TMDBMovie *> *_movies;
+
+	// The blocks waiting for the sync in progress, or nil if there is none.
+	// All guarded by self.
+	NSMutableArray<TMDBMovieSyncCompletionBlock> *_completionBlocks;
+	NSMutableArray<TMDBRequestSubscription *> *_subscriptions;
+
+	// Counts syncs, so requests of a cancelled sync that finish late are
+	// ignored by the next one.
+	NSUInteger _generation;
+}
+
+- (instancetype)init {
+	return (self = [self initWithContext:nil]);
+}
+
+- (instancetype)initWithContext:(TMDB *)context {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_context = context ?: [TMDB sharedInstance];
+	_options = TMDBMovieFetchOptionAll;
+	_movies = [NSMapTable strongToWeakObjectsMapTable];
+	_subscriptions = [NSMutableArray array];
+
+	return self;
+}
+
+#pragma mark - Tracking Movies
+
+- (void)addMovie:(TMDBMovie *)movie {
+	NSParameterAssert(movie != nil);
+
+	@synchronized(self) {
+		[_movies setObject:movie forKey:@(movie.tmdbID)];
+	}
+}
+
+- (void)removeMovie:(TMDBMovie *)movie {
+	NSParameterAssert(movie != nil);
+
+	@synchronized(self) {
+		if ([_movies objectForKey:@(movie.tmdbID)] == movie) {
+			[_movies removeObjectForKey:@(movie.tmdbID)];
+		}
+	}
+}
+
+- (NSUInteger)count {
+	// The map table's count includes movies that have been deallocated
+	@synchronized(self) {
+		NSUInteger count = 0;
+		for (NSNumber *tmdbID in _movies) {
+			if ([_movies objectForKey:tmdbID] != nil) {
+				count++;
+			}
+		}
+		return count;
+	}
+}
+
+#pragma mark - Syncing
+
+- (BOOL)isSyncing {
+	@synchronized(self) {
+		return _completionBlocks != nil;
+	}
+}
+
+- (void)syncWithCompletionQueue:(dispatch_queue_t)completionQueue completion:(TMDBMovieSyncCompletionBlock)completionBlock {
+	dispatch_queue_t queue = completionQueue ?: _context.completionQueue;
+	TMDBMovieSyncCompletionBlock block = ^(NSArray<TMDBMovie *> *updatedMovies, NSError *error) {
+		if (completionBlock != nil) {
+			dispatch_async(queue, ^{
+				completionBlock(updatedMovies, error);
+			});
+		}
+	};
+
+	BOOL inProgress;
+	NSUInteger generation;
+	@synchronized(self) {
+		inProgress = _completionBlocks != nil;
+		if (!inProgress) {
+			_completionBlocks = [NSMutableArray array];
+			_generation++;
+		}
+		[_completionBlocks addObject:block];
+		generation = _generation;
+	}
+
+	if (inProgress) {
+		return;
+	}
+
+	NSDate *endDate = [NSDate date];
+	NSDate *startDate = self.highWaterMark ?: [endDate dateByAddingTimeInterval:-TMDBMovieSyncMaximumWindow];
+
+	[self fetchChangesFromDate:startDate untilDate:endDate page:1 changedIDs:[NSMutableSet set] generation:generation];
+}
+
+- (void)cancel {
+	NSArray<TMDBRequestSubscription *> *subscriptions;
+	NSUInteger generation;
+	@synchronized(self) {
+		subscriptions = [_subscriptions copy];
+		generation = _generation;
+	}
+
+	NSError *cancelled = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+	if (![self finishSync:generation highWaterMark:nil updatedMovies:@[] error:cancelled]) {
+		return;
+	}
+
+	for (TMDBRequestSubscription *subscription in subscriptions) {
+		[subscription cancel];
+	}
+}
+
+// Private. Reads the changes one window of up to 14 days at a time, since
+// that's all the feed accepts, and every page of each window in turn.
+- (void)fetchChangesFromDate:(NSDate *)startDate untilDate:(NSDate *)endDate page:(NSUInteger)page changedIDs:(NSMutableSet<NSNumber *> *)changedIDs generation:(NSUInteger)generation {
+	NSDate *windowEndDate = [startDate dateByAddingTimeInterval:TMDBMovieSyncMaximumWindow];
+	if ([windowEndDate compare:endDate] == NSOrderedDescending) {
+		windowEndDate = endDate;
+	}
+
+	NSURL *url = [TMDBMovieSearch changesURLWithStartDate:startDate endDate:windowEndDate page:page context:_context];
+	if (url == nil) {
+		NSError *error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidURL userInfo:nil];
+		[self finishSync:generation highWaterMark:nil updatedMovies:@[] error:error];
+		return;
+	}
+
+	// The sync keeps itself alive until it has finished
+	TMDBRequestSubscription *subscription = [TMDBRequest requestWithURL:url context:_context completionBlock:^(id parsedData, NSError *error) {
+		if (![self isSyncInProgress:generation]) {
+			return;
+		}
+
+		NSDictionary *d = TMDB_NSDictionaryOrNil(parsedData);
+		NSArray *results = TMDB_NSArrayOrNil(d[@"results"]);
+		if (error == nil && results == nil) {
+			error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeReceivedInvalidData userInfo:nil];
+		}
+
+		if (error != nil) {
+			[self finishSync:generation highWaterMark:nil updatedMovies:@[] error:error];
+			return;
+		}
+
+		for (id result in results) {
+			NSNumber *tmdbID = TMDB_NSNumberOrNil(TMDB_NSDictionaryOrNil(result)[@"id"]);
+			if (tmdbID != nil) {
+				[changedIDs addObject:tmdbID];
+			}
+		}
+
+		NSUInteger totalPages = TMDB_NSNumberOrNil(d[@"total_pages"]).unsignedIntegerValue;
+		if (page < totalPages) {
+			[self fetchChangesFromDate:startDate untilDate:endDate page:page + 1 changedIDs:changedIDs generation:generation];
+		}
+		else if ([windowEndDate compare:endDate] == NSOrderedAscending) {
+			[self fetchChangesFromDate:windowEndDate untilDate:endDate page:1 changedIDs:changedIDs generation:generation];
+		}
+		else {
+			[self loadMoviesWithIDs:changedIDs highWaterMark:endDate generation:generation];
+		}
+	}];
+
+	[self addSubscription:subscription generation:generation];
+}
+
+// Private. Loads the tracked movies among `changedIDs` all at once, leaving
+// it to the rate limiter to pace them.
+- (void)loadMoviesWithIDs:(NSSet<NSNumber *> *)changedIDs highWaterMark:(NSDate *)highWaterMark generation:(NSUInteger)generation {
+	NSMutableArray<TMDBMovie *> *movies = [NSMutableArray array];
+	@synchronized(self) {
+		for (NSNumber *tmdbID in changedIDs) {
+			TMDBMovie *movie = [_movies objectForKey:tmdbID];
+			if (movie != nil) {
+				[movies addObject:movie];
+			}
+		}
+	}
+
+	TMDBLog(@"iTMDb: %tu movies changed, %tu of them tracked", changedIDs.count, movies.count);
+
+	if (movies.count == 0) {
+		[self finishSync:generation highWaterMark:highWaterMark updatedMovies:@[] error:nil];
+		return;
+	}
+
+	TMDBMovieFetchOptions options = self.options;
+	dispatch_queue_t workQueue = [TMDBRequest workQueue];
+
+	// Guarded by updatedMovies
+	NSMutableArray<TMDBMovie *> *updatedMovies = [NSMutableArray arrayWithCapacity:movies.count];
+	__block NSUInteger remaining = movies.count;
+	__block NSError *firstError = nil;
+
+	for (TMDBMovie *movie in movies) {
+		// A response still fresh in the cache would hide the change, so it
+		// is revalidated with the server instead.
+		NSURL *url = [TMDBMovieSearch fetchURLWithMovieID:movie.tmdbID options:options context:movie.context];
+		if (url != nil) {
+			[movie.context.responseCache expireResponseForURL:url];
+		}
+
+		// Reloading, as the movie may already hold everything in `options`
+		TMDBRequestSubscription *subscription = [movie subscribeToLoad:options reloading:YES completionQueue:workQueue completion:^(NSError *error) {
+			BOOL finished;
+			@synchronized(updatedMovies) {
+				if (error == nil) {
+					[updatedMovies addObject:movie];
+				}
+				else if (firstError == nil) {
+					firstError = error;
+				}
+				finished = --remaining == 0;
+			}
+
+			if (finished) {
+				[self finishSync:generation highWaterMark:firstError == nil ? highWaterMark : nil updatedMovies:updatedMovies error:firstError];
+			}
+		}];
+
+		[self addSubscription:subscription generation:generation];
+	}
+}
+
+// Private
+- (BOOL)isSyncInProgress:(NSUInteger)generation {
+	@synchronized(self) {
+		return _completionBlocks != nil && _generation == generation;
+	}
+}
+
+// Private
+- (void)addSubscription:(TMDBRequestSubscription *)subscription generation:(NSUInteger)generation {
+	if (subscription == nil) {
+		return;
+	}
+
+	@synchronized(self) {
+		if (_completionBlocks != nil && _generation == generation) {
+			[_subscriptions addObject:subscription];
+			return;
+		}
+	}
+
+	// Cancelled while the request was being made
+	[subscription cancel];
+}
+
+// Private. Calls the completion blocks of the sync, and returns NO if it has
+// already finished or been cancelled.
+- (BOOL)finishSync:(NSUInteger)generation highWaterMark:(NSDate *)highWaterMark updatedMovies:(NSArray<TMDBMovie *> *)updatedMovies error:(NSError *)error {
+	NSArray<TMDBMovieSyncCompletionBlock> *completionBlocks;
+	@synchronized(self) {
+		if (_generation != generation) {
+			return NO;
+		}
+		completionBlocks = _completionBlocks;
+		_completionBlocks = nil;
+		[_subscriptions removeAllObjects];
+	}
+
+	if (completionBlocks == nil) {
+		return NO;
+	}
+
+	if (highWaterMark != nil) {
+		self.highWaterMark = highWaterMark;
+	}
+
+	NSArray<TMDBMovie *> *movies = [updatedMovies copy];
+	for (TMDBMovieSyncCompletionBlock block in completionBlocks) {
+		block(movies, error);
+	}
+
+	return YES;
+}
+
+@end
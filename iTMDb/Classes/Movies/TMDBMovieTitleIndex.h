@@ -0,0 +1,90 @@
+//
+//  TMDBMovieTitleIndex.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBMovie.h"
+
+/**
+ * How `TMDBMovieSearch` uses the title index of the context it searches
+ * through.
+ */
+typedef NS_ENUM(NSUInteger, TMDBMovieTitleIndexSearchPolicy) {
+	/** Searches TMDb only if the index has no matches. */
+	TMDBMovieTitleIndexSearchPolicyFallback = 0,
+	/**
+	 * Answers from the index if it has matches, and searches TMDb in the
+	 * background anyway, so the index picks up new and changed titles for the
+	 * next search.
+	 */
+	TMDBMovieTitleIndexSearchPolicyRefresh
+};
+
+/**
+ * A `TMDBMovieTitleIndex` is an in-memory index of the titles of movies
+ * already loaded, so searches can be answered without asking TMDb.
+ *
+ * Assign an index to a context's `titleIndex` to have every movie populated
+ * through the context added to it, including search results, and to have
+ * `TMDBMovieSearch` search it first.
+ *
+ * Titles and original titles are matched ignoring case, diacritics and
+ * punctuation. A query matches a title if it's found at the start of one of
+ * its words, so `"star wa"` matches *Rogue One: A Star Wars Story*. Matches are
+ * ordered with exact titles first, then titles starting with the query, then
+ * by popularity.
+ *
+ * The index keeps the title, original title, release date and popularity of
+ * each movie, not the movies themselves, and is safe to use from any thread.
+ */
+@interface TMDBMovieTitleIndex : NSObject
+
+/** How searches use the index. Default `TMDBMovieTitleIndexSearchPolicyFallback`. */
+@property (atomic) TMDBMovieTitleIndexSearchPolicy searchPolicy;
+
+/** The largest number of movies returned by a search. Default `20`, which is the size of a page of TMDb search results. */
+@property (atomic) NSUInteger searchLimit;
+
+/** @name Adding Movies */
+
+/**
+ * Adds the title of a movie, replacing what was added earlier for the same
+ * TMDb ID. Movies without a TMDb ID or a title are ignored.
+ */
+- (void)addMovie:(nonnull TMDBMovie *)movie;
+
+- (void)removeMovieWithID:(NSUInteger)tmdbID;
+
+- (void)removeAllMovies;
+
+/** The number of movies in the index. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** @name Searching */
+
+/**
+ * Returns the TMDb IDs of the movies matching `title`, best match first.
+ *
+ * @param year The year of release to match, or `0` for any year.
+ * @param limit The largest number of IDs to return.
+ */
+- (nonnull NSArray<NSNumber *> *)movieIDsMatchingTitle:(nonnull NSString *)title year:(NSUInteger)year limit:(NSUInteger)limit;
+
+/**
+ * Returns new movie objects for the movies matching `title`, best match first
+ * and no more than `searchLimit`. Like TMDb search results, they are only
+ * populated with their ID, title, original title, release date and
+ * popularity.
+ *
+ * @param year The year of release to match, or `0` for any year.
+ * @param context The context the movies are loaded through. Pass `nil` to use
+ * the shared instance.
+ */
+- (nonnull NSArray<TMDBMovie *> *)moviesMatchingTitle:(nonnull NSString *)title year:(NSUInteger)year context:(nullable TMDB *)context;
+
+@end
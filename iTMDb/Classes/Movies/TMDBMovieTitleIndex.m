@@ -0,0 +1,421 @@
+//
+//  TMDBMovieTitleIndex.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMovieTitleIndex.h"
+#import "TMDBMovie+Private.h"
+#import "TMDB.h"
+
+// Titles are indexed by every run of three characters of their normalized
+// form, and by the first two characters of every word, so queries of any
+// length can be narrowed down to a few candidates before they are compared.
+// A gram packs its characters into the low 48 bits of a key, with the third
+// character of a two-character gram set to a character that never occurs in
+// a normalized title.
+static const unichar TMDBTitleIndexNoCharacter = 0xFFFF;
+
+// Separates the normalized title from the normalized original title, so no
+// gram or query spans both.
+static const unichar TMDBTitleIndexSeparator = '|';
+
+// The number of replaced and removed entries below which they're never
+// compacted away, so small indexes aren't rebuilt over and over.
+static const NSUInteger TMDBTitleIndexMinimumCompactionCount = 1024;
+
+// Lowercases the string, strips diacritics and turns every run of other
+// characters than letters and digits into a single space. The result starts
+// with a space, so matching a query with a leading space only finds it at the
+// start of a word.
+static NSString *TMDBTitleIndexNormalizedString(NSString *string) {
+	NSString *folded = [string stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSWidthInsensitiveSearch locale:nil];
+	NSUInteger length = folded.length;
+
+	unichar *characters = malloc(length * sizeof(unichar));
+	unichar *normalized = malloc((length + 1) * sizeof(unichar));
+	[folded getCharacters:characters range:NSMakeRange(0, length)];
+
+	NSCharacterSet *alphanumerics = [NSCharacterSet alphanumericCharacterSet];
+	NSUInteger normalizedLength = 0;
+	normalized[normalizedLength++] = ' ';
+
+	for (NSUInteger i = 0; i < length; i++) {
+		if ([alphanumerics characterIsMember:characters[i]]) {
+			normalized[normalizedLength++] = characters[i];
+		}
+		else if (normalized[normalizedLength - 1] != ' ') {
+			normalized[normalizedLength++] = ' ';
+		}
+	}
+
+	if (normalizedLength > 1 && normalized[normalizedLength - 1] == ' ') {
+		normalizedLength--;
+	}
+
+	free(characters);
+
+	return [[NSString alloc] initWithCharactersNoCopy:normalized length:normalizedLength freeWhenDone:YES];
+}
+
+static inline uint64_t TMDBTitleIndexGram(unichar c0, unichar c1, unichar c2) {
+	return ((uint64_t)c0 << 32) | ((uint64_t)c1 << 16) | (uint64_t)c2;
+}
+
+// Calls `block` with every gram of `key`, possibly more than once
+static void TMDBTitleIndexEnumerateGrams(NSString *key, void (^block)(uint64_t gram)) {
+	NSUInteger length = key.length;
+	unichar *c = malloc(length * sizeof(unichar));
+	[key getCharacters:c range:NSMakeRange(0, length)];
+
+	for (NSUInteger i = 0; i + 1 < length; i++) {
+		if (c[i] == ' ' && c[i + 1] != ' ' && c[i + 1] != TMDBTitleIndexSeparator) {
+			block(TMDBTitleIndexGram(c[i], c[i + 1], TMDBTitleIndexNoCharacter));
+		}
+
+		if (i + 2 < length && c[i] != TMDBTitleIndexSeparator && c[i + 1] != TMDBTitleIndexSeparator && c[i + 2] != TMDBTitleIndexSeparator) {
+			block(TMDBTitleIndexGram(c[i], c[i + 1], c[i + 2]));
+		}
+	}
+
+	free(c);
+}
+
+static BOOL TMDBTitleIndexPostingsContain(NSData *postings, uint32_t entryIndex) {
+	const uint32_t *indexes = postings.bytes;
+	NSUInteger low = 0, high = postings.length / sizeof(uint32_t);
+
+	while (low < high) {
+		NSUInteger middle = low + (high - low) / 2;
+		if (indexes[middle] == entryIndex) {
+			return YES;
+		}
+		else if (indexes[middle] < entryIndex) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	return NO;
+}
+
+// How well a title matches a query, best first
+typedef NS_ENUM(NSUInteger, TMDBTitleIndexMatch) {
+	TMDBTitleIndexMatchExact,
+	TMDBTitleIndexMatchPrefix,
+	TMDBTitleIndexMatchWord
+};
+
+typedef struct TMDBTitleIndexCandidate {
+	uint32_t entryIndex;
+	TMDBTitleIndexMatch match;
+	double popularity;
+	NSUInteger tmdbID;
+} TMDBTitleIndexCandidate;
+
+static int TMDBTitleIndexCompareCandidates(const void *a, const void *b) {
+	const TMDBTitleIndexCandidate *c1 = a, *c2 = b;
+
+	if (c1->match != c2->match) {
+		return c1->match < c2->match ? -1 : 1;
+	}
+	if (c1->popularity != c2->popularity) {
+		return c1->popularity > c2->popularity ? -1 : 1;
+	}
+	if (c1->tmdbID != c2->tmdbID) {
+		return c1->tmdbID < c2->tmdbID ? -1 : 1;
+	}
+	return 0;
+}
+
+#pragma mark -
+
+// Private class
+@interface TMDBMovieTitleIndexEntry : NSObject
+
+@property (nonatomic) NSUInteger tmdbID;
+@property (nonatomic) NSUInteger year;
+@property (nonatomic) double popularity;
+@property (nonatomic, copy) NSString *title;
+@property (nonatomic, copy) NSString *originalTitle;
+@property (nonatomic, copy) NSString *releaseDate;
+
+// The normalized title, followed by the separator and the normalized original
+// title if it differs.
+@property (nonatomic, copy) NSString *key;
+
+@end
+
+@implementation TMDBMovieTitleIndexEntry
+@end
+
+#pragma mark -
+
+@implementation TMDBMovieTitleIndex {
+@private
+	// Entries are only ever appended, so the postings of every gram stay
+	// sorted. Replaced and removed entries are left as NSNull, and remain in
+	// the postings, until they outnumber the others and the index is compacted.
+	NSMutableArray *_entries;
+	NSMutableDictionary<NSNumber *, NSNumber *> *_entryIndexes;
+	NSMutableDictionary<NSNumber *, NSMutableData *> *_postings;
+	NSUInteger _removedCount;
+}
+
+- (instancetype)init {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_searchLimit = 20;
+
+	_entries = [NSMutableArray array];
+	_entryIndexes = [NSMutableDictionary dictionary];
+	_postings = [NSMutableDictionary dictionary];
+
+	return self;
+}
+
+- (NSUInteger)count {
+	@synchronized(self) {
+		return _entryIndexes.count;
+	}
+}
+
+#pragma mark - Adding Movies
+
+- (void)addMovie:(TMDBMovie *)movie {
+	NSParameterAssert(movie != nil);
+
+	if (movie.tmdbID <= 0 || movie.title.length == 0) {
+		return;
+	}
+
+	TMDBMovieTitleIndexEntry *entry = [[TMDBMovieTitleIndexEntry alloc] init];
+	entry.tmdbID = (NSUInteger)movie.tmdbID;
+	entry.year = movie.year;
+	entry.popularity = [movie popularity];
+	entry.title = movie.title;
+	entry.originalTitle = movie.originalTitle;
+	entry.releaseDate = [movie releaseDateString];
+
+	NSString *key = TMDBTitleIndexNormalizedString(entry.title);
+	if (entry.originalTitle.length > 0) {
+		NSString *originalKey = TMDBTitleIndexNormalizedString(entry.originalTitle);
+		if (![originalKey isEqualToString:key]) {
+			key = [NSString stringWithFormat:@"%@%C%@", key, TMDBTitleIndexSeparator, originalKey];
+		}
+	}
+	entry.key = key;
+
+	@synchronized(self) {
+		NSNumber *existingIndex = _entryIndexes[@(entry.tmdbID)];
+
+		// Movies are populated again and again with the same title, so an
+		// unchanged title only updates what isn't indexed.
+		if (existingIndex != nil) {
+			TMDBMovieTitleIndexEntry *existingEntry = _entries[existingIndex.unsignedIntegerValue];
+			if ([existingEntry.key isEqualToString:key]) {
+				_entries[existingIndex.unsignedIntegerValue] = entry;
+				return;
+			}
+			_entries[existingIndex.unsignedIntegerValue] = [NSNull null];
+			_removedCount++;
+		}
+
+		[self appendEntry:entry];
+		[self compactIfNeeded];
+	}
+}
+
+- (void)removeMovieWithID:(NSUInteger)tmdbID {
+	@synchronized(self) {
+		NSNumber *entryIndex = _entryIndexes[@(tmdbID)];
+		if (entryIndex != nil) {
+			_entries[entryIndex.unsignedIntegerValue] = [NSNull null];
+			[_entryIndexes removeObjectForKey:@(tmdbID)];
+			_removedCount++;
+			[self compactIfNeeded];
+		}
+	}
+}
+
+- (void)removeAllMovies {
+	@synchronized(self) {
+		[_entries removeAllObjects];
+		[_entryIndexes removeAllObjects];
+		[_postings removeAllObjects];
+		_removedCount = 0;
+	}
+}
+
+// Private. Must be called while synchronized.
+- (void)appendEntry:(TMDBMovieTitleIndexEntry *)entry {
+	uint32_t entryIndex = (uint32_t)_entries.count;
+	[_entries addObject:entry];
+	_entryIndexes[@(entry.tmdbID)] = @(entryIndex);
+
+	TMDBTitleIndexEnumerateGrams(entry.key, ^(uint64_t gram) {
+		NSMutableData *postings = _postings[@(gram)];
+		if (postings == nil) {
+			postings = [NSMutableData data];
+			_postings[@(gram)] = postings;
+		}
+
+		// A gram may occur more than once in the same title
+		const uint32_t *indexes = postings.bytes;
+		NSUInteger count = postings.length / sizeof(uint32_t);
+		if (count == 0 || indexes[count - 1] != entryIndex) {
+			[postings appendBytes:&entryIndex length:sizeof(entryIndex)];
+		}
+	});
+}
+
+// Private. Rebuilds the entries and postings without the replaced and removed
+// entries once they outnumber the others, so an index whose titles keep
+// changing doesn't grow without bound. A rebuild costs about as much as adding
+// the remaining movies again, which is spread over the removals that led to
+// it. Must be called while synchronized.
+- (void)compactIfNeeded {
+	if (_removedCount < TMDBTitleIndexMinimumCompactionCount || _removedCount < _entryIndexes.count) {
+		return;
+	}
+
+	NSArray *entries = [_entries copy];
+	[_entries removeAllObjects];
+	[_entryIndexes removeAllObjects];
+	[_postings removeAllObjects];
+	_removedCount = 0;
+
+	for (id entry in entries) {
+		if (entry != (id)[NSNull null]) {
+			[self appendEntry:entry];
+		}
+	}
+}
+
+#pragma mark - Searching
+
+- (NSArray<NSNumber *> *)movieIDsMatchingTitle:(NSString *)title year:(NSUInteger)year limit:(NSUInteger)limit {
+	NSArray<TMDBMovieTitleIndexEntry *> *entries = [self entriesMatchingTitle:title year:year limit:limit];
+	return [entries valueForKey:@"tmdbID"];
+}
+
+- (NSArray<TMDBMovie *> *)moviesMatchingTitle:(NSString *)title year:(NSUInteger)year context:(TMDB *)context {
+	NSArray<TMDBMovieTitleIndexEntry *> *entries = [self entriesMatchingTitle:title year:year limit:self.searchLimit];
+	NSMutableArray<TMDBMovie *> *movies = [NSMutableArray arrayWithCapacity:entries.count];
+
+	for (TMDBMovieTitleIndexEntry *entry in entries) {
+		NSMutableDictionary *d = [NSMutableDictionary dictionaryWithCapacity:5];
+		d[@"id"] = @(entry.tmdbID);
+		d[@"title"] = entry.title;
+		d[@"original_title"] = entry.originalTitle;
+		d[@"release_date"] = entry.releaseDate;
+		d[@"popularity"] = @(entry.popularity);
+
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:entry.tmdbID context:context];
+		[movie populate:d];
+		[movies addObject:movie];
+	}
+
+	return movies;
+}
+
+// Private
+- (NSArray<TMDBMovieTitleIndexEntry *> *)entriesMatchingTitle:(NSString *)title year:(NSUInteger)year limit:(NSUInteger)limit {
+	NSString *query = TMDBTitleIndexNormalizedString(title);
+	if (query.length < 2 || limit == 0) {
+		return @[];
+	}
+
+	NSMutableSet<NSNumber *> *grams = [NSMutableSet set];
+	if (query.length == 2) {
+		[grams addObject:@(TMDBTitleIndexGram([query characterAtIndex:0], [query characterAtIndex:1], TMDBTitleIndexNoCharacter))];
+	}
+	else {
+		TMDBTitleIndexEnumerateGrams(query, ^(uint64_t gram) {
+			if ((gram & 0xFFFF) != TMDBTitleIndexNoCharacter) {
+				[grams addObject:@(gram)];
+			}
+		});
+	}
+
+	// The query as the whole title, and at the start of the original title
+	NSString *titleQuery = [query stringByAppendingFormat:@"%C", TMDBTitleIndexSeparator];
+	NSString *originalTitleQuery = [NSString stringWithFormat:@"%C%@", TMDBTitleIndexSeparator, query];
+
+	@synchronized(self) {
+		// Candidates are the entries in every posting list, found by
+		// walking the shortest one and looking them up in the others.
+		NSMutableArray<NSData *> *postingLists = [NSMutableArray arrayWithCapacity:grams.count];
+		for (NSNumber *gram in grams) {
+			NSData *postings = _postings[gram];
+			if (postings == nil) {
+				return @[];
+			}
+			[postingLists addObject:postings];
+		}
+		[postingLists sortUsingComparator:^NSComparisonResult(NSData *postings1, NSData *postings2) {
+			return postings1.length < postings2.length ? NSOrderedAscending : (postings1.length > postings2.length ? NSOrderedDescending : NSOrderedSame);
+		}];
+
+		NSData *shortest = postingLists.firstObject;
+		const uint32_t *indexes = shortest.bytes;
+		NSUInteger count = shortest.length / sizeof(uint32_t);
+
+		TMDBTitleIndexCandidate *candidates = malloc(MAX(count, 1) * sizeof(TMDBTitleIndexCandidate));
+		NSUInteger candidateCount = 0;
+
+		for (NSUInteger i = 0; i < count; i++) {
+			uint32_t entryIndex = indexes[i];
+
+			BOOL inAll = YES;
+			for (NSUInteger list = 1; list < postingLists.count && inAll; list++) {
+				inAll = TMDBTitleIndexPostingsContain(postingLists[list], entryIndex);
+			}
+			if (!inAll) {
+				continue;
+			}
+
+			TMDBMovieTitleIndexEntry *entry = _entries[entryIndex];
+			if (entry == (id)[NSNull null] || (year != 0 && entry.year != year)) {
+				continue;
+			}
+
+			// Grams may all occur without occurring in that order
+			NSString *key = entry.key;
+			NSRange range = [key rangeOfString:query options:NSLiteralSearch];
+			if (range.location == NSNotFound) {
+				continue;
+			}
+
+			TMDBTitleIndexMatch match = TMDBTitleIndexMatchWord;
+			if ([key isEqualToString:query] || [key hasPrefix:titleQuery] || [key hasSuffix:originalTitleQuery]) {
+				match = TMDBTitleIndexMatchExact;
+			}
+			else if (range.location == 0 || [key rangeOfString:originalTitleQuery options:NSLiteralSearch].location != NSNotFound) {
+				match = TMDBTitleIndexMatchPrefix;
+			}
+
+			candidates[candidateCount++] = (TMDBTitleIndexCandidate){entryIndex, match, entry.popularity, entry.tmdbID};
+		}
+
+		qsort(candidates, candidateCount, sizeof(TMDBTitleIndexCandidate), TMDBTitleIndexCompareCandidates);
+
+		NSUInteger resultCount = MIN(candidateCount, limit);
+		NSMutableArray<TMDBMovieTitleIndexEntry *> *entries = [NSMutableArray arrayWithCapacity:resultCount];
+		for (NSUInteger i = 0; i < resultCount; i++) {
+			[entries addObject:_entries[candidates[i].entryIndex]];
+		}
+
+		free(candidates);
+
+		return entries;
+	}
+}
+
+@end
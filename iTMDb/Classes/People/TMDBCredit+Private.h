@@ -0,0 +1,25 @@
+//
+//  TMDBCredit+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBCredit.h"
+
+// Private methods shared with the other model classes
+@interface TMDBCredit (Private)
+
+/**
+ * Returns a credit kept by `person` itself, such as one in its filmography.
+ * It holds `movie` strongly and the person weakly, the other way around from
+ * the credits of a movie, so the person and its credits don't retain each
+ * other.
+ */
+- (nonnull instancetype)initWithMovie:(nonnull TMDBMovie *)movie ofPerson:(nonnull TMDBPerson *)person creditInfo:(nonnull NSDictionary *)d;
+
+/** Set while decoding, from the list the credit was found in. */
+- (void)setCastMember:(BOOL)castMember;
+
+@end
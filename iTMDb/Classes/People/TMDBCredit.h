@@ -0,0 +1,68 @@
+//
+//  TMDBCredit.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+@class TMDBMovie;
+@class TMDBPerson;
+
+/**
+ * A `TMDBCredit` object represents a person's part in a movie, as a member of
+ * either the cast or the crew.
+ *
+ * The person is shared between all credits of that person, so information
+ * specific to the movie, such as the character, is kept here instead.
+ */
+@interface TMDBCredit : NSObject
+
+/**
+ * Returns a credit for `person` in `movie` with the provided credit
+ * information.
+ */
+- (nonnull instancetype)initWithPerson:(nonnull TMDBPerson *)person movie:(nullable TMDBMovie *)movie creditInfo:(nonnull NSDictionary *)d NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+/**
+ * The credited person.
+ *
+ * Credits in a movie's `credits` hold their person, so it is never `nil`.
+ * Credits in a person's `movieCredits` hold their movie instead, and only
+ * refer to the person weakly, so it is `nil` once the person has been
+ * deallocated.
+ */
+@property (nonatomic, strong, nullable, readonly) TMDBPerson *person;
+
+/** The movie the credit belongs to. */
+@property (nonatomic, weak, nullable, readonly) TMDBMovie *movie;
+
+/** The name of the character the person played in the movie. */
+@property (nonatomic, copy, nullable, readonly) NSString *character;
+
+/** The job position of the person in this movie. `Actor` for the cast. */
+@property (nonatomic, copy, nullable, readonly) NSString *job;
+
+/** The person's job department. */
+@property (nonatomic, copy, nullable, readonly) NSString *department;
+
+/**
+ * The order in which the person should be listed in the Cast and Crew list for
+ * the movie.
+ */
+@property (nonatomic, readonly) NSUInteger order;
+
+/** The ID of the cast member in the movie's cast list. */
+@property (nonatomic, readonly) NSInteger castID;
+
+/**
+ * A Boolean value indicating if the credit was listed in the cast, rather
+ * than the crew, of the response it was decoded from.
+ */
+@property (nonatomic, readonly, getter=isCastMember) BOOL castMember;
+
+@end
@@ -0,0 +1,80 @@
+//
+//  TMDBCredit.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBCredit.h"
+#import "TMDBCredit+Private.h"
+#import "TMDBPerson.h"
+#import "TMDBMovie.h"
+
+@implementation TMDBCredit {
+@private
+	// Set instead of the person and movie properties' own storage for
+	// credits kept by their person
+	__weak TMDBPerson *_weakPerson;
+	TMDBMovie *_strongMovie;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithPerson:(TMDBPerson *)person movie:(TMDBMovie *)movie creditInfo:(NSDictionary *)d {
+	NSParameterAssert(person != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_person = person;
+	_movie = movie;
+
+	_character = [TMDB_NSStringOrNil(d[@"character"]) copy];
+	_job = [TMDB_NSStringOrNil(d[@"job"]) copy];
+	if (_job == nil) {
+		// Cast members have a character rather than a job
+		_job = @"Actor";
+	}
+	_department = [TMDB_NSStringOrNil(d[@"department"]) copy];
+	_order = TMDB_NSNumberOrNil(d[@"order"]).unsignedIntegerValue;
+	_castID = TMDB_NSNumberOrNil(d[@"cast_id"]).integerValue;
+
+	return self;
+}
+
+- (instancetype)initWithMovie:(TMDBMovie *)movie ofPerson:(TMDBPerson *)person creditInfo:(NSDictionary *)d {
+	NSParameterAssert(movie != nil);
+
+	if (!(self = [self initWithPerson:person movie:movie creditInfo:d])) {
+		return nil;
+	}
+
+	_person = nil;
+	_weakPerson = person;
+	_strongMovie = movie;
+
+	return self;
+}
+
+- (void)setCastMember:(BOOL)castMember {
+	_castMember = castMember;
+}
+
+- (TMDBPerson *)person {
+	return _person ?: _weakPerson;
+}
+
+- (NSString *)description {
+	if (_character.length > 0) {
+		return [NSString stringWithFormat:@"<%@ %p: %@ as \"%@\">", [self class], self, self.person.name, _character];
+	}
+
+	return [NSString stringWithFormat:@"<%@ %p: %@ as %@>", [self class], self, self.person.name, _job];
+}
+
+@end
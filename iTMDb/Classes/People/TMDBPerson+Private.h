@@ -0,0 +1,36 @@
+//
+//  TMDBPerson+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBPerson.h"
+
+@class TMDBRequestSubscription;
+
+// Private methods shared with the other model classes
+@interface TMDBPerson (Private)
+
+/**
+ * Fills in the information about the person themselves, such as the name and
+ * profile image, where it's still missing. Credit information is ignored.
+ */
+- (void)populateIdentity:(nonnull NSDictionary *)personInfo;
+
+/**
+ * Updates the person like `-update:completionQueue:completion:`, and returns
+ * the subscription to the underlying request, or `nil` if the request
+ * couldn't be created. The completion block is called on `completionQueue`
+ * either way.
+ */
+- (nullable TMDBRequestSubscription *)subscribeToUpdate:(TMDBPersonUpdateOptions)options completionQueue:(nonnull dispatch_queue_t)completionQueue completion:(nullable TMDBPersonUpdateCompletionBlock)completionBlock;
+
+/**
+ * Returns the IDs that are set in an `external_ids` response, as strings,
+ * leaving out the TMDb ID of the person or movie itself.
+ */
++ (nullable NSDictionary<NSString *, NSString *> *)externalIDsFromDictionary:(nullable NSDictionary *)rawExternalIDs;
+
+@end
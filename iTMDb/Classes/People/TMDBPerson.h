@@ -8,15 +8,30 @@
 
 @import Foundation;
 
+@class TMDB;
+@class TMDBPerson;
 @class TMDBMovie;
+@class TMDBCredit;
+@class TMDBImage;
+@class TMDBRequestToken;
 
+/**
+ * The information fetched by `-[TMDBPerson update:completion:]`. Everything
+ * asked for is fetched in a single request.
+ */
 typedef NS_OPTIONS(NSUInteger, TMDBPersonUpdateOptions) {
 	/** Indicates that basic information should be fetched. */
 	TMDBPersonUpdateOptionBasic = 1 << 1,
-	/** Indicates that credits, i.e. cast and crew, should be fetched.  */
+	/** Indicates that movie credits, i.e. cast and crew, should be fetched.  */
 	TMDBPersonUpdateOptionCredits = 1 << 2,
 	/** Indicates that image URLs should be fetched. */
-	TMDBPersonUpdateOptionImages = 1 << 3
+	TMDBPersonUpdateOptionImages = 1 << 3,
+	/** Indicates that IDs on other sites, such as IMDb, should be fetched. */
+	TMDBPersonUpdateOptionExternalIDs = 1 << 4,
+	TMDBPersonUpdateOptionAll = TMDBPersonUpdateOptionBasic   |
+								TMDBPersonUpdateOptionCredits |
+								TMDBPersonUpdateOptionImages  |
+								TMDBPersonUpdateOptionExternalIDs
 };
 
 /**
@@ -25,10 +40,27 @@ typedef NS_OPTIONS(NSUInteger, TMDBPersonUpdateOptions) {
  */
 typedef void (^TMDBPersonUpdateCompletionBlock)(NSError * _Nullable error);
 
+/**
+ * A block called once for every person of a batch, as soon as it has been
+ * updated or failed to be.
+ */
+typedef void (^TMDBPersonBatchProgressBlock)(TMDBPerson * _Nonnull person, NSUInteger index, NSError * _Nullable error);
+
+/**
+ * A block called when every person of a batch has been updated or failed to
+ * be. `persons` is in the order of the IDs passed in, and `errors` maps the
+ * indexes of the persons that failed to their errors.
+ */
+typedef void (^TMDBPersonBatchCompletionBlock)(NSArray<TMDBPerson *> * _Nonnull persons, NSDictionary<NSNumber *, NSError *> * _Nonnull errors);
+
 /**
  * A `TMDBPerson` object contains information about a person associated with a
  * `TMDBMovie` object.
  *
+ * The persons in `-[TMDBMovie credits]` are shared between all movies of the
+ * same context, and only the person's own information is set on them. The
+ * character, job and order of a credit are found on its `TMDBCredit`.
+ *
  * By default Person objects contain only basic information. To fetch more
  * information use the `-update:` and `-update:completion:` metods.
  */
@@ -48,15 +80,43 @@ typedef void (^TMDBPersonUpdateCompletionBlock)(NSError * _Nullable error);
  */
 + (nonnull NSArray<TMDBPerson *> *)personsWithMovie:(nonnull TMDBMovie *)movie personsInfo:(nonnull NSArray<NSDictionary *> *)d;
 
+/**
+ * Updates the persons with the given TMDb IDs, keeping a bounded number of
+ * requests in flight so a long list doesn't hold up other requests.
+ *
+ * The persons are the ones shared with the credits of the movies loaded
+ * through `context`, so updating them updates those credits too.
+ *
+ * @param personIDs The TMDb IDs of the persons, as `NSNumber` objects.
+ * @param options The information to be fetched for every person.
+ * @param context The context to update the persons through. Pass `nil` to use
+ * the shared instance.
+ * @param completionQueue The queue on which to call both blocks. Pass `nil` to
+ * use the `completionQueue` of `context`.
+ * @return A progress counting the persons updated. Cancel it to cancel the
+ * updates still to be made.
+ */
++ (nonnull NSProgress *)updatePersonsWithIDs:(nonnull NSArray<NSNumber *> *)personIDs options:(TMDBPersonUpdateOptions)options context:(nullable TMDB *)context completionQueue:(nullable dispatch_queue_t)completionQueue progress:(nullable TMDBPersonBatchProgressBlock)progressBlock completion:(nullable TMDBPersonBatchCompletionBlock)completionBlock;
+
 /** @name Creating an Instance */
 
+/**
+ * Returns a person object populated only with the provided ID, updated through
+ * the shared context. Fetch person information by calling `-update:`.
+ *
+ * @param personID The ID of the person.
+ */
+- (nonnull instancetype)initWithID:(NSUInteger)personID;
+
 /**
  * Returns a person object populated only with the provided ID. Fetch person
  * information by calling `-update:`.
  *
  * @param personID The ID of the person.
+ * @param context The context through which the person is updated. Pass `nil`
+ * to use the shared instance.
  */
-- (nonnull instancetype)initWithID:(NSUInteger)personID NS_DESIGNATED_INITIALIZER;
+- (nonnull instancetype)initWithID:(NSUInteger)personID context:(nullable TMDB *)context NS_DESIGNATED_INITIALIZER;
 
 /**
  * Returns a person object populated with the provided person information.
@@ -70,6 +130,12 @@ typedef void (^TMDBPersonUpdateCompletionBlock)(NSError * _Nullable error);
 
 /** @name Basic Information */
 
+/**
+ * The context through which the person is updated. Persons in the credits of a
+ * movie share the movie's context.
+ */
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
+
 /** The TMDb ID of the person. */
 @property (nonatomic, readonly) NSUInteger id;
 
@@ -79,8 +145,13 @@ typedef void (^TMDBPersonUpdateCompletionBlock)(NSError * _Nullable error);
 /** The name of the character the person played in the movie. */
 @property (nonatomic, copy, nullable,readonly) NSString *character;
 
-/** The movie in which the person played a character or was part of a crew. */
-@property (nonatomic, strong, nullable,readonly) TMDBMovie *movie;
+/**
+ * The movie in which the person played a character or was part of a crew.
+ *
+ * The movie isn't retained, as it retains its cast. Keep a reference to the
+ * movie for as long as you use it through its persons.
+ */
+@property (nonatomic, weak, nullable, readonly) TMDBMovie *movie;
 
 /** The job position of the person in this movie. */
 @property (nonatomic, copy, nullable,readonly) NSString *job;
@@ -97,11 +168,55 @@ typedef void (^TMDBPersonUpdateCompletionBlock)(NSError * _Nullable error);
 /** The */
 @property (nonatomic, readonly) NSInteger castID;
 
+/** @name Profile */
+
+/**
+ * The person's biography. Set by updating the person, like the rest of this
+ * section.
+ */
+@property (nonatomic, copy, nullable, readonly) NSString *biography;
+
+@property (nonatomic, copy, nullable, readonly) NSDate *birthday;
+
+@property (nonatomic, copy, nullable, readonly) NSDate *deathday;
+
+@property (nonatomic, copy, nullable, readonly) NSString *placeOfBirth;
+
+/** Other names the person is known by. */
+@property (nonatomic, copy, nullable, readonly) NSArray<NSString *> *alsoKnownAs;
+
+/** The profile images of the person. Set by updating with `TMDBPersonUpdateOptionImages`. */
+@property (nonatomic, copy, nullable, readonly) NSArray<TMDBImage *> *profileImages;
+
+/**
+ * The person's part in every movie they were in, cast first and then crew.
+ * Set by updating with `TMDBPersonUpdateOptionCredits`.
+ *
+ * The movies are only populated with the information in the credits, and are
+ * kept alive by the person. They are separate objects from the movie the
+ * person may have been found through. To load one of them in full, create a
+ * new movie with its ID, as a loaded movie and its cast would retain each
+ * other through the person.
+ */
+@property (nonatomic, copy, nullable, readonly) NSArray<TMDBCredit *> *movieCredits;
+
+/**
+ * The person's IDs on other sites, keyed as in the TMDb response, such as
+ * `imdb_id` and `twitter_id`. Set by updating with
+ * `TMDBPersonUpdateOptionExternalIDs`.
+ */
+@property (nonatomic, copy, nullable, readonly) NSDictionary<NSString *, NSString *> *externalIDs;
+
 /** @name External Resources */
 
 /** A URL to an official website of this person. */
 @property (nonatomic, copy, nullable,readonly) NSURL *url;
 
+@property (nonatomic, copy, nullable, readonly) NSURL *homepage;
+
+/** The person's IMDb ID, such as `nm0000138`. */
+@property (nonatomic, copy, nullable, readonly) NSString *imdbID;
+
 /** A URL fragment pointing to the TMDb profile image of this person. */
 @property (nonatomic, copy, nullable,readonly) NSURL *imageURL;
 
@@ -111,15 +226,31 @@ typedef void (^TMDBPersonUpdateCompletionBlock)(NSError * _Nullable error);
  * Updates the Person with the basic information.
  *
  * @param completionBlock A block called when the update succeeds or fails.
+ * @return A token for changing the priority of the request or cancelling it.
+ */
+- (nonnull TMDBRequestToken *)update:(nullable TMDBPersonUpdateCompletionBlock)completionBlock;
+
+/**
+ * Updates the Person with the specified information, all in one request.
+ *
+ * @param options The information to be fetched.
+ * @param completionBlock A block called when the update succeeds or fails.
+ * @return A token for changing the priority of the request or cancelling it.
  */
-- (void)update:(nullable TMDBPersonUpdateCompletionBlock)completionBlock;
+- (nonnull TMDBRequestToken *)update:(TMDBPersonUpdateOptions)options completion:(nullable TMDBPersonUpdateCompletionBlock)completionBlock;
 
 /**
- * Updates the Person with the specified information.
+ * Updates the Person with the specified information, all in one request.
+ *
+ * The response is decoded and the person populated on a background queue, and
+ * only the completion block is called on `completionQueue`.
  *
  * @param options The information to be fetched.
+ * @param completionQueue The queue on which to call the completion block. Pass
+ * `nil` to use the context's `completionQueue`.
  * @param completionBlock A block called when the update succeeds or fails.
+ * @return A token for changing the priority of the request or cancelling it.
  */
-- (void)update:(TMDBPersonUpdateOptions)options completion:(nullable TMDBPersonUpdateCompletionBlock)completionBlock;
+- (nonnull TMDBRequestToken *)update:(TMDBPersonUpdateOptions)options completionQueue:(nullable dispatch_queue_t)completionQueue completion:(nullable TMDBPersonUpdateCompletionBlock)completionBlock;
 
 @end
@@ -7,9 +7,20 @@
 //
 
 #import "TMDBPerson.h"
+#import "TMDBPerson+Private.h"
+#import "TMDBCredit.h"
+#import "TMDBCredit+Private.h"
+#import "TMDBFootprint.h"
 #import "TMDBMovie.h"
+#import "TMDBImage+Private.h"
 #import "TMDB.h"
+#import "TMDBError.h"
 #import "TMDBRequest.h"
+#import "TMDBBatch.h"
+#import "TMDB+Private.h"
+#import "TMDBIdentityMap.h"
+#import "TMDBRequestToken+Private.h"
+#import "TMDBRequestMetrics+Private.h"
 
 @implementation TMDBPerson
 
@@ -26,22 +37,47 @@
 	return [persons copy];
 }
 
++ (NSProgress *)updatePersonsWithIDs:(NSArray<NSNumber *> *)personIDs options:(TMDBPersonUpdateOptions)options context:(TMDB *)context completionQueue:(dispatch_queue_t)completionQueue progress:(TMDBPersonBatchProgressBlock)progressBlock completion:(TMDBPersonBatchCompletionBlock)completionBlock {
+	NSParameterAssert(personIDs != nil);
+
+	context = context ?: [TMDB sharedInstance];
+	personIDs = [personIDs copy];
+
+	// The canonical persons of the identity map, so the credits of movies
+	// already loaded see the updates
+	TMDBBatch *batch = [[TMDBBatch alloc] initWithCount:personIDs.count contexts:@[context] completionQueue:completionQueue ?: context.completionQueue itemBlock:^id(NSUInteger index, TMDB *itemContext) {
+		return [itemContext.identityMap personWithInfo:@{@"id": TMDB_NSNumberOrNil(personIDs[index]) ?: @0}];
+	} subscribeBlock:^TMDBRequestSubscription *(TMDBPerson *person, dispatch_queue_t queue, TMDBBatchItemCompletionBlock itemCompletionBlock) {
+		return [person subscribeToUpdate:options completionQueue:queue completion:itemCompletionBlock];
+	}];
+	batch.progressBlock = progressBlock;
+	batch.completionBlock = completionBlock;
+	[batch start];
+
+	return batch.progress;
+}
+
 - (instancetype)init {
 	return (self = [self initWithID:0]);
 }
 
 - (instancetype)initWithID:(NSUInteger)personID {
+	return (self = [self initWithID:personID context:nil]);
+}
+
+- (instancetype)initWithID:(NSUInteger)personID context:(TMDB *)context {
 	if (!(self = [super init])) {
 		return nil;
 	}
 
 	_id = personID;
+	_context = context ?: [TMDB sharedInstance];
 
 	return self;
 }
 
 - (instancetype)initWithMovie:(TMDBMovie *)movie personInfo:(NSDictionary *)d {
-	if (!(self = [self initWithID:0])) {
+	if (!(self = [self initWithID:0 context:movie.context])) {
 		return nil;
 	}
 
@@ -57,14 +93,16 @@
 #pragma mark -
 
 - (NSString *)description {
-	if (_movie != nil && _character.length > 0 && _name.length > 0) {
-		return [NSString stringWithFormat:@"<%@ %p: %@ as \"%@\" in \"%@\"%@>", [self class], self, _name, _character, _movie.title, _movie.year > 0 ? [NSString stringWithFormat:@" (%zd)", _movie.year] : @"", nil];
+	TMDBMovie *movie = _movie;
+
+	if (movie != nil && _character.length > 0 && _name.length > 0) {
+		return [NSString stringWithFormat:@"<%@ %p: %@ as \"%@\" in \"%@\"%@>", [self class], self, _name, _character, movie.title, movie.year > 0 ? [NSString stringWithFormat:@" (%zd)", movie.year] : @"", nil];
 	}
-	else if (_movie != nil && _name.length > 0 && _job.length > 0) {
-		return [NSString stringWithFormat:@"<%@ %p: %@ as %@ of \"%@\"%@>", [self class], self, _name, _job, _movie.title, _movie.year > 0 ? [NSString stringWithFormat:@" (%zd)", _movie.year] : @"", nil];
+	else if (movie != nil && _name.length > 0 && _job.length > 0) {
+		return [NSString stringWithFormat:@"<%@ %p: %@ as %@ of \"%@\"%@>", [self class], self, _name, _job, movie.title, movie.year > 0 ? [NSString stringWithFormat:@" (%zd)", movie.year] : @"", nil];
 	}
-	else if (_movie != nil && _name.length > 0) {
-		return [NSString stringWithFormat:@"<%@ %p: %@ in \"%@\"%@>", [self class], self, _name, _movie.title, _movie.year > 0 ? [NSString stringWithFormat:@" (%zd)", _movie.year] : @"", nil];
+	else if (movie != nil && _name.length > 0) {
+		return [NSString stringWithFormat:@"<%@ %p: %@ in \"%@\"%@>", [self class], self, _name, movie.title, movie.year > 0 ? [NSString stringWithFormat:@" (%zd)", movie.year] : @"", nil];
 	}
 	else if (_name.length > 0) {
 		return [NSString stringWithFormat:@"<%@ %p: %@>", [self class], self, _name, nil];
@@ -73,8 +111,39 @@
 	return [NSString stringWithFormat:@"<%@ %p>", [self class], self];
 }
 
+- (NSUInteger)footprint {
+	@synchronized(self) {
+		return TMDBFootprintOfObject(self) +
+			   TMDBFootprintOfString(_name) +
+			   TMDBFootprintOfString(_character) +
+			   TMDBFootprintOfString(_job) +
+			   TMDBFootprintOfString(_department) +
+			   TMDBFootprintOfObject(_url) +
+			   TMDBFootprintOfObject(_imageURL) +
+			   TMDBFootprintOfString(_biography) +
+			   TMDBFootprintOfString(_placeOfBirth) +
+			   TMDBFootprintOfString(_imdbID) +
+			   TMDBFootprintOfObject(_homepage);
+	}
+}
+
 #pragma mark -
 
+- (void)populateIdentity:(NSDictionary *)d {
+	// Canonical persons are shared between threads
+	@synchronized(self) {
+		if (_name == nil) {
+			_name = [TMDB_NSStringOrNil(d[@"name"]) copy];
+		}
+		if (_url == nil) {
+			_url = TMDB_NSURLOrNilFromStringOrNil(d[@"url"]);
+		}
+		if (_imageURL == nil) {
+			_imageURL = TMDB_NSURLOrNilFromStringOrNil(d[@"profile_path"]); // TODO: Validate URL fragment
+		}
+	}
+}
+
 - (void)populate:(NSDictionary *)d {
 	_id = TMDB_NSNumberOrNil(d[@"id"]).unsignedIntegerValue;
 	_name = [TMDB_NSStringOrNil(d[@"name"]) copy];
@@ -89,24 +158,193 @@
 	_imageURL = TMDB_NSURLOrNilFromStringOrNil(d[@"profile_path"]); // TODO: Validate URL fragment
 }
 
+// Private. Replaces the person's own information with that of a /person
+// response. Appended parts missing from the response are left as they were,
+// so updating with fewer options keeps what earlier updates fetched.
+- (void)populateProfile:(NSDictionary *)d {
+	// Built before locking, as populating the movies takes a while
+	NSArray *rawProfiles = TMDB_NSArrayOrNil(TMDB_NSDictionaryOrNil(d[@"images"])[@"profiles"]);
+	NSArray<TMDBImage *> *profileImages = nil;
+	if (rawProfiles != nil) {
+		profileImages = [TMDBImage imageArrayWithRawImageDictionaries:rawProfiles ofType:TMDBImageTypeProfile context:_context];
+	}
+
+	NSArray<TMDBCredit *> *movieCredits = [self movieCreditsFromDictionary:TMDB_NSDictionaryOrNil(d[@"movie_credits"])];
+	NSDictionary<NSString *, NSString *> *externalIDs = [TMDBPerson externalIDsFromDictionary:TMDB_NSDictionaryOrNil(d[@"external_ids"])];
+
+	NSMutableArray<NSString *> *alsoKnownAs = [NSMutableArray array];
+	for (id name in TMDB_NSArrayOrNil(d[@"also_known_as"])) {
+		if (TMDB_NSStringOrNil(name) != nil) {
+			[alsoKnownAs addObject:name];
+		}
+	}
+
+	// Canonical persons are shared between threads
+	@synchronized(self) {
+		_name = [TMDB_NSStringOrNil(d[@"name"]) copy] ?: _name;
+		_imageURL = TMDB_NSURLOrNilFromStringOrNil(d[@"profile_path"]) ?: _imageURL; // TODO: Validate URL fragment
+		_biography = [TMDB_NSStringOrNil(d[@"biography"]) copy];
+		_birthday = [TMDBMovie dateFromString:d[@"birthday"]];
+		_deathday = [TMDBMovie dateFromString:d[@"deathday"]];
+		_placeOfBirth = [TMDB_NSStringOrNil(d[@"place_of_birth"]) copy];
+		_alsoKnownAs = [alsoKnownAs copy];
+		_homepage = TMDB_NSURLOrNilFromStringOrNil(d[@"homepage"]);
+		_imdbID = [TMDB_NSStringOrNil(d[@"imdb_id"]) copy];
+
+		if (profileImages != nil) {
+			_profileImages = profileImages;
+		}
+		if (movieCredits != nil) {
+			_movieCredits = movieCredits;
+		}
+		if (externalIDs != nil) {
+			_externalIDs = externalIDs;
+		}
+	}
+}
+
+// Private
+- (NSArray<TMDBCredit *> *)movieCreditsFromDictionary:(NSDictionary *)rawCredits {
+	if (rawCredits == nil) {
+		return nil;
+	}
+
+	NSMutableArray<TMDBCredit *> *credits = [NSMutableArray array];
+	NSMutableDictionary<NSNumber *, TMDBMovie *> *movies = [NSMutableDictionary dictionary];
+
+	for (NSString *key in @[@"cast", @"crew"]) {
+		for (id rawCredit in TMDB_NSArrayOrNil(rawCredits[key])) {
+			NSDictionary *creditInfo = TMDB_NSDictionaryOrNil(rawCredit);
+			NSNumber *movieID = TMDB_NSNumberOrNil(creditInfo[@"id"]);
+			if (movieID == nil) {
+				continue;
+			}
+
+			// A person may be credited more than once for the same movie
+			TMDBMovie *movie = movies[movieID];
+			if (movie == nil) {
+				movie = [[TMDBMovie alloc] initWithID:movieID.unsignedIntegerValue context:_context];
+				[movie populate:creditInfo];
+				movies[movieID] = movie;
+			}
+
+			TMDBCredit *credit = [[TMDBCredit alloc] initWithMovie:movie ofPerson:self creditInfo:creditInfo];
+			[credit setCastMember:[key isEqualToString:@"cast"]];
+			[credits addObject:credit];
+		}
+	}
+
+	return [credits copy];
+}
+
++ (NSDictionary<NSString *, NSString *> *)externalIDsFromDictionary:(NSDictionary *)rawExternalIDs {
+	if (rawExternalIDs == nil) {
+		return nil;
+	}
+
+	NSMutableDictionary<NSString *, NSString *> *externalIDs = [NSMutableDictionary dictionary];
+
+	[rawExternalIDs enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		if (TMDB_NSStringOrNil(key) == nil || [key isEqualToString:@"id"]) {
+			return;
+		}
+
+		if (TMDB_NSStringOrNil(value).length > 0) {
+			externalIDs[key] = value;
+		}
+		else if (TMDB_NSNumberOrNil(value) != nil) {
+			externalIDs[key] = [value stringValue];
+		}
+	}];
+
+	return [externalIDs copy];
+}
+
 #pragma mark - Updating
 
-- (void)update:(TMDBPersonUpdateCompletionBlock)completionBlock {
-	[self update:TMDBPersonUpdateOptionBasic completion:completionBlock];
++ (NSString *)appendToResponseStringFromUpdateOptions:(TMDBPersonUpdateOptions)options {
+	NSMutableArray *optionsArray = [NSMutableArray array];
+
+	if ((options & TMDBPersonUpdateOptionCredits) == TMDBPersonUpdateOptionCredits) {
+		[optionsArray addObject:@"movie_credits"];
+	}
+
+	if ((options & TMDBPersonUpdateOptionImages) == TMDBPersonUpdateOptionImages) {
+		[optionsArray addObject:@"images"];
+	}
+
+	if ((options & TMDBPersonUpdateOptionExternalIDs) == TMDBPersonUpdateOptionExternalIDs) {
+		[optionsArray addObject:@"external_ids"];
+	}
+
+	if (optionsArray.count == 0) {
+		return @"";
+	}
+
+	return [NSString stringWithFormat:@"&append_to_response=%@", [optionsArray componentsJoinedByString:@","]];
 }
 
-- (void)update:(TMDBPersonUpdateOptions)options completion:(TMDBPersonUpdateCompletionBlock)completionBlock {
-	TMDB *context = [TMDB sharedInstance];
-	NSURL *url = [NSURL URLWithString:[TMDBAPIURLBase stringByAppendingFormat:@"%@/person/%zd?api_key=%@&language=%@",
-									   TMDBAPIVersion, _id, context.apiKey, context.language]];
+- (TMDBRequestToken *)update:(TMDBPersonUpdateCompletionBlock)completionBlock {
+	return [self update:TMDBPersonUpdateOptionBasic completion:completionBlock];
+}
 
-	[TMDBRequest requestWithURL:url completionBlock:^(id parsedData, NSError *error) {
-//		NSLog(@"%@", parsedData);
+- (TMDBRequestToken *)update:(TMDBPersonUpdateOptions)options completion:(TMDBPersonUpdateCompletionBlock)completionBlock {
+	return [self update:options completionQueue:nil completion:completionBlock];
+}
 
-		if (completionBlock != nil) {
+- (TMDBRequestToken *)update:(TMDBPersonUpdateOptions)options completionQueue:(dispatch_queue_t)completionQueue completion:(TMDBPersonUpdateCompletionBlock)completionBlock {
+	TMDBRequestToken *token = [[TMDBRequestToken alloc] init];
+	__weak TMDBRequestToken *weakToken = token;
+
+	TMDBRequestSubscription *subscription = [self subscribeToUpdate:options completionQueue:completionQueue ?: _context.completionQueue completion:^(NSError *error) {
+		// The request may have finished just before the token was cancelled
+		if (completionBlock != nil && !weakToken.isCancelled) {
 			completionBlock(error);
 		}
 	}];
+	[token setSubscription:subscription];
+
+	return token;
+}
+
+- (TMDBRequestSubscription *)subscribeToUpdate:(TMDBPersonUpdateOptions)options completionQueue:(dispatch_queue_t)queue completion:(TMDBPersonUpdateCompletionBlock)completionBlock {
+	TMDB *context = _context;
+	NSURL *url = [NSURL URLWithString:[TMDBAPIURLBase stringByAppendingFormat:@"%@/person/%tu?api_key=%@&language=%@%@",
+									   TMDBAPIVersion, _id, context.apiKey, context.language, [TMDBPerson appendToResponseStringFromUpdateOptions:options]]];
+
+	if (url == nil) {
+		if (completionBlock != nil) {
+			NSError *error = [NSError errorWithDomain:TMDBErrorDomain
+												 code:TMDBErrorCodeInvalidURL
+											 userInfo:nil];
+			dispatch_async(queue, ^{
+				completionBlock(error);
+			});
+		}
+		return nil;
+	}
+
+	return [TMDBRequest requestWithURL:url context:context completionBlock:^(id parsedData, NSError *error) {
+		// Called on the request work queue, so populating doesn't block the
+		// main thread
+		TMDBRequestMetrics *metrics = TMDBRequestMetricsCurrent();
+
+		if (error == nil && TMDB_NSDictionaryOrNil(parsedData) == nil) {
+			error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeReceivedInvalidData userInfo:nil];
+		}
+
+		if (error == nil) {
+			CFAbsoluteTime populateStart = CFAbsoluteTimeGetCurrent();
+			[self populateProfile:parsedData];
+			[metrics addDuration:CFAbsoluteTimeGetCurrent() - populateStart toPhase:TMDBRequestPhasePopulate];
+		}
+
+		if (completionBlock != nil) {
+			TMDBRequestMetricsDispatchAsync(metrics, queue, ^{
+				completionBlock(error);
+			});
+		}
+	}];
 }
 
 @end
\ No newline at end of file
@@ -0,0 +1,57 @@
+//
+//  TMDBBatch.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+@class TMDB;
+@class TMDBRequestSubscription;
+
+typedef void (^TMDBBatchItemCompletionBlock)(NSError * _Nullable error);
+
+/** Returns the model object for the item at `index`, made through `context`. */
+typedef id _Nonnull (^TMDBBatchItemBlock)(NSUInteger index, TMDB * _Nonnull context);
+
+/**
+ * Subscribes to loading `item`, calling `completionBlock` on `queue` when it
+ * has finished. Returns the subscription, or `nil` if no request could be
+ * made, in which case the completion block must still be called.
+ */
+typedef TMDBRequestSubscription * _Nullable (^TMDBBatchSubscribeBlock)(id _Nonnull item, dispatch_queue_t _Nonnull queue, TMDBBatchItemCompletionBlock _Nonnull completionBlock);
+
+typedef void (^TMDBBatchProgressBlock)(id _Nonnull item, NSUInteger index, NSError * _Nullable error);
+typedef void (^TMDBBatchCompletionBlock)(NSArray * _Nonnull items, NSDictionary<NSNumber *, NSError *> * _Nonnull errors);
+
+/**
+ * Loads a list of model objects through the shared request pipeline, keeping
+ * a bounded number of requests in flight per context, and collects the
+ * results in input order. What is loaded, and how, is left to the item and
+ * subscribe blocks, which the movie and person batches provide.
+ *
+ * Every item is loaded through whichever context has the fewest requests in
+ * flight when its turn comes, so contexts with a larger rate limit end up
+ * loading more of the batch.
+ *
+ * The batch keeps itself alive until it has completed.
+ */
+// Private class
+@interface TMDBBatch : NSObject
+
+- (nonnull instancetype)initWithCount:(NSUInteger)count contexts:(nonnull NSArray<TMDB *> *)contexts completionQueue:(nonnull dispatch_queue_t)completionQueue itemBlock:(nonnull TMDBBatchItemBlock)itemBlock subscribeBlock:(nonnull TMDBBatchSubscribeBlock)subscribeBlock NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, nullable) TMDBBatchProgressBlock progressBlock;
+@property (nonatomic, copy, nullable) TMDBBatchCompletionBlock completionBlock;
+
+/** Counts finished items. Cancelling it cancels the batch. */
+@property (nonatomic, strong, nonnull, readonly) NSProgress *progress;
+
+- (void)start;
+- (void)cancel;
+
+@end
@@ -0,0 +1,213 @@
+//
+//  TMDBBatch.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBBatch.h"
+#import "TMDBRequest.h"
+#import "TMDB.h"
+
+// The number of requests a batch keeps in flight per context. The rate
+// limiter decides when they are actually sent, this just keeps a batch of
+// thousands from filling up the request queue ahead of everybody else.
+static const NSUInteger TMDBBatchMaximumConcurrentLoads = 8;
+
+@implementation TMDBBatch {
+@private
+	NSUInteger _count;
+	NSArray<TMDB *> *_contexts;
+	dispatch_queue_t _completionQueue;
+	TMDBBatchItemBlock _itemBlock;
+	TMDBBatchSubscribeBlock _subscribeBlock;
+
+	// All state below is only touched on this queue
+	dispatch_queue_t _queue;
+	// Holds NSNull until the item at an index has been created
+	NSMutableArray *_items;
+	NSMutableDictionary<NSNumber *, TMDBRequestSubscription *> *_subscriptions;
+	NSMutableDictionary<NSNumber *, NSError *> *_errors;
+	NSMutableIndexSet *_finishedIndexes;
+	NSUInteger _nextIndex;
+	// One count for every context
+	NSUInteger *_loadsInFlight;
+	BOOL _completed;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithCount:(NSUInteger)count contexts:(NSArray<TMDB *> *)contexts completionQueue:(dispatch_queue_t)completionQueue itemBlock:(TMDBBatchItemBlock)itemBlock subscribeBlock:(TMDBBatchSubscribeBlock)subscribeBlock {
+	NSParameterAssert(contexts.count > 0);
+	NSParameterAssert(completionQueue != nil);
+	NSParameterAssert(itemBlock != nil);
+	NSParameterAssert(subscribeBlock != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_count = count;
+	_contexts = [contexts copy];
+	_completionQueue = completionQueue;
+	_itemBlock = [itemBlock copy];
+	_subscribeBlock = [subscribeBlock copy];
+
+	_queue = dispatch_queue_create("dk.devify.tmdb.batch", DISPATCH_QUEUE_SERIAL);
+	dispatch_set_target_queue(_queue, [TMDBRequest workQueue]);
+	_items = [NSMutableArray arrayWithCapacity:_count];
+	for (NSUInteger i = 0; i < _count; i++) {
+		[_items addObject:[NSNull null]];
+	}
+	_subscriptions = [NSMutableDictionary dictionary];
+	_errors = [NSMutableDictionary dictionary];
+	_finishedIndexes = [NSMutableIndexSet indexSet];
+	_loadsInFlight = calloc(_contexts.count, sizeof(NSUInteger));
+
+	_progress = [[NSProgress alloc] initWithParent:nil userInfo:nil];
+	_progress.totalUnitCount = (int64_t)_count;
+	_progress.cancellable = YES;
+
+	__weak typeof(self) weakSelf = self;
+	_progress.cancellationHandler = ^{
+		[weakSelf cancel];
+	};
+
+	return self;
+}
+
+- (void)dealloc {
+	free(_loadsInFlight);
+}
+
+- (void)start {
+	dispatch_async(_queue, ^{
+		[self loadMore];
+		[self completeIfFinished];
+	});
+}
+
+- (void)cancel {
+	dispatch_async(_queue, ^{
+		if (self->_completed) {
+			return;
+		}
+
+		for (TMDBRequestSubscription *subscription in self->_subscriptions.allValues) {
+			[subscription cancel];
+		}
+		[self->_subscriptions removeAllObjects];
+
+		NSError *cancelled = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+		for (NSUInteger i = 0; i < self->_count; i++) {
+			if (![self->_finishedIndexes containsIndex:i]) {
+				self->_errors[@(i)] = cancelled;
+			}
+		}
+
+		[self complete];
+	});
+}
+
+#pragma mark - Private
+
+- (id)itemForIndex:(NSUInteger)index contextIndex:(NSUInteger)contextIndex {
+	if (_items[index] == [NSNull null]) {
+		_items[index] = _itemBlock(index, _contexts[contextIndex]);
+	}
+	return _items[index];
+}
+
+// The index of the context with the fewest loads in flight, the first one
+// winning ties.
+- (NSUInteger)leastBusyContextIndex {
+	NSUInteger best = 0;
+	for (NSUInteger i = 1; i < _contexts.count; i++) {
+		if (_loadsInFlight[i] < _loadsInFlight[best]) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+- (void)loadMore {
+	while (!_completed && _nextIndex < _count) {
+		NSUInteger contextIndex = [self leastBusyContextIndex];
+		if (_loadsInFlight[contextIndex] >= TMDBBatchMaximumConcurrentLoads) {
+			break;
+		}
+
+		NSUInteger index = _nextIndex++;
+		_loadsInFlight[contextIndex]++;
+
+		// The item's completion block is called on our own queue, so it can
+		// update the batch state directly.
+		id item = [self itemForIndex:index contextIndex:contextIndex];
+		TMDBRequestSubscription *subscription = _subscribeBlock(item, _queue, ^(NSError *error) {
+			[self itemAtIndex:index contextIndex:contextIndex didFinishWithError:error];
+		});
+
+		if (subscription != nil) {
+			_subscriptions[@(index)] = subscription;
+		}
+	}
+}
+
+- (void)itemAtIndex:(NSUInteger)index contextIndex:(NSUInteger)contextIndex didFinishWithError:(NSError *)error {
+	if (_completed) {
+		return;
+	}
+
+	[_subscriptions removeObjectForKey:@(index)];
+	_loadsInFlight[contextIndex]--;
+	[_finishedIndexes addIndex:index];
+
+	if (error != nil) {
+		_errors[@(index)] = error;
+	}
+
+	_progress.completedUnitCount = (int64_t)_finishedIndexes.count;
+
+	TMDBBatchProgressBlock progressBlock = self.progressBlock;
+	if (progressBlock != nil) {
+		id item = _items[index];
+		dispatch_async(_completionQueue, ^{
+			progressBlock(item, index, error);
+		});
+	}
+
+	[self loadMore];
+	[self completeIfFinished];
+}
+
+- (void)completeIfFinished {
+	if (!_completed && _finishedIndexes.count == _count) {
+		[self complete];
+	}
+}
+
+- (void)complete {
+	_completed = YES;
+	_progress.cancellationHandler = nil;
+
+	TMDBBatchCompletionBlock completionBlock = self.completionBlock;
+	if (completionBlock != nil) {
+		// Items never loaded because the batch was cancelled still get an
+		// object, on the first context.
+		for (NSUInteger i = 0; i < _items.count; i++) {
+			[self itemForIndex:i contextIndex:0];
+		}
+
+		NSArray *items = [_items copy];
+		NSDictionary *errors = [_errors copy];
+		dispatch_async(_completionQueue, ^{
+			completionBlock(items, errors);
+		});
+	}
+}
+
+@end
@@ -0,0 +1,36 @@
+//
+//  TMDBJSONStreamParser.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+/**
+ * Picks the objects of one array out of a JSON document while it is still
+ * downloading, such as the `results` array of a search response.
+ *
+ * The parser only tracks nesting and strings; each object is handed back as
+ * raw bytes as soon as its closing brace arrives, ready to be decoded with
+ * `NSJSONSerialization`.
+ */
+// Private class
+@interface TMDBJSONStreamParser : NSObject
+
+/**
+ * Creates a parser for the array stored under `key` in the top-level object
+ * of the document.
+ */
+- (nonnull instancetype)initWithArrayKey:(nonnull NSString *)key NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Appends the next chunk of the document, and returns the data of the array
+ * objects completed by it, in order.
+ */
+- (nonnull NSArray<NSData *> *)objectsByAppendingData:(nonnull NSData *)data;
+
+@end
@@ -0,0 +1,133 @@
+//
+//  TMDBJSONStreamParser.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBJSONStreamParser.h"
+
+@implementation TMDBJSONStreamParser {
+@private
+	NSData *_key;
+	NSMutableData *_buffer;
+	NSUInteger _offset;
+	NSUInteger _depth;
+
+	BOOL _inString;
+	BOOL _escaped;
+	NSUInteger _stringStart;
+
+	// Set when the last string in the top-level object was the array's key
+	BOOL _keyMatched;
+	BOOL _inArray;
+	BOOL _done;
+	NSUInteger _objectStart;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithArrayKey:(NSString *)key {
+	NSParameterAssert(key != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_key = [key dataUsingEncoding:NSUTF8StringEncoding];
+	_buffer = [NSMutableData data];
+
+	return self;
+}
+
+- (NSArray<NSData *> *)objectsByAppendingData:(NSData *)data {
+	if (_done) {
+		return @[];
+	}
+
+	[_buffer appendData:data];
+
+	NSMutableArray *objects = [NSMutableArray array];
+	const uint8_t *bytes = _buffer.bytes;
+	NSUInteger length = _buffer.length;
+
+	for (; _offset < length && !_done; _offset++) {
+		uint8_t c = bytes[_offset];
+
+		if (_inString) {
+			if (_escaped) {
+				_escaped = NO;
+			}
+			else if (c == '\\') {
+				_escaped = YES;
+			}
+			else if (c == '"') {
+				_inString = NO;
+
+				if (_depth == 1) {
+					NSUInteger start = _stringStart + 1;
+					NSUInteger stringLength = _offset - start;
+					_keyMatched = stringLength == _key.length && memcmp(bytes + start, _key.bytes, stringLength) == 0;
+				}
+			}
+			continue;
+		}
+
+		switch (c) {
+			case '"':
+				_inString = YES;
+				_stringStart = _offset;
+				break;
+
+			case '[':
+				if (_depth == 1 && _keyMatched) {
+					_inArray = YES;
+				}
+				_depth++;
+				break;
+
+			case '{':
+				if (_inArray && _depth == 2) {
+					_objectStart = _offset;
+				}
+				_depth++;
+				break;
+
+			case '}':
+			case ']':
+				if (_depth > 0) {
+					_depth--;
+				}
+
+				if (_inArray && c == '}' && _depth == 2) {
+					[objects addObject:[_buffer subdataWithRange:NSMakeRange(_objectStart, _offset - _objectStart + 1)]];
+				}
+				else if (_inArray && c == ']' && _depth == 1) {
+					_inArray = NO;
+					_done = YES;
+				}
+				break;
+
+			case ',':
+				if (_depth == 1) {
+					_keyMatched = NO;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	if (_done) {
+		_buffer = nil;
+	}
+
+	return objects;
+}
+
+@end
@@ -0,0 +1,38 @@
+//
+//  TMDBMetricsRecorder.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBRequestMetrics.h"
+
+/**
+ * Hands the metrics of finished requests to the registered observers, and
+ * adds them up per endpoint. Every context has a recorder of its own.
+ */
+// Private class
+@interface TMDBMetricsRecorder : NSObject
+
+/**
+ * A Boolean value indicating if requests should be measured, which is only
+ * the case while an observer is registered. Cheap enough to read for every
+ * request.
+ */
+@property (atomic, readonly, getter=isEnabled) BOOL enabled;
+
+/** Observers are held weakly. */
+- (void)addObserver:(nonnull id<TMDBRequestMetricsObserver>)observer;
+- (void)removeObserver:(nonnull id<TMDBRequestMetricsObserver>)observer;
+
+- (void)recordMetrics:(nonnull TMDBRequestMetrics *)metrics;
+
+/** Snapshots of the endpoints with at least one request, by endpoint. */
+- (nonnull NSDictionary<NSNumber *, TMDBRequestHistogram *> *)histograms;
+
+- (void)resetHistograms;
+
+@end
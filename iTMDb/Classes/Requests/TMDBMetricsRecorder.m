@@ -0,0 +1,116 @@
+//
+//  TMDBMetricsRecorder.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBMetricsRecorder.h"
+#import "TMDBRequestMetrics+Private.h"
+
+// The running totals of one endpoint
+typedef struct TMDBMetricsRecorderTotals {
+	NSUInteger requestCount;
+	NSUInteger cacheHitCount;
+	NSUInteger errorCount;
+	unsigned long long bytesReceived;
+	NSUInteger bucketCounts[TMDBRequestPhaseTotal + 1][TMDBRequestHistogramBucketCount];
+} TMDBMetricsRecorderTotals;
+
+@implementation TMDBMetricsRecorder {
+@private
+	NSHashTable<id<TMDBRequestMetricsObserver>> *_observers;
+	TMDBMetricsRecorderTotals _totals[TMDBCacheEndpointOther + 1];
+}
+
+@synthesize enabled=_enabled;
+
+- (instancetype)init {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_observers = [NSHashTable weakObjectsHashTable];
+
+	return self;
+}
+
+#pragma mark - Observers
+
+- (void)addObserver:(id<TMDBRequestMetricsObserver>)observer {
+	NSParameterAssert(observer != nil);
+
+	@synchronized(self) {
+		[_observers addObject:observer];
+		_enabled = YES;
+	}
+}
+
+- (void)removeObserver:(id<TMDBRequestMetricsObserver>)observer {
+	@synchronized(self) {
+		[_observers removeObject:observer];
+		_enabled = _observers.anyObject != nil;
+	}
+}
+
+- (void)recordMetrics:(TMDBRequestMetrics *)metrics {
+	NSArray<id<TMDBRequestMetricsObserver>> *observers = nil;
+	TMDBCacheEndpoint endpoint = MIN(metrics.endpoint, TMDBCacheEndpointOther);
+
+	@synchronized(self) {
+		TMDBMetricsRecorderTotals *totals = &_totals[endpoint];
+		totals->requestCount++;
+		totals->bytesReceived += metrics.bytesReceived;
+		if (metrics.cacheResult == TMDBRequestCacheResultHit) {
+			totals->cacheHitCount++;
+		}
+		if (metrics.error != nil) {
+			totals->errorCount++;
+		}
+
+		for (TMDBRequestPhase phase = 0; phase <= TMDBRequestPhaseTotal; phase++) {
+			totals->bucketCounts[phase][TMDBRequestHistogramBucketIndex([metrics durationOfPhase:phase])]++;
+		}
+
+		observers = _observers.allObjects;
+		// Observers deallocated without being removed
+		_enabled = observers.count > 0;
+	}
+
+	for (id<TMDBRequestMetricsObserver> observer in observers) {
+		[observer requestDidFinishWithMetrics:metrics];
+	}
+}
+
+#pragma mark - Histograms
+
+- (NSDictionary<NSNumber *, TMDBRequestHistogram *> *)histograms {
+	NSMutableDictionary *histograms = [NSMutableDictionary dictionary];
+
+	@synchronized(self) {
+		for (TMDBCacheEndpoint endpoint = 0; endpoint <= TMDBCacheEndpointOther; endpoint++) {
+			TMDBMetricsRecorderTotals *totals = &_totals[endpoint];
+			if (totals->requestCount == 0) {
+				continue;
+			}
+
+			histograms[@(endpoint)] = [[TMDBRequestHistogram alloc] initWithEndpoint:endpoint
+																		requestCount:totals->requestCount
+																	   cacheHitCount:totals->cacheHitCount
+																		  errorCount:totals->errorCount
+																	   bytesReceived:totals->bytesReceived
+																		bucketCounts:&totals->bucketCounts[0][0]];
+		}
+	}
+
+	return histograms;
+}
+
+- (void)resetHistograms {
+	@synchronized(self) {
+		memset(_totals, 0, sizeof(_totals));
+	}
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  TMDBRateLimiter.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+/**
+ * The default number of requests TMDb allows within `TMDBRateLimitDefaultWindow`.
+ */
+extern const NSUInteger TMDBRateLimitDefaultRequestsPerWindow;
+
+/**
+ * The default length, in seconds, of TMDb's rate limit window.
+ */
+extern const NSTimeInterval TMDBRateLimitDefaultWindow;
+
+// Private class
+@interface TMDBRateLimiter : NSObject
+
+/**
+ * Returns the rate limiter shared by all requests made with `apiKey`, creating
+ * it with the default limits if needed.
+ */
++ (nonnull instancetype)rateLimiterForAPIKey:(nullable NSString *)apiKey;
+
+/**
+ * Returns the rate limiter shared by all requests made with `apiKey`. The
+ * budget is only used if the limiter has to be created, so an existing
+ * limiter keeps the budget it has.
+ */
++ (nonnull instancetype)rateLimiterForAPIKey:(nullable NSString *)apiKey requestsPerWindow:(NSUInteger)requestsPerWindow window:(NSTimeInterval)window;
+
+- (nonnull instancetype)initWithRequestsPerWindow:(NSUInteger)requestsPerWindow window:(NSTimeInterval)window NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Changes the configured budget. A token spent is returned to the bucket one
+ * window later, so no more than `requestsPerWindow` requests are ever started
+ * within any `window` seconds.
+ */
+- (void)setRequestsPerWindow:(NSUInteger)requestsPerWindow window:(NSTimeInterval)window;
+
+@property (nonatomic, readonly) NSUInteger requestsPerWindow;
+@property (nonatomic, readonly) NSTimeInterval window;
+
+/**
+ * Calls `block` on a background queue once a token is available. Waiting
+ * blocks are served in the order they were enqueued.
+ */
+- (void)acquire:(nonnull dispatch_block_t)block;
+
+/**
+ * Like `acquire:`, but waiting blocks with a higher priority are served first.
+ * Blocks of the same priority are served in the order they were enqueued.
+ *
+ * @return A ticket for changing the priority of the wait or cancelling it.
+ */
+- (nonnull id)acquireWithPriority:(NSOperationQueuePriority)priority block:(nonnull dispatch_block_t)block;
+
+/** Moves a waiting ticket to its new priority. Does nothing once it has been served. */
+- (void)setPriority:(NSOperationQueuePriority)priority forTicket:(nonnull id)ticket;
+
+/**
+ * Spends a token right away if one is available and no other block is
+ * waiting, for requests that are only worth sending without delay.
+ *
+ * @return `YES` if a token was spent.
+ */
+- (BOOL)tryAcquire;
+
+/**
+ * Takes a waiting ticket out of line without spending a token, and calls its
+ * block right away so the caller can wind down. Does nothing once it has been
+ * served.
+ */
+- (void)cancelTicket:(nonnull id)ticket;
+
+/**
+ * Adjusts the limiter to a response from the API. A `429` response or an
+ * exhausted `X-RateLimit-Remaining` pauses the bucket until the server says
+ * requests may resume, and a `429` also shrinks the budget until requests
+ * succeed again.
+ *
+ * @return The number of seconds the caller should wait before retrying, or
+ * `0` if the response was not rate limited.
+ */
+- (NSTimeInterval)updateWithResponse:(nonnull NSHTTPURLResponse *)response;
+
+/**
+ * Returns the number of seconds asked for by the `Retry-After` header of
+ * `response`, or `0` if it has none.
+ */
++ (NSTimeInterval)retryAfterFromResponse:(nonnull NSHTTPURLResponse *)response;
+
+@end
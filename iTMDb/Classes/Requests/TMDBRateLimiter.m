@@ -0,0 +1,314 @@
+//
+//  TMDBRateLimiter.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRateLimiter.h"
+
+const NSUInteger TMDBRateLimitDefaultRequestsPerWindow = 40;
+const NSTimeInterval TMDBRateLimitDefaultWindow = 10.0;
+
+// The wait used when a 429 response carries no usable Retry-After header.
+static const NSTimeInterval TMDBRateLimitFallbackRetryAfter = 1.0;
+
+// Header names are case-insensitive, but allHeaderFields is not always
+// normalized on older systems.
+static id TMDBRateLimiterHeaderValue(NSDictionary *headers, NSString *name) {
+	id value = headers[name];
+	if (value != nil) {
+		return value;
+	}
+
+	for (NSString *key in headers) {
+		if ([key caseInsensitiveCompare:name] == NSOrderedSame) {
+			return headers[key];
+		}
+	}
+
+	return nil;
+}
+
+// Private class
+@interface TMDBRateLimiterTicket : NSObject
+
+@property (nonatomic, copy, nullable) dispatch_block_t block;
+@property (nonatomic) NSOperationQueuePriority priority;
+
+@end
+
+@implementation TMDBRateLimiterTicket
+@end
+
+#pragma mark -
+
+@implementation TMDBRateLimiter {
+@private
+	dispatch_queue_t _queue;
+
+	// Start times of the requests made within the last window, oldest first
+	NSMutableArray<NSNumber *> *_spent;
+	NSMutableArray<TMDBRateLimiterTicket *> *_waiting;
+
+	// The budget currently in effect. Lowered on 429s and raised again one
+	// request at a time as requests go through.
+	NSUInteger _effectiveLimit;
+	CFAbsoluteTime _pausedUntil;
+	BOOL _drainScheduled;
+}
+
+@synthesize requestsPerWindow=_requestsPerWindow, window=_window;
+
++ (instancetype)rateLimiterForAPIKey:(NSString *)apiKey {
+	return [self rateLimiterForAPIKey:apiKey requestsPerWindow:TMDBRateLimitDefaultRequestsPerWindow window:TMDBRateLimitDefaultWindow];
+}
+
++ (instancetype)rateLimiterForAPIKey:(NSString *)apiKey requestsPerWindow:(NSUInteger)requestsPerWindow window:(NSTimeInterval)window {
+	static NSMutableDictionary<NSString *, TMDBRateLimiter *> *limiters;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		limiters = [NSMutableDictionary dictionary];
+	});
+
+	NSString *key = apiKey ?: @"";
+
+	@synchronized(limiters) {
+		TMDBRateLimiter *limiter = limiters[key];
+		if (limiter == nil) {
+			limiter = [[self alloc] initWithRequestsPerWindow:requestsPerWindow window:window];
+			limiters[key] = limiter;
+		}
+		return limiter;
+	}
+}
+
+- (instancetype)init {
+	return (self = [self initWithRequestsPerWindow:TMDBRateLimitDefaultRequestsPerWindow window:TMDBRateLimitDefaultWindow]);
+}
+
+- (instancetype)initWithRequestsPerWindow:(NSUInteger)requestsPerWindow window:(NSTimeInterval)window {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_queue = dispatch_queue_create("dk.devify.tmdb.ratelimiter", DISPATCH_QUEUE_SERIAL);
+	_spent = [NSMutableArray array];
+	_waiting = [NSMutableArray array];
+	_requestsPerWindow = MAX(requestsPerWindow, (NSUInteger)1);
+	_window = MAX(window, 0.0);
+	_effectiveLimit = _requestsPerWindow;
+
+	return self;
+}
+
+#pragma mark - Configuration
+
+// Read on the queue, so a budget set just before is seen
+- (NSUInteger)requestsPerWindow {
+	__block NSUInteger requestsPerWindow;
+	dispatch_sync(_queue, ^{
+		requestsPerWindow = _requestsPerWindow;
+	});
+	return requestsPerWindow;
+}
+
+- (NSTimeInterval)window {
+	__block NSTimeInterval window;
+	dispatch_sync(_queue, ^{
+		window = _window;
+	});
+	return window;
+}
+
+- (void)setRequestsPerWindow:(NSUInteger)requestsPerWindow window:(NSTimeInterval)window {
+	dispatch_async(_queue, ^{
+		_requestsPerWindow = MAX(requestsPerWindow, (NSUInteger)1);
+		_window = MAX(window, 0.0);
+		_effectiveLimit = _requestsPerWindow;
+		[self drain];
+	});
+}
+
+#pragma mark - Acquiring Tokens
+
+- (void)acquire:(dispatch_block_t)block {
+	[self acquireWithPriority:NSOperationQueuePriorityNormal block:block];
+}
+
+- (id)acquireWithPriority:(NSOperationQueuePriority)priority block:(dispatch_block_t)block {
+	NSParameterAssert(block != nil);
+
+	TMDBRateLimiterTicket *ticket = [[TMDBRateLimiterTicket alloc] init];
+	ticket.block = block;
+	ticket.priority = priority;
+
+	dispatch_async(_queue, ^{
+		[_waiting addObject:ticket];
+		[self drain];
+	});
+
+	return ticket;
+}
+
+- (void)setPriority:(NSOperationQueuePriority)priority forTicket:(id)ticket {
+	dispatch_async(_queue, ^{
+		((TMDBRateLimiterTicket *)ticket).priority = priority;
+	});
+}
+
+- (void)cancelTicket:(id)ticket {
+	dispatch_async(_queue, ^{
+		TMDBRateLimiterTicket *waitingTicket = ticket;
+		dispatch_block_t block = waitingTicket.block;
+		if (block == nil) {
+			return;
+		}
+
+		waitingTicket.block = nil;
+		[_waiting removeObjectIdenticalTo:waitingTicket];
+
+		dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), block);
+	});
+}
+
+- (BOOL)tryAcquire {
+	__block BOOL acquired = NO;
+
+	dispatch_sync(_queue, ^{
+		CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+
+		while (_spent.count > 0 && _spent.firstObject.doubleValue + _window <= now) {
+			[_spent removeObjectAtIndex:0];
+		}
+
+		if (_waiting.count == 0 && now >= _pausedUntil && _spent.count < _effectiveLimit) {
+			[_spent addObject:@(now)];
+			acquired = YES;
+		}
+	});
+
+	return acquired;
+}
+
+// Must be called on _queue. The first of the tickets with the highest priority.
+- (NSUInteger)indexOfNextTicket {
+	NSUInteger nextIndex = 0;
+	NSOperationQueuePriority nextPriority = _waiting[0].priority;
+
+	for (NSUInteger i = 1; i < _waiting.count; i++) {
+		if (_waiting[i].priority > nextPriority) {
+			nextIndex = i;
+			nextPriority = _waiting[i].priority;
+		}
+	}
+
+	return nextIndex;
+}
+
+// Must be called on _queue
+- (void)drain {
+	CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+
+	while (_spent.count > 0 && _spent.firstObject.doubleValue + _window <= now) {
+		[_spent removeObjectAtIndex:0];
+	}
+
+	while (_waiting.count > 0 && now >= _pausedUntil && _spent.count < _effectiveLimit) {
+		NSUInteger index = [self indexOfNextTicket];
+		dispatch_block_t block = _waiting[index].block;
+		_waiting[index].block = nil;
+		[_waiting removeObjectAtIndex:index];
+		[_spent addObject:@(now)];
+
+		dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), block);
+	}
+
+	if (_waiting.count == 0 || _drainScheduled) {
+		return;
+	}
+
+	// Wake up again when the next token is returned, or the pause ends
+	CFAbsoluteTime wakeUp = _pausedUntil;
+	if (now >= _pausedUntil) {
+		NSUInteger overLimit = _spent.count - _effectiveLimit;
+		wakeUp = _spent[overLimit].doubleValue + _window;
+	}
+
+	_drainScheduled = YES;
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(MAX(wakeUp - now, 0.0) * NSEC_PER_SEC)), _queue, ^{
+		_drainScheduled = NO;
+		[self drain];
+	});
+}
+
+#pragma mark - Adapting to Responses
+
+- (NSTimeInterval)updateWithResponse:(NSHTTPURLResponse *)response {
+	NSDictionary *headers = response.allHeaderFields;
+	CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+	NSTimeInterval retryAfter = 0.0;
+	CFAbsoluteTime pauseUntil = 0.0;
+
+	NSString *limitHeader = TMDB_NSStringOrNil([self valueForHeader:@"X-RateLimit-Limit" inHeaders:headers]);
+	NSString *remainingHeader = TMDB_NSStringOrNil([self valueForHeader:@"X-RateLimit-Remaining" inHeaders:headers]);
+	NSString *resetHeader = TMDB_NSStringOrNil([self valueForHeader:@"X-RateLimit-Reset" inHeaders:headers]);
+
+	if (remainingHeader != nil && remainingHeader.integerValue <= 0 && resetHeader != nil) {
+		// The reset header is a Unix timestamp
+		NSTimeInterval untilReset = resetHeader.doubleValue - [NSDate date].timeIntervalSince1970;
+		if (untilReset > 0) {
+			pauseUntil = now + untilReset;
+		}
+	}
+
+	if (response.statusCode == 429) {
+		retryAfter = [self retryAfterFromHeaders:headers];
+		pauseUntil = MAX(pauseUntil, now + retryAfter);
+	}
+
+	NSUInteger serverLimit = (NSUInteger)MAX(limitHeader.integerValue, 0);
+	BOOL rateLimited = response.statusCode == 429;
+
+	dispatch_async(_queue, ^{
+		if (rateLimited) {
+			_effectiveLimit = MAX(_effectiveLimit / 2, (NSUInteger)1);
+		}
+		else if (_effectiveLimit < _requestsPerWindow) {
+			_effectiveLimit++;
+		}
+
+		if (serverLimit > 0 && serverLimit < _effectiveLimit) {
+			_effectiveLimit = serverLimit;
+		}
+
+		_pausedUntil = MAX(_pausedUntil, pauseUntil);
+
+		[self drain];
+	});
+
+	return rateLimited ? retryAfter : 0.0;
+}
+
+- (NSTimeInterval)retryAfterFromHeaders:(NSDictionary *)headers {
+	NSString *retryAfter = TMDB_NSStringOrNil([self valueForHeader:@"Retry-After" inHeaders:headers]);
+
+	if (retryAfter.doubleValue > 0) {
+		return retryAfter.doubleValue;
+	}
+
+	return TMDBRateLimitFallbackRetryAfter;
+}
+
++ (NSTimeInterval)retryAfterFromResponse:(NSHTTPURLResponse *)response {
+	NSString *retryAfter = TMDB_NSStringOrNil(TMDBRateLimiterHeaderValue(response.allHeaderFields, @"Retry-After"));
+
+	return MAX(retryAfter.doubleValue, 0.0);
+}
+
+- (id)valueForHeader:(NSString *)name inHeaders:(NSDictionary *)headers {
+	return TMDBRateLimiterHeaderValue(headers, name);
+}
+
+@end
\ No newline at end of file
@@ -8,7 +8,49 @@
 
 @import Foundation;
 
+#import "TMDBTransport.h"
+
 typedef void (^TMDBRequestCompletionBlock)(id _Nullable parsedData, NSError * _Nullable error);
+typedef void (^TMDBRequestDataBlock)(NSData * _Nonnull data);
+
+@class TMDB;
+@class TMDBRequest;
+
+/**
+ * A single caller's interest in a request. Identical requests made while one
+ * is already in flight share the same `TMDBRequest`, and each caller gets its
+ * own subscription.
+ */
+// Private class
+@interface TMDBRequestSubscription : NSObject
+
+@property (nonatomic, strong, nonnull, readonly) TMDBRequest *request;
+
+/**
+ * The priority of the subscription. The shared request waits for the rate
+ * limiter at the highest priority of its subscriptions.
+ */
+@property (atomic) NSOperationQueuePriority priority;
+
+/**
+ * The time by which the subscription's completion block must have been
+ * called, or `0` for none. Once it has passed, the block is called with
+ * `NSURLErrorTimedOut` and the subscription is cancelled. Defaults to the
+ * `timeout` of the request's retry policy, counted from subscribing.
+ *
+ * The request stops retrying once the latest deadline of its subscriptions
+ * would be missed.
+ */
+@property (atomic) CFAbsoluteTime deadline;
+
+/**
+ * Stops the subscription's completion block from being called. The shared
+ * request is only cancelled once no other subscriptions are left, which stops
+ * its transfer right away and skips decoding the response.
+ */
+- (void)cancel;
+
+@end
 
 // Private class
 @interface TMDBRequest : NSOperation
@@ -16,26 +58,89 @@ typedef void (^TMDBRequestCompletionBlock)(id _Nullable parsedData, NSError * _N
 + (nonnull NSOperationQueue *)operationQueue;
 
 /**
- * Creates and returns a new request operation, and adds it to the operation
- * queue.
+ * The concurrent background queue on which responses are decoded and
+ * completion blocks are called. Completion blocks should do their own
+ * processing, such as populating model objects, right there and only hop to
+ * the caller's completion queue at the very end.
+ */
++ (nonnull dispatch_queue_t)workQueue;
+
+/**
+ * The transport used to load requests. Defaults to a transport backed by a
+ * shared `NSURLSession`, which delivers its callbacks on a background queue.
+ */
++ (nonnull id<TMDBTransport>)transport;
++ (void)setTransport:(nullable id<TMDBTransport>)transport;
+
+/**
+ * Subscribes to the request for `url` through the shared context.
+ */
++ (nullable TMDBRequestSubscription *)requestWithURL:(nonnull NSURL *)url completionBlock:(nullable TMDBRequestCompletionBlock)block;
+
+/**
+ * Subscribes to the request for `url`. If an identical request is already in
+ * flight, the completion block is attached to it. Otherwise a new request
+ * operation is created and added to the operation queue.
+ *
+ * A new request uses the response cache and retry policy of `context`, or of
+ * the shared instance if `nil`. The rate limiter is picked by the API key in
+ * `url`. Requests are identified by their URL, which includes the API key and
+ * language, so only contexts with the same key and language share requests.
+ */
++ (nullable TMDBRequestSubscription *)requestWithURL:(nonnull NSURL *)url context:(nullable TMDB *)context completionBlock:(nullable TMDBRequestCompletionBlock)block;
+
+/**
+ * Like `requestWithURL:context:completionBlock:`, but also calls `dataBlock`
+ * with each chunk of a successful response body as it arrives, on a serial
+ * background queue.
+ *
+ * The data block is only attached if the body hasn't started arriving yet.
+ * Responses served from the cache, or joined halfway through, only call the
+ * completion block, so callers must be prepared to do all of their work there.
  */
-+ (nullable instancetype)requestWithURL:(nonnull NSURL *)url completionBlock:(nullable TMDBRequestCompletionBlock)block;
++ (nullable TMDBRequestSubscription *)requestWithURL:(nonnull NSURL *)url context:(nullable TMDB *)context dataBlock:(nullable TMDBRequestDataBlock)dataBlock completionBlock:(nullable TMDBRequestCompletionBlock)block;
 
 /**
- * Instantiates a new request operation. You are responsible for adding it to
- * the operation queue.
+ * Returns a string identifying `url` regardless of the order of its query
+ * parameters, leaving out the parameters named in `excludedNames`.
  */
-- (nullable instancetype)initWithURL:(nonnull NSURL *)url completionBlock:(nullable TMDBRequestCompletionBlock)block NS_DESIGNATED_INITIALIZER;
++ (nonnull NSString *)canonicalStringForURL:(nonnull NSURL *)url excludingQueryItems:(nullable NSSet<NSString *> *)excludedNames;
+
+/**
+ * Instantiates a new request operation through the shared context. You are
+ * responsible for adding it to the operation queue.
+ */
+- (nullable instancetype)initWithURL:(nonnull NSURL *)url completionBlock:(nullable TMDBRequestCompletionBlock)block;
+
+/**
+ * Instantiates a new request operation through `context`, or the shared
+ * instance if `nil`. You are responsible for adding it to the operation queue.
+ */
+- (nullable instancetype)initWithURL:(nonnull NSURL *)url context:(nullable TMDB *)context completionBlock:(nullable TMDBRequestCompletionBlock)block NS_DESIGNATED_INITIALIZER;
 
 - (nullable instancetype)init NS_UNAVAILABLE;
 
 /**
- * The completion block passed during initialization.
+ * Adds another completion block. Completion blocks are called on the work
+ * queue, in the order they were added, with the same parsed data.
+ *
+ * @return A subscription for the block, or `nil` if the request has already
+ * finished or been cancelled.
  */
-@property (nonatomic, copy, nullable, readonly) TMDBRequestCompletionBlock requestCompletionBlock;
+- (nullable TMDBRequestSubscription *)addCompletionBlock:(nonnull TMDBRequestCompletionBlock)block;
+
+/**
+ * Adds another completion block, together with a block receiving the response
+ * body as it arrives. The data block is dropped if part of the body has
+ * already been delivered.
+ */
+- (nullable TMDBRequestSubscription *)addCompletionBlock:(nonnull TMDBRequestCompletionBlock)block dataBlock:(nullable TMDBRequestDataBlock)dataBlock;
 
 @property (nonatomic, copy, nullable, readonly) NSURL *url;
 
+/** The context the request was created through. */
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
+
 @property (nonatomic, copy, nullable, readonly) NSURLResponse *response;
 @property (nonatomic, copy, nullable, readonly) NSError *error;
 @property (nonatomic, strong, nullable, readonly) id parsedData;
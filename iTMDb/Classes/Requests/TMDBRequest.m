@@ -8,16 +8,153 @@
 
 #import "TMDBRequest.h"
 #import "TMDBError.h"
+#import "TMDBURLSessionTransport.h"
+#import "TMDBRateLimiter.h"
+#import "TMDBResponseCache.h"
+#import "TMDB+Private.h"
+#import "TMDBRetryBudget.h"
+#import "TMDBMetricsRecorder.h"
+#import "TMDBRequestMetrics+Private.h"
 
-// TODO: Replace with NSURLSession
-@interface TMDBRequest () <NSURLConnectionDelegate, NSURLConnectionDataDelegate>
+// The number of times a request is sent again after being rate limited.
+static const NSUInteger TMDBRequestMaximumRateLimitRetries = 3;
+
+@interface TMDBRequest () <TMDBTransportDelegate>
+
+- (BOOL)removeSubscription:(nonnull TMDBRequestSubscription *)subscription;
+- (void)expireSubscription:(nonnull TMDBRequestSubscription *)subscription;
+- (void)updatePriority;
+
+@end
+
+@interface TMDBRequestSubscription ()
+
+- (nonnull instancetype)initWithRequest:(nonnull TMDBRequest *)request block:(nonnull TMDBRequestCompletionBlock)block dataBlock:(nullable TMDBRequestDataBlock)dataBlock;
+
+@property (nonatomic, copy, nonnull, readonly) TMDBRequestCompletionBlock block;
+@property (nonatomic, copy, nullable, readonly) TMDBRequestDataBlock dataBlock;
+
+- (void)scheduleExpiry;
+
+@end
+
+static id<TMDBTransport> TMDBRequestTransport = nil;
+
+// In-flight requests by canonical URL. Also guards the subscriptions of every
+// request, so attaching to a request can't race with it finishing.
+static NSMutableDictionary<NSString *, TMDBRequest *> *TMDBRequestsInFlight(void) {
+	static NSMutableDictionary *requests;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		requests = [NSMutableDictionary dictionary];
+	});
+	return requests;
+}
+
+@implementation TMDBRequestSubscription {
+@private
+	NSOperationQueuePriority _priority;
+	CFAbsoluteTime _deadline;
+}
+
+- (instancetype)initWithRequest:(TMDBRequest *)request block:(TMDBRequestCompletionBlock)block dataBlock:(TMDBRequestDataBlock)dataBlock {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_request = request;
+	_block = [block copy];
+	_dataBlock = [dataBlock copy];
+
+	return self;
+}
+
+- (NSOperationQueuePriority)priority {
+	@synchronized(self) {
+		return _priority;
+	}
+}
+
+- (void)setPriority:(NSOperationQueuePriority)priority {
+	@synchronized(self) {
+		if (_priority == priority) {
+			return;
+		}
+		_priority = priority;
+	}
+
+	[_request updatePriority];
+}
+
+- (CFAbsoluteTime)deadline {
+	@synchronized(self) {
+		return _deadline;
+	}
+}
+
+- (void)setDeadline:(CFAbsoluteTime)deadline {
+	@synchronized(self) {
+		_deadline = deadline;
+	}
+
+	if (deadline > 0) {
+		[self scheduleExpiry];
+	}
+}
+
+- (void)scheduleExpiry {
+	NSTimeInterval remaining = self.deadline - CFAbsoluteTimeGetCurrent();
+	__weak TMDBRequestSubscription *weakSelf = self;
+
+	// Held weakly, so the timer doesn't keep a finished request around
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(MAX(remaining, 0.0) * NSEC_PER_SEC)), [TMDBRequest workQueue], ^{
+		TMDBRequestSubscription *subscription = weakSelf;
+		[subscription.request expireSubscription:subscription];
+	});
+}
+
+- (void)cancel {
+	[_request removeSubscription:self];
+}
 
 @end
 
 @implementation TMDBRequest {
 @private
+	NSString *_canonicalURLString;
+	NSMutableArray<TMDBRequestSubscription *> *_subscriptions;
+	BOOL _closed;
+	BOOL _streaming;
+	BOOL _streamStarted;
+
 	NSMutableData *_responseData;
 	id _parsedData;
+	id<TMDBTransportTask> _task;
+	TMDBRateLimiter *_rateLimiter;
+	id _rateLimiterTicket;
+	NSUInteger _rateLimitRetries;
+	BOOL _rateLimited;
+
+	TMDBRetryPolicy *_retryPolicy;
+	TMDBCacheEndpoint _endpoint;
+	NSURLRequest *_transportRequest;
+	NSInteger _statusCode;
+	NSUInteger _retries;
+	// Counts attempts, so a hedge scheduled for an earlier attempt can tell
+	NSUInteger _attempt;
+	CFAbsoluteTime _attemptStart;
+	id<TMDBTransportTask> _hedgeTask;
+	// Whichever of _task and _hedgeTask responded first
+	id<TMDBTransportTask> _respondingTask;
+
+	// Only created while metrics are being observed
+	TMDBRequestMetrics *_metrics;
+	CFAbsoluteTime _responseAt;
+
+	TMDBResponseCache *_cache;
+	TMDBCachedResponse *_cachedResponse;
+	BOOL _notModified;
+	BOOL _responseFromCache;
 }
 
 @synthesize executing=_isExecuting, finished=_isFinished;
@@ -28,15 +165,112 @@
 	dispatch_once(&onceToken, ^{
 		sharedQueue = [[NSOperationQueue alloc] init];
 		sharedQueue.name = [NSStringFromClass(self) stringByAppendingString:@"Queue"];
-		sharedQueue.maxConcurrentOperationCount = 4; // TODO: Do time-based throttling to compensate for TMDb's rate limiting
+		// Requests are throttled by the rate limiter of their API key, so the
+		// queue itself doesn't need to hold them back.
+		sharedQueue.maxConcurrentOperationCount = NSOperationQueueDefaultMaxConcurrentOperationCount;
 	});
 	return sharedQueue;
 }
 
-+ (instancetype)requestWithURL:(NSURL *)url completionBlock:(TMDBRequestCompletionBlock)block {
-	TMDBRequest *request = [[TMDBRequest alloc] initWithURL:url completionBlock:block];
++ (dispatch_queue_t)workQueue {
+	static dispatch_queue_t workQueue;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		workQueue = dispatch_queue_create("dk.devify.tmdb.work", DISPATCH_QUEUE_CONCURRENT);
+	});
+	return workQueue;
+}
+
++ (id<TMDBTransport>)transport {
+	@synchronized(self) {
+		if (TMDBRequestTransport == nil) {
+			TMDBRequestTransport = [TMDBURLSessionTransport sharedTransport];
+		}
+		return TMDBRequestTransport;
+	}
+}
+
++ (void)setTransport:(id<TMDBTransport>)transport {
+	@synchronized(self) {
+		TMDBRequestTransport = transport;
+	}
+}
+
++ (NSString *)apiKeyFromURL:(NSURL *)url {
+	for (NSString *pair in [url.query componentsSeparatedByString:@"&"]) {
+		if ([pair hasPrefix:@"api_key="]) {
+			return [pair substringFromIndex:@"api_key=".length];
+		}
+	}
+
+	return nil;
+}
+
++ (NSString *)canonicalStringForURL:(NSURL *)url excludingQueryItems:(NSSet<NSString *> *)excludedNames {
+	NSMutableArray *pairs = [NSMutableArray array];
+
+	for (NSString *pair in [url.query componentsSeparatedByString:@"&"]) {
+		if (pair.length == 0) {
+			continue;
+		}
+
+		NSString *name = [pair componentsSeparatedByString:@"="].firstObject;
+		if ([excludedNames containsObject:name]) {
+			continue;
+		}
+
+		[pairs addObject:pair];
+	}
+
+	[pairs sortUsingSelector:@selector(compare:)];
+
+	NSMutableString *string = [NSMutableString stringWithFormat:@"%@://%@", url.scheme.lowercaseString, url.host.lowercaseString];
+	if (url.port != nil) {
+		[string appendFormat:@":%@", url.port];
+	}
+	[string appendString:url.path ?: @""];
+
+	if (pairs.count > 0) {
+		[string appendFormat:@"?%@", [pairs componentsJoinedByString:@"&"]];
+	}
+
+	return string;
+}
+
++ (TMDBRequestSubscription *)requestWithURL:(NSURL *)url completionBlock:(TMDBRequestCompletionBlock)block {
+	return [self requestWithURL:url context:nil dataBlock:nil completionBlock:block];
+}
+
++ (TMDBRequestSubscription *)requestWithURL:(NSURL *)url context:(TMDB *)context completionBlock:(TMDBRequestCompletionBlock)block {
+	return [self requestWithURL:url context:context dataBlock:nil completionBlock:block];
+}
+
++ (TMDBRequestSubscription *)requestWithURL:(NSURL *)url context:(TMDB *)context dataBlock:(TMDBRequestDataBlock)dataBlock completionBlock:(TMDBRequestCompletionBlock)block {
+	NSString *key = [self canonicalStringForURL:url excludingQueryItems:nil];
+	TMDBRequestCompletionBlock subscriberBlock = block ?: ^(id parsedData, NSError *error) {};
+	NSMutableDictionary *requestsInFlight = TMDBRequestsInFlight();
+
+	TMDBRequest *request = nil;
+	TMDBRequestSubscription *subscription = nil;
+
+	@synchronized(requestsInFlight) {
+		TMDBRequest *existingRequest = requestsInFlight[key];
+		if (existingRequest != nil && !existingRequest.isCancelled) {
+			subscription = [existingRequest addCompletionBlock:subscriberBlock dataBlock:dataBlock];
+			if (subscription != nil) {
+				return subscription;
+			}
+		}
+
+		request = [[TMDBRequest alloc] initWithURL:url context:context completionBlock:nil];
+		request->_canonicalURLString = key;
+		subscription = [request addCompletionBlock:subscriberBlock dataBlock:dataBlock];
+		requestsInFlight[key] = request;
+	}
+
 	[[TMDBRequest operationQueue] addOperation:request];
-	return request;
+
+	return subscription;
 }
 
 - (nullable instancetype)init {
@@ -45,6 +279,10 @@
 }
 
 - (instancetype)initWithURL:(NSURL *)url completionBlock:(TMDBRequestCompletionBlock)block {
+	return (self = [self initWithURL:url context:nil completionBlock:block]);
+}
+
+- (instancetype)initWithURL:(NSURL *)url context:(TMDB *)context completionBlock:(TMDBRequestCompletionBlock)block {
 	NSParameterAssert(url != nil);
 
 	if (!(self = [super init])) {
@@ -53,42 +291,402 @@
 
 	self.name = url.description;
 	_url = [url copy];
-	_requestCompletionBlock = [block copy];
+	_context = context ?: [TMDB sharedInstance];
+	_subscriptions = [NSMutableArray array];
+	_retryPolicy = _context.retryPolicy;
+	_endpoint = [TMDBResponseCache endpointForURL:_url];
+
+	TMDBMetricsRecorder *recorder = [_context metricsRecorder];
+	if (recorder.isEnabled) {
+		NSString *urlString = [TMDBRequest canonicalStringForURL:_url excludingQueryItems:[NSSet setWithObject:@"api_key"]];
+		_metrics = [[TMDBRequestMetrics alloc] initWithURLString:urlString endpoint:_endpoint recorder:recorder];
+	}
+
+	if (block != nil) {
+		[self addCompletionBlock:block];
+	}
 
 	return self;
 }
 
+#pragma mark - Subscriptions
+
+- (TMDBRequestSubscription *)addCompletionBlock:(TMDBRequestCompletionBlock)block {
+	return [self addCompletionBlock:block dataBlock:nil];
+}
+
+- (TMDBRequestSubscription *)addCompletionBlock:(TMDBRequestCompletionBlock)block dataBlock:(TMDBRequestDataBlock)dataBlock {
+	NSParameterAssert(block != nil);
+
+	@synchronized(TMDBRequestsInFlight()) {
+		if (_closed) {
+			return nil;
+		}
+
+		// A data block joining halfway through the body would only see its tail.
+		if (_streamStarted) {
+			dataBlock = nil;
+		}
+
+		TMDBRequestSubscription *subscription = [[TMDBRequestSubscription alloc] initWithRequest:self block:block dataBlock:dataBlock];
+		[_subscriptions addObject:subscription];
+
+		if (_retryPolicy.timeout > 0) {
+			subscription.deadline = CFAbsoluteTimeGetCurrent() + _retryPolicy.timeout;
+		}
+
+		return subscription;
+	}
+}
+
+- (void)updatePriority {
+	NSOperationQueuePriority priority = NSOperationQueuePriorityVeryLow;
+
+	@synchronized(TMDBRequestsInFlight()) {
+		if (_subscriptions.count == 0) {
+			return;
+		}
+
+		for (TMDBRequestSubscription *subscription in _subscriptions) {
+			priority = MAX(priority, subscription.priority);
+		}
+	}
+
+	if (priority == self.queuePriority) {
+		return;
+	}
+
+	self.queuePriority = priority;
+
+	id ticket = nil;
+	@synchronized(self) {
+		ticket = _rateLimiterTicket;
+	}
+
+	if (ticket != nil) {
+		[_rateLimiter setPriority:priority forTicket:ticket];
+	}
+}
+
+- (BOOL)removeSubscription:(TMDBRequestSubscription *)subscription {
+	BOOL cancel = NO;
+	NSMutableDictionary *requestsInFlight = TMDBRequestsInFlight();
+
+	@synchronized(requestsInFlight) {
+		if (_closed || ![_subscriptions containsObject:subscription]) {
+			return NO;
+		}
+
+		[_subscriptions removeObjectIdenticalTo:subscription];
+
+		if (_subscriptions.count == 0) {
+			// Nobody is interested anymore, so make sure later callers start
+			// a fresh request instead of attaching to a cancelled one.
+			if (_canonicalURLString != nil && requestsInFlight[_canonicalURLString] == self) {
+				[requestsInFlight removeObjectForKey:_canonicalURLString];
+			}
+			cancel = YES;
+		}
+	}
+
+	if (cancel) {
+		[self cancel];
+	}
+	else {
+		[self updatePriority];
+	}
+
+	return YES;
+}
+
+- (void)expireSubscription:(TMDBRequestSubscription *)subscription {
+	CFAbsoluteTime deadline = subscription.deadline;
+	if (deadline <= 0) {
+		return;
+	}
+
+	// The deadline may have been moved since the timer was set
+	if (CFAbsoluteTimeGetCurrent() < deadline) {
+		[subscription scheduleExpiry];
+		return;
+	}
+
+	if ([self removeSubscription:subscription]) {
+		TMDBLog(@"iTMDb: Deadline passed for %@", self.url);
+		NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+		subscription.block(nil, error);
+	}
+}
+
+// The latest deadline of the subscriptions, or 0 if any of them has none
+- (CFAbsoluteTime)latestDeadline {
+	CFAbsoluteTime latestDeadline = 0;
+
+	@synchronized(TMDBRequestsInFlight()) {
+		for (TMDBRequestSubscription *subscription in _subscriptions) {
+			CFAbsoluteTime deadline = subscription.deadline;
+			if (deadline <= 0) {
+				return 0;
+			}
+			latestDeadline = MAX(latestDeadline, deadline);
+		}
+	}
+
+	return latestDeadline;
+}
+
 #pragma mark - NSOperation
 
 - (BOOL)isAsynchronous {
 	return YES;
 }
 
+- (void)cancel {
+	[super cancel];
+
+	id<TMDBTransportTask> task = nil;
+	id<TMDBTransportTask> hedgeTask = nil;
+	id ticket = nil;
+	@synchronized(self) {
+		task = _task;
+		hedgeTask = _hedgeTask;
+		ticket = _rateLimiterTicket;
+	}
+
+	// Stop the transfer rather than waiting for the next callback, and give
+	// up a place in line for the rate limiter without spending a token.
+	[task cancel];
+	[hedgeTask cancel];
+	if (ticket != nil) {
+		[_rateLimiter cancelTicket:ticket];
+	}
+}
+
 - (void)start {
 	if (self.isCancelled) {
 		[self finish];
 		return;
 	}
 
+	// Mark the operation as executing before the transport gets a chance to
+	// call back on its own queue.
+	TMDBSetIvarValue(isExecuting, _isExecuting, YES);
+	TMDBSetIvarValue(isFinished, _isFinished, NO);
+
+	// A fresh cached response doesn't cost a request at all, while a stale one
+	// is revalidated when the request is sent.
+	_cache = _context.responseCache;
+	_cachedResponse = [_cache cachedResponseForURL:self.url];
+
+	if (_cachedResponse.isFresh) {
+		[_metrics setCacheResult:TMDBRequestCacheResultHit];
+		[self useCachedResponse];
+		[self finish];
+		return;
+	}
+
+	_rateLimiter = [TMDBRateLimiter rateLimiterForAPIKey:[TMDBRequest apiKeyFromURL:self.url]];
+
+	[self acquireRateLimiterToken];
+}
+
+- (void)acquireRateLimiterToken {
+	id ticket = [_rateLimiter acquireWithPriority:self.queuePriority block:^{
+		[self startTransportTask];
+	}];
+
+	@synchronized(self) {
+		// The block may already have run, in which case the ticket is spent
+		// and cancelling it does nothing.
+		_rateLimiterTicket = ticket;
+	}
+
+	if (self.isCancelled) {
+		[_rateLimiter cancelTicket:ticket];
+	}
+}
+
+- (void)startTransportTask {
+	@synchronized(self) {
+		_rateLimiterTicket = nil;
+	}
+
+	if (self.isCancelled) {
+		[self finish];
+		return;
+	}
+
 	_responseData = [NSMutableData data];
+	_rateLimited = NO;
+	_notModified = NO;
+	_streaming = NO;
+	_statusCode = 0;
+
+	// An attempt may not outlast the deadline of the request
+	NSTimeInterval timeout = _retryPolicy.attemptTimeout > 0 ? _retryPolicy.attemptTimeout : 30.0;
+	CFAbsoluteTime deadline = [self latestDeadline];
+	if (deadline > 0) {
+		timeout = MAX(MIN(timeout, deadline - CFAbsoluteTimeGetCurrent()), 0.1);
+	}
 
 	NSMutableURLRequest *req = [NSMutableURLRequest requestWithURL:self.url
-													   cachePolicy:NSURLRequestUseProtocolCachePolicy
-												   timeoutInterval:30.0];
+													   cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+												   timeoutInterval:timeout];
 
-	NSURLConnection *conn = [[NSURLConnection alloc] initWithRequest:req
-															delegate:self
-													startImmediately:NO];
+	if (_cachedResponse.entityTag != nil) {
+		[req setValue:_cachedResponse.entityTag forHTTPHeaderField:@"If-None-Match"];
+	}
+	if (_cachedResponse.lastModified != nil) {
+		[req setValue:_cachedResponse.lastModified forHTTPHeaderField:@"If-Modified-Since"];
+	}
 
-	[conn scheduleInRunLoop:[NSRunLoop mainRunLoop] forMode:NSDefaultRunLoopMode];
-	[conn start];
+	_transportRequest = [req copy];
+	_attemptStart = CFAbsoluteTimeGetCurrent();
+	_responseAt = 0;
+	[_metrics setDuration:_attemptStart - _metrics.createdAt forPhase:TMDBRequestPhaseQueueWait];
+	[_metrics setDuration:0 forPhase:TMDBRequestPhaseConnect];
 
-	TMDBSetIvarValue(isExecuting, _isExecuting, YES);
-	TMDBSetIvarValue(isFinished, _isFinished, NO);
+	id<TMDBTransportTask> task = [[TMDBRequest transport] startTaskWithRequest:req delegate:self];
+	NSUInteger attempt;
+
+	@synchronized(self) {
+		_task = task;
+		attempt = _attempt;
+	}
+
+	if (task == nil) {
+		_responseData = nil;
+		NSError *error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeInvalidURL userInfo:nil];
+		TMDBSetValue(error, error);
+		[self finish];
+	}
+	else if (self.isCancelled) {
+		// Cancelled while the task was being started
+		[task cancel];
+	}
+	else {
+		[self scheduleHedgeForAttempt:attempt];
+	}
+}
+
+#pragma mark - Retrying
+
+- (void)scheduleHedgeForAttempt:(NSUInteger)attempt {
+	if (_retryPolicy.hedgingPercentile <= 0 || _streamStarted) {
+		return;
+	}
+
+	NSTimeInterval delay = [[_context latencyTracker] latencyAtPercentile:_retryPolicy.hedgingPercentile forEndpoint:_endpoint];
+	if (delay <= 0) {
+		return;
+	}
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), [TMDBRequest workQueue], ^{
+		[self hedgeAttempt:attempt];
+	});
+}
+
+- (BOOL)canHedgeAttempt:(NSUInteger)attempt {
+	@synchronized(self) {
+		return attempt == _attempt && _task != nil && _hedgeTask == nil && _respondingTask == nil;
+	}
+}
+
+// Sends the same request again if the attempt is still waiting for a response
+- (void)hedgeAttempt:(NSUInteger)attempt {
+	if (self.isCancelled || ![self canHedgeAttempt:attempt]) {
+		return;
+	}
+
+	// A hedge is only worth sending right away, so it doesn't wait in line
+	// for the rate limiter.
+	TMDBRetryBudget *budget = [_context retryBudget];
+	if (![budget withdraw]) {
+		return;
+	}
+	if (![_rateLimiter tryAcquire]) {
+		[budget depositWithRatio:1.0];
+		return;
+	}
+
+	TMDBLog(@"iTMDb: Hedging %@", self.url);
+
+	id<TMDBTransportTask> hedgeTask = [[TMDBRequest transport] startTaskWithRequest:_transportRequest delegate:self];
+	BOOL started = NO;
+
+	@synchronized(self) {
+		if (hedgeTask != nil && attempt == _attempt && _task != nil && _respondingTask == nil) {
+			_hedgeTask = hedgeTask;
+			[_metrics setHedged:YES];
+			started = YES;
+		}
+	}
+
+	if (!started) {
+		[hedgeTask cancel];
+	}
+}
+
+- (BOOL)isRetryableError:(NSError *)error {
+	if (error == nil) {
+		return _statusCode == 500 || _statusCode == 502 || _statusCode == 503 || _statusCode == 504;
+	}
+
+	if (![error.domain isEqualToString:NSURLErrorDomain]) {
+		return NO;
+	}
+
+	switch (error.code) {
+		case NSURLErrorTimedOut:
+		case NSURLErrorCannotFindHost:
+		case NSURLErrorCannotConnectToHost:
+		case NSURLErrorNetworkConnectionLost:
+		case NSURLErrorDNSLookupFailed:
+		case NSURLErrorNotConnectedToInternet:
+		case NSURLErrorResourceUnavailable:
+			return YES;
+		default:
+			return NO;
+	}
+}
+
+// The wait before the next retry, with full jitter, or a negative value if
+// the request shouldn't be retried.
+- (NSTimeInterval)delayBeforeRetryingError:(NSError *)error {
+	// Body chunks already handed to data blocks can't be taken back
+	if (self.isCancelled || _streamStarted || _retries >= _retryPolicy.maximumRetries || ![self isRetryableError:error]) {
+		return -1;
+	}
+
+	NSTimeInterval bound = MIN(_retryPolicy.initialBackoff * pow(2.0, _retries), _retryPolicy.maximumBackoff);
+	NSTimeInterval delay = bound * arc4random_uniform(1001) / 1000.0;
+
+	NSHTTPURLResponse *response = TMDB_ObjectOfClassOrNil(self.response, [NSHTTPURLResponse class]);
+	if (error == nil && response != nil) {
+		delay = MAX(delay, [TMDBRateLimiter retryAfterFromResponse:response]);
+	}
+
+	CFAbsoluteTime deadline = [self latestDeadline];
+	if (deadline > 0 && CFAbsoluteTimeGetCurrent() + delay >= deadline) {
+		return -1;
+	}
+
+	if (![[_context retryBudget] withdraw]) {
+		TMDBLog(@"iTMDb: Retry budget spent, not retrying %@", self.url);
+		return -1;
+	}
+
+	return delay;
 }
 
 #pragma mark -
 
+- (void)useCachedResponse {
+	_responseFromCache = YES;
+	_parsedData = _cachedResponse.parsedData;
+	_responseData = _parsedData != nil ? nil : [_cachedResponse.data mutableCopy];
+}
+
 - (id)parsedData {
 	if (_parsedData != nil) {
 		return _parsedData;
@@ -112,44 +710,260 @@
 	return parsedData;
 }
 
-#pragma mark - NSURLConnectionDelegate
+#pragma mark - TMDBTransportDelegate
+
+- (void)transportTask:(id<TMDBTransportTask>)task didMeasureConnectDuration:(NSTimeInterval)duration {
+	if (_metrics == nil) {
+		return;
+	}
+
+	@synchronized(self) {
+		if (task != _respondingTask) {
+			return;
+		}
+	}
+
+	[_metrics setDuration:duration forPhase:TMDBRequestPhaseConnect];
+}
+
+- (void)transportTask:(id<TMDBTransportTask>)task didReceiveResponse:(NSURLResponse *)response {
+	id<TMDBTransportTask> losingTask = nil;
+
+	@synchronized(self) {
+		if (_respondingTask == nil) {
+			_respondingTask = task;
+			losingTask = task == _task ? _hedgeTask : _task;
+		}
+		else if (_respondingTask != task) {
+			return;
+		}
+	}
+
+	// The first response wins the race with the hedge
+	[losingTask cancel];
+
+	_responseAt = CFAbsoluteTimeGetCurrent();
+	[[_context latencyTracker] addLatency:_responseAt - _attemptStart forEndpoint:_endpoint];
+	[_metrics setDuration:_responseAt - _attemptStart forPhase:TMDBRequestPhaseTimeToFirstByte];
 
-- (void)connection:(NSURLConnection *)connection didReceiveResponse:(NSURLResponse *)response {
 	_response = [response copy];
 	_parsedData = nil;
 	_responseData.length = 0;
 
+	if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+		NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
+		[_rateLimiter updateWithResponse:httpResponse];
+		_statusCode = httpResponse.statusCode;
+		_rateLimited = httpResponse.statusCode == 429;
+		_notModified = httpResponse.statusCode == 304 && _cachedResponse != nil;
+		_streaming = httpResponse.statusCode == 200;
+	}
+
 	if (self.isCancelled) {
-		[connection cancel];
-		[self finish];
+		[task cancel];
 	}
 }
 
-- (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)thedata {
-	[_responseData appendData:thedata];
-}
+- (void)transportTask:(id<TMDBTransportTask>)task didReceiveData:(NSData *)data {
+	if (self.isCancelled) {
+		return;
+	}
 
-- (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error {
-	_responseData = nil;
-	_parsedData = nil;
-	TMDBSetValue(error, error);
+	@synchronized(self) {
+		if (task != _respondingTask) {
+			return;
+		}
+	}
 
-	[self finish];
+	[_metrics addBytesReceived:data.length];
+
+	[_responseData appendData:data];
+
+	// Only the body of a successful response is worth streaming; error and
+	// rate limit bodies are left to the completion blocks.
+	if (!_streaming || self.isCancelled) {
+		return;
+	}
+
+	NSMutableArray<TMDBRequestDataBlock> *dataBlocks = [NSMutableArray array];
+
+	@synchronized(TMDBRequestsInFlight()) {
+		_streamStarted = YES;
+		for (TMDBRequestSubscription *subscription in _subscriptions) {
+			if (subscription.dataBlock != nil) {
+				[dataBlocks addObject:subscription.dataBlock];
+			}
+		}
+	}
+
+	for (TMDBRequestDataBlock dataBlock in dataBlocks) {
+		dataBlock(data);
+	}
 }
 
-- (void)connectionDidFinishLoading:(NSURLConnection *)connection {
+- (void)transportTask:(id<TMDBTransportTask>)task didCompleteWithError:(NSError *)error {
+	@synchronized(self) {
+		if (_respondingTask == nil) {
+			// Failed without responding, which only ends the attempt if the
+			// other of the task and its hedge has failed as well.
+			if (task == _task) {
+				_task = nil;
+			}
+			else if (task == _hedgeTask) {
+				_hedgeTask = nil;
+			}
+			else {
+				return;
+			}
+
+			if (_task != nil || _hedgeTask != nil) {
+				return;
+			}
+		}
+		else if (task != _respondingTask) {
+			return;
+		}
+
+		_task = nil;
+		_hedgeTask = nil;
+		_respondingTask = nil;
+		_attempt++;
+	}
+
+	if (_metrics != nil && _responseAt > 0) {
+		[_metrics setDuration:CFAbsoluteTimeGetCurrent() - _responseAt forPhase:TMDBRequestPhaseDownload];
+	}
+
+	NSTimeInterval retryDelay = [self delayBeforeRetryingError:error];
+	if (retryDelay >= 0) {
+		_retries++;
+		TMDBLog(@"iTMDb: Retrying %@ in %.2f s (attempt %tu)", self.url, retryDelay, _retries);
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(retryDelay * NSEC_PER_SEC)), [TMDBRequest workQueue], ^{
+			[self acquireRateLimiterToken];
+		});
+		return;
+	}
+
+	if (error == nil && _statusCode > 0 && _statusCode < 500 && !_rateLimited) {
+		[[_context retryBudget] depositWithRatio:_retryPolicy.retryBudgetRatio];
+	}
+
+	if (error == nil && _rateLimited && !self.isCancelled) {
+		CFAbsoluteTime deadline = [self latestDeadline];
+		if (_rateLimitRetries < TMDBRequestMaximumRateLimitRetries && (deadline <= 0 || CFAbsoluteTimeGetCurrent() < deadline)) {
+			// The limiter has paused for as long as the server asked, so the
+			// retry is simply put back in line for a token.
+			_rateLimitRetries++;
+			TMDBLog(@"iTMDb: Rate limited, retrying %@ (attempt %tu)", self.url, _rateLimitRetries);
+			[self acquireRateLimiterToken];
+			return;
+		}
+
+		_responseData = nil;
+		error = [NSError errorWithDomain:TMDBErrorDomain code:TMDBErrorCodeRateLimitExceeded userInfo:nil];
+	}
+
+	if (error != nil) {
+		_responseData = nil;
+		_parsedData = nil;
+		TMDBSetValue(error, error);
+	}
+	else if (_notModified && !self.isCancelled) {
+		[_metrics setCacheResult:TMDBRequestCacheResultRevalidated];
+		[_cache revalidateCachedResponse:_cachedResponse forURL:self.url];
+		[self useCachedResponse];
+	}
+
 	[self finish];
 }
 
 #pragma mark -
 
+- (void)updateCacheWithParsedData:(id)parsedData {
+	if (parsedData == nil || self.error != nil) {
+		return;
+	}
+
+	if (_responseFromCache) {
+		if (_cachedResponse.parsedData == nil) {
+			[_cache cacheParsedData:parsedData forCachedResponse:_cachedResponse URL:self.url];
+		}
+		return;
+	}
+
+	NSHTTPURLResponse *response = TMDB_ObjectOfClassOrNil(self.response, [NSHTTPURLResponse class]);
+	if (response.statusCode == 200 && _responseData != nil) {
+		[_cache storeData:_responseData parsedData:parsedData response:response forURL:self.url];
+	}
+}
+
 - (void)finish {
+	// Decoding large responses takes a while, so keep it off the transport's
+	// queue as well as off the main queue.
+	dispatch_async([TMDBRequest workQueue], ^{
+		[self decodeAndCallCompletionBlocks];
+	});
+}
+
+- (void)decodeAndCallCompletionBlocks {
+	id parsedData = nil;
+	if (self.isCancelled) {
+		if (self.error == nil) {
+			NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+			TMDBSetValue(error, error);
+		}
+	}
+	else {
+		CFAbsoluteTime decodeStart = CFAbsoluteTimeGetCurrent();
+		parsedData = self.parsedData;
+		[_metrics setDuration:CFAbsoluteTimeGetCurrent() - decodeStart forPhase:TMDBRequestPhaseDecode];
+
+		[self updateCacheWithParsedData:parsedData];
+	}
+	NSError *error = self.error;
+
 	TMDBSetIvarValue(isExecuting, _isExecuting, NO);
 	TMDBSetIvarValue(isFinished, _isFinished, YES);
 
-	if (self.requestCompletionBlock != nil) {
-		self.requestCompletionBlock(self.parsedData, self.error);
+	NSArray<TMDBRequestSubscription *> *subscriptions = nil;
+	NSMutableDictionary *requestsInFlight = TMDBRequestsInFlight();
+
+	@synchronized(requestsInFlight) {
+		if (_canonicalURLString != nil && requestsInFlight[_canonicalURLString] == self) {
+			[requestsInFlight removeObjectForKey:_canonicalURLString];
+		}
+
+		_closed = YES;
+		subscriptions = [_subscriptions copy];
+		[_subscriptions removeAllObjects];
 	}
+
+	if (_metrics != nil) {
+		NSHTTPURLResponse *response = TMDB_ObjectOfClassOrNil(self.response, [NSHTTPURLResponse class]);
+		[_metrics setStatusCode:response.statusCode];
+		[_metrics setError:error];
+		[_metrics setAttempts:1 + _retries + _rateLimitRetries];
+		[_metrics beginCallbacks];
+	}
+
+	// Lets the completion blocks add their populating and dispatching to the
+	// metrics, which are delivered once the last of them has started.
+	TMDBRequestMetrics *previousMetrics = TMDBRequestMetricsCurrent();
+	TMDBRequestMetricsSetCurrent(_metrics);
+
+	for (TMDBRequestSubscription *subscription in subscriptions) {
+		subscription.block(parsedData, error);
+	}
+
+	TMDBRequestMetricsSetCurrent(previousMetrics);
+	[_metrics endCallbacks];
+
+	// Callers may hold on to their subscriptions, and with them the request,
+	// long after it has finished.
+	_responseData = nil;
+	_parsedData = nil;
+	_cachedResponse = nil;
+	_transportRequest = nil;
 }
 
 @end
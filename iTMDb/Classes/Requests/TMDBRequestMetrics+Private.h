@@ -0,0 +1,71 @@
+//
+//  TMDBRequestMetrics+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRequestMetrics.h"
+
+@class TMDBMetricsRecorder;
+
+/** The number of buckets of a `TMDBRequestHistogram`. */
+#define TMDBRequestHistogramBucketCount 14
+
+/** Returns the index of the histogram bucket counting `duration`. */
+extern NSUInteger TMDBRequestHistogramBucketIndex(NSTimeInterval duration);
+
+// Private methods shared with the request and model classes
+@interface TMDBRequestMetrics (Private)
+
+/** Metrics that are handed to `recorder` once the request has been delivered. */
+- (nonnull instancetype)initWithURLString:(nonnull NSString *)urlString endpoint:(TMDBCacheEndpoint)endpoint recorder:(nonnull TMDBMetricsRecorder *)recorder;
+
+/** The time the request was created. */
+- (CFAbsoluteTime)createdAt;
+
+- (void)setStatusCode:(NSInteger)statusCode;
+- (void)setError:(nullable NSError *)error;
+- (void)setCacheResult:(TMDBRequestCacheResult)cacheResult;
+- (void)setAttempts:(NSUInteger)attempts;
+- (void)setHedged:(BOOL)hedged;
+- (void)addBytesReceived:(NSUInteger)bytes;
+
+- (void)setDuration:(NSTimeInterval)duration forPhase:(TMDBRequestPhase)phase;
+- (void)addDuration:(NSTimeInterval)duration toPhase:(TMDBRequestPhase)phase;
+
+/**
+ * Holds back delivery until a matching `-endCallbacks`. The metrics are
+ * handed to the recorder when the last callback has ended.
+ */
+- (void)beginCallbacks;
+- (void)endCallbacks;
+
+@end
+
+@interface TMDBRequestHistogram (Private)
+
+/**
+ * Creates a snapshot. `bucketCounts` holds `TMDBRequestHistogramBucketCount`
+ * counts for every phase, one phase after another.
+ */
+- (nonnull instancetype)initWithEndpoint:(TMDBCacheEndpoint)endpoint requestCount:(NSUInteger)requestCount cacheHitCount:(NSUInteger)cacheHitCount errorCount:(NSUInteger)errorCount bytesReceived:(unsigned long long)bytesReceived bucketCounts:(nonnull const NSUInteger *)bucketCounts;
+
+@end
+
+/**
+ * Returns the metrics of the request whose completion blocks are being called
+ * on the current thread, or `nil` if it isn't being measured.
+ */
+extern TMDBRequestMetrics * _Nullable TMDBRequestMetricsCurrent(void);
+
+/** Sets the metrics returned by `TMDBRequestMetricsCurrent()` on this thread. */
+extern void TMDBRequestMetricsSetCurrent(TMDBRequestMetrics * _Nullable metrics);
+
+/**
+ * Calls `dispatch_async()`, counting the time until `block` starts as
+ * completion dispatch of `metrics`, and holding back their delivery until it
+ * has returned. Costs nothing extra when `metrics` is `nil`.
+ */
+extern void TMDBRequestMetricsDispatchAsync(TMDBRequestMetrics * _Nullable metrics, dispatch_queue_t _Nonnull queue, dispatch_block_t _Nonnull block);
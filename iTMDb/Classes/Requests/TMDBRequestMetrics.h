@@ -0,0 +1,135 @@
+//
+//  TMDBRequestMetrics.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDB.h"
+
+/**
+ * The phases of a request, in the order they happen.
+ */
+typedef NS_ENUM(NSUInteger, TMDBRequestPhase) {
+	/**
+	 * From making the call until the request is sent, including waiting for
+	 * the rate limiter and any earlier attempts and backoff.
+	 */
+	TMDBRequestPhaseQueueWait,
+	/**
+	 * Setting up the connection of the last attempt. `0` when an open
+	 * connection was reused, or the transport doesn't report it.
+	 */
+	TMDBRequestPhaseConnect,
+	/** From sending the last attempt until its response arrives, including connecting. */
+	TMDBRequestPhaseTimeToFirstByte,
+	/** From the response arriving until the whole body has been downloaded. */
+	TMDBRequestPhaseDownload,
+	/** Decoding the JSON body. */
+	TMDBRequestPhaseDecode,
+	/** Turning the decoded body into model objects, such as `-[TMDBMovie populate:]`. */
+	TMDBRequestPhasePopulate,
+	/** Waiting for completion blocks to start on their completion queues. */
+	TMDBRequestPhaseCompletionDispatch,
+	/** From making the call until the last completion block has started. */
+	TMDBRequestPhaseTotal
+};
+
+/**
+ * How a request was answered by the response cache.
+ */
+typedef NS_ENUM(NSUInteger, TMDBRequestCacheResult) {
+	/** The response was downloaded. */
+	TMDBRequestCacheResultMiss,
+	/** A fresh cached response was used without asking the server. */
+	TMDBRequestCacheResultHit,
+	/** A stale cached response was confirmed by a `304 Not Modified`. */
+	TMDBRequestCacheResultRevalidated
+};
+
+/**
+ * The timeline and outcome of a single request to the API, including the
+ * completion blocks of every caller that shared it.
+ */
+@interface TMDBRequestMetrics : NSObject
+
+/** The URL of the request, without the API key. */
+@property (nonatomic, copy, nonnull, readonly) NSString *URLString;
+
+/** The group of endpoints the request belongs to. */
+@property (nonatomic, readonly) TMDBCacheEndpoint endpoint;
+
+/** The HTTP status code of the last response, or `0` if there was none. */
+@property (nonatomic, readonly) NSInteger statusCode;
+
+/** The error the request finished with, if any. */
+@property (nonatomic, copy, nullable, readonly) NSError *error;
+
+@property (nonatomic, readonly) TMDBRequestCacheResult cacheResult;
+
+/** The number of response body bytes received, over all attempts. */
+@property (nonatomic, readonly) NSUInteger bytesReceived;
+
+/** The number of times the request was sent, retries included. */
+@property (nonatomic, readonly) NSUInteger attempts;
+
+/** A Boolean value indicating if a hedged request was sent. */
+@property (nonatomic, readonly, getter=isHedged) BOOL hedged;
+
+/** Returns the number of seconds spent in `phase`. */
+- (NSTimeInterval)durationOfPhase:(TMDBRequestPhase)phase;
+
+@end
+
+/**
+ * A snapshot of the durations of the requests to one group of endpoints,
+ * counted in buckets with fixed upper bounds from 1 ms to 10 s.
+ */
+@interface TMDBRequestHistogram : NSObject
+
+@property (nonatomic, readonly) TMDBCacheEndpoint endpoint;
+
+/** The number of requests counted. */
+@property (nonatomic, readonly) NSUInteger requestCount;
+
+/** The number of requests answered from the cache without downloading. */
+@property (nonatomic, readonly) NSUInteger cacheHitCount;
+
+/** The number of requests that failed. */
+@property (nonatomic, readonly) NSUInteger errorCount;
+
+/** The number of response body bytes received by all requests. */
+@property (nonatomic, readonly) unsigned long long bytesReceived;
+
+/**
+ * The upper bounds, in seconds, of the buckets. The last bound is infinite.
+ */
+@property (nonatomic, copy, nonnull, readonly) NSArray<NSNumber *> *bucketUpperBounds;
+
+/** The number of requests in each bucket for `phase`. */
+- (nonnull NSArray<NSNumber *> *)bucketCountsForPhase:(TMDBRequestPhase)phase;
+
+/**
+ * Returns the upper bound of the bucket holding the given percentile, between
+ * `0` and `1`, of the durations of `phase`, or `0` if no requests have been
+ * counted.
+ */
+- (NSTimeInterval)durationAtPercentile:(double)percentile forPhase:(TMDBRequestPhase)phase;
+
+@end
+
+/**
+ * An object receiving the metrics of every request made through a context.
+ */
+@protocol TMDBRequestMetricsObserver <NSObject>
+
+/**
+ * Called on a background queue once the last completion block of a request
+ * has started. Return quickly, as this holds up the queue.
+ */
+- (void)requestDidFinishWithMetrics:(nonnull TMDBRequestMetrics *)metrics;
+
+@end
@@ -0,0 +1,224 @@
+//
+//  TMDBRequestMetrics.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRequestMetrics.h"
+#import "TMDBRequestMetrics+Private.h"
+#import "TMDBMetricsRecorder.h"
+
+static const NSTimeInterval TMDBRequestHistogramBounds[TMDBRequestHistogramBucketCount] = {
+	0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, INFINITY
+};
+
+// Only ever set while the request holding the metrics calls its completion
+// blocks, so it doesn't need to retain them.
+static __thread __unsafe_unretained TMDBRequestMetrics *TMDBRequestMetricsCurrentMetrics;
+
+NSUInteger TMDBRequestHistogramBucketIndex(NSTimeInterval duration) {
+	NSUInteger index = 0;
+	while (index < TMDBRequestHistogramBucketCount - 1 && duration > TMDBRequestHistogramBounds[index]) {
+		index++;
+	}
+	return index;
+}
+
+TMDBRequestMetrics *TMDBRequestMetricsCurrent(void) {
+	return TMDBRequestMetricsCurrentMetrics;
+}
+
+void TMDBRequestMetricsSetCurrent(TMDBRequestMetrics *metrics) {
+	TMDBRequestMetricsCurrentMetrics = metrics;
+}
+
+void TMDBRequestMetricsDispatchAsync(TMDBRequestMetrics *metrics, dispatch_queue_t queue, dispatch_block_t block) {
+	if (metrics == nil) {
+		dispatch_async(queue, block);
+		return;
+	}
+
+	[metrics beginCallbacks];
+	CFAbsoluteTime dispatchedAt = CFAbsoluteTimeGetCurrent();
+
+	dispatch_async(queue, ^{
+		[metrics addDuration:CFAbsoluteTimeGetCurrent() - dispatchedAt toPhase:TMDBRequestPhaseCompletionDispatch];
+		block();
+		[metrics endCallbacks];
+	});
+}
+
+@interface TMDBRequestMetrics ()
+
+@property (nonatomic) NSInteger statusCode;
+@property (nonatomic, copy, nullable) NSError *error;
+@property (nonatomic) TMDBRequestCacheResult cacheResult;
+@property (nonatomic) NSUInteger attempts;
+@property (nonatomic, getter=isHedged) BOOL hedged;
+
+@end
+
+@implementation TMDBRequestMetrics {
+@private
+	TMDBMetricsRecorder *_recorder;
+	CFAbsoluteTime _createdAt;
+	NSTimeInterval _durations[TMDBRequestPhaseTotal + 1];
+	NSUInteger _pendingCallbacks;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithURLString:(NSString *)urlString endpoint:(TMDBCacheEndpoint)endpoint recorder:(TMDBMetricsRecorder *)recorder {
+	NSParameterAssert(recorder != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_URLString = [urlString copy];
+	_endpoint = endpoint;
+	_recorder = recorder;
+	_createdAt = CFAbsoluteTimeGetCurrent();
+	_attempts = 1;
+
+	return self;
+}
+
+- (CFAbsoluteTime)createdAt {
+	return _createdAt;
+}
+
+- (void)addBytesReceived:(NSUInteger)bytes {
+	_bytesReceived += bytes;
+}
+
+#pragma mark - Durations
+
+- (NSTimeInterval)durationOfPhase:(TMDBRequestPhase)phase {
+	if (phase > TMDBRequestPhaseTotal) {
+		return 0;
+	}
+
+	@synchronized(self) {
+		return _durations[phase];
+	}
+}
+
+- (void)setDuration:(NSTimeInterval)duration forPhase:(TMDBRequestPhase)phase {
+	if (phase > TMDBRequestPhaseTotal) {
+		return;
+	}
+
+	@synchronized(self) {
+		_durations[phase] = MAX(duration, 0.0);
+	}
+}
+
+- (void)addDuration:(NSTimeInterval)duration toPhase:(TMDBRequestPhase)phase {
+	if (phase > TMDBRequestPhaseTotal) {
+		return;
+	}
+
+	// Completion blocks on different queues add to the same phase
+	@synchronized(self) {
+		_durations[phase] += MAX(duration, 0.0);
+	}
+}
+
+#pragma mark - Delivery
+
+- (void)beginCallbacks {
+	@synchronized(self) {
+		_pendingCallbacks++;
+	}
+}
+
+- (void)endCallbacks {
+	@synchronized(self) {
+		if (_pendingCallbacks == 0 || --_pendingCallbacks > 0) {
+			return;
+		}
+
+		_durations[TMDBRequestPhaseTotal] = CFAbsoluteTimeGetCurrent() - _createdAt;
+	}
+
+	[_recorder recordMetrics:self];
+}
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@ %p: %@, status %zd, %tu bytes, %.1f ms>", NSStringFromClass([self class]), self, _URLString, _statusCode, _bytesReceived, [self durationOfPhase:TMDBRequestPhaseTotal] * 1000.0];
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBRequestHistogram {
+@private
+	NSUInteger _bucketCounts[TMDBRequestPhaseTotal + 1][TMDBRequestHistogramBucketCount];
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithEndpoint:(TMDBCacheEndpoint)endpoint requestCount:(NSUInteger)requestCount cacheHitCount:(NSUInteger)cacheHitCount errorCount:(NSUInteger)errorCount bytesReceived:(unsigned long long)bytesReceived bucketCounts:(const NSUInteger *)bucketCounts {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_endpoint = endpoint;
+	_requestCount = requestCount;
+	_cacheHitCount = cacheHitCount;
+	_errorCount = errorCount;
+	_bytesReceived = bytesReceived;
+	memcpy(_bucketCounts, bucketCounts, sizeof(_bucketCounts));
+
+	return self;
+}
+
+- (NSArray<NSNumber *> *)bucketUpperBounds {
+	NSMutableArray *bounds = [NSMutableArray arrayWithCapacity:TMDBRequestHistogramBucketCount];
+	for (NSUInteger i = 0; i < TMDBRequestHistogramBucketCount; i++) {
+		[bounds addObject:@(TMDBRequestHistogramBounds[i])];
+	}
+	return bounds;
+}
+
+- (NSArray<NSNumber *> *)bucketCountsForPhase:(TMDBRequestPhase)phase {
+	NSMutableArray *counts = [NSMutableArray arrayWithCapacity:TMDBRequestHistogramBucketCount];
+	for (NSUInteger i = 0; i < TMDBRequestHistogramBucketCount; i++) {
+		[counts addObject:@(phase > TMDBRequestPhaseTotal ? 0 : _bucketCounts[phase][i])];
+	}
+	return counts;
+}
+
+- (NSTimeInterval)durationAtPercentile:(double)percentile forPhase:(TMDBRequestPhase)phase {
+	if (phase > TMDBRequestPhaseTotal || _requestCount == 0) {
+		return 0;
+	}
+
+	NSUInteger rank = (NSUInteger)ceil(MIN(MAX(percentile, 0.0), 1.0) * _requestCount);
+	NSUInteger seen = 0;
+
+	for (NSUInteger i = 0; i < TMDBRequestHistogramBucketCount; i++) {
+		seen += _bucketCounts[phase][i];
+		if (seen >= MAX(rank, (NSUInteger)1)) {
+			return TMDBRequestHistogramBounds[i];
+		}
+	}
+
+	return TMDBRequestHistogramBounds[TMDBRequestHistogramBucketCount - 1];
+}
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@ %p: endpoint %tu, %tu requests, p50 %.3f s, p99 %.3f s>", NSStringFromClass([self class]), self, _endpoint, _requestCount, [self durationAtPercentile:0.5 forPhase:TMDBRequestPhaseTotal], [self durationAtPercentile:0.99 forPhase:TMDBRequestPhaseTotal]];
+}
+
+@end
@@ -0,0 +1,23 @@
+//
+//  TMDBRequestToken+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRequestToken.h"
+
+@class TMDBRequestSubscription;
+
+// Private methods shared with the model classes
+@interface TMDBRequestToken (Private)
+
+/**
+ * Attaches the subscription made for the token, passing on its priority. If
+ * the token has already been cancelled, the subscription is cancelled right
+ * away.
+ */
+- (void)setSubscription:(nullable TMDBRequestSubscription *)subscription;
+
+@end
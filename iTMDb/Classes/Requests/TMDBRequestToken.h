@@ -0,0 +1,51 @@
+//
+//  TMDBRequestToken.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+/**
+ * A caller's interest in a request made by one of the loading or searching
+ * methods, such as `-[TMDBMovie load:completion:]`.
+ *
+ * Identical requests in flight at the same time share a single download, so
+ * cancelling a token only stops the download once no other tokens are
+ * waiting for it.
+ */
+@interface TMDBRequestToken : NSObject
+
+/**
+ * The priority of the request. Requests with a higher priority are sent first
+ * when the rate limit holds requests back. Changing the priority moves a
+ * request that is still waiting.
+ */
+@property (atomic) NSOperationQueuePriority priority;
+
+/**
+ * The time by which the request must have finished, retries included. Once it
+ * has passed, the completion block is called with `NSURLErrorTimedOut`, and
+ * the request is cancelled unless other callers are waiting for it.
+ *
+ * `nil` means the `timeout` of the context's retry policy, counted from the
+ * call. Set a deadline right after making the call.
+ */
+@property (atomic, copy, nullable) NSDate *deadline;
+
+/** A Boolean value indicating if the token has been cancelled. */
+@property (atomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ * Cancels the request. The completion block, and any result blocks, are not
+ * called after this method returns.
+ *
+ * A request still waiting for the rate limiter gives up its place without
+ * using any of the budget, and one being downloaded stops right away without
+ * decoding the response.
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,110 @@
+//
+//  TMDBRequestToken.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRequestToken+Private.h"
+#import "TMDBRequest.h"
+
+@implementation TMDBRequestToken {
+@private
+	TMDBRequestSubscription *_subscription;
+	NSOperationQueuePriority _priority;
+	NSDate *_deadline;
+	BOOL _cancelled;
+}
+
+- (instancetype)init {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_priority = NSOperationQueuePriorityNormal;
+
+	return self;
+}
+
+- (NSOperationQueuePriority)priority {
+	@synchronized(self) {
+		return _priority;
+	}
+}
+
+- (void)setPriority:(NSOperationQueuePriority)priority {
+	TMDBRequestSubscription *subscription = nil;
+	@synchronized(self) {
+		_priority = priority;
+		subscription = _subscription;
+	}
+
+	subscription.priority = priority;
+}
+
+- (NSDate *)deadline {
+	@synchronized(self) {
+		return _deadline;
+	}
+}
+
+- (void)setDeadline:(NSDate *)deadline {
+	TMDBRequestSubscription *subscription = nil;
+	@synchronized(self) {
+		_deadline = [deadline copy];
+		subscription = _subscription;
+	}
+
+	if (deadline != nil) {
+		subscription.deadline = deadline.timeIntervalSinceReferenceDate;
+	}
+}
+
+- (BOOL)isCancelled {
+	@synchronized(self) {
+		return _cancelled;
+	}
+}
+
+- (void)cancel {
+	TMDBRequestSubscription *subscription = nil;
+	@synchronized(self) {
+		if (_cancelled) {
+			return;
+		}
+		_cancelled = YES;
+		subscription = _subscription;
+		_subscription = nil;
+	}
+
+	[subscription cancel];
+}
+
+#pragma mark - Private
+
+- (void)setSubscription:(TMDBRequestSubscription *)subscription {
+	NSOperationQueuePriority priority;
+	NSDate *deadline;
+	BOOL cancelled;
+	@synchronized(self) {
+		cancelled = _cancelled;
+		priority = _priority;
+		deadline = _deadline;
+		if (!cancelled) {
+			_subscription = subscription;
+		}
+	}
+
+	if (cancelled) {
+		[subscription cancel];
+	}
+	else {
+		subscription.priority = priority;
+		if (deadline != nil) {
+			subscription.deadline = deadline.timeIntervalSinceReferenceDate;
+		}
+	}
+}
+
+@end
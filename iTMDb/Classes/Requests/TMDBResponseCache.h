@@ -0,0 +1,115 @@
+//
+//  TMDBResponseCache.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDB.h"
+
+/**
+ * A response stored by `TMDBResponseCache`.
+ */
+// Private class
+@interface TMDBCachedResponse : NSObject
+
+/** The raw response body. */
+@property (nonatomic, copy, nonnull, readonly) NSData *data;
+
+/**
+ * The decoded response body. Only kept for responses held in memory; `nil`
+ * for responses read back from disk until they have been decoded again.
+ */
+@property (nonatomic, strong, nullable) id parsedData;
+
+@property (nonatomic, copy, nullable, readonly) NSString *entityTag;
+@property (nonatomic, copy, nullable, readonly) NSString *lastModified;
+
+/** The time the response was stored or last revalidated. */
+@property (nonatomic, readonly) CFAbsoluteTime storedAt;
+
+/** The number of seconds after `storedAt` the response may be used as-is. */
+@property (nonatomic, readonly) NSTimeInterval lifetime;
+
+/**
+ * A Boolean value indicating if the response may be used without asking the
+ * server. Stale responses can still be revalidated with the entity tag and
+ * last modified date.
+ */
+@property (nonatomic, readonly, getter=isFresh) BOOL fresh;
+
+@end
+
+/**
+ * The name of the file a cache stores the entry for `key` in. The name is a
+ * plain hash of the key, since it only needs to be unique, not secret.
+ */
+extern NSString * _Nonnull TMDBCacheFileNameForKey(NSString * _Nonnull key);
+
+/**
+ * A two-tier cache of API responses. Decoded responses are kept in memory up
+ * to `memoryCapacity` bytes, evicting the least recently used ones first, and
+ * raw bodies are kept on disk up to `diskCapacity` bytes.
+ *
+ * Responses are keyed by their canonical URL without the API key, and kept
+ * for as long as the lifetime of their endpoint.
+ */
+// Private class
+@interface TMDBResponseCache : NSObject
+
++ (nonnull instancetype)sharedCache;
+
+/**
+ * Creates a cache storing its files in `directoryURL`. Pass `nil` to create a
+ * memory-only cache.
+ */
+- (nonnull instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic) NSUInteger memoryCapacity;
+@property (nonatomic) NSUInteger diskCapacity;
+
+- (void)setLifetime:(NSTimeInterval)lifetime forEndpoint:(TMDBCacheEndpoint)endpoint;
+- (NSTimeInterval)lifetimeForEndpoint:(TMDBCacheEndpoint)endpoint;
+
++ (TMDBCacheEndpoint)endpointForURL:(nonnull NSURL *)url;
+
+/** @name Getting and Storing Responses */
+
+/**
+ * Returns the response stored for `url`, fresh or stale, or `nil` if there
+ * is none.
+ */
+- (nullable TMDBCachedResponse *)cachedResponseForURL:(nonnull NSURL *)url;
+
+/**
+ * Stores a successful response for `url`, unless its endpoint isn't cached.
+ */
+- (void)storeData:(nonnull NSData *)data parsedData:(nullable id)parsedData response:(nonnull NSHTTPURLResponse *)response forURL:(nonnull NSURL *)url;
+
+/**
+ * Marks a stale response as fresh again, after the server has confirmed it
+ * with a `304 Not Modified`.
+ */
+- (void)revalidateCachedResponse:(nonnull TMDBCachedResponse *)cachedResponse forURL:(nonnull NSURL *)url;
+
+/**
+ * Keeps the decoded form of a response read back from disk in memory, so it
+ * doesn't need to be decoded again.
+ */
+- (void)cacheParsedData:(nonnull id)parsedData forCachedResponse:(nonnull TMDBCachedResponse *)cachedResponse URL:(nonnull NSURL *)url;
+
+/**
+ * Marks the response stored for `url` as stale, so the next request for it
+ * asks the server whether it has changed.
+ */
+- (void)expireResponseForURL:(nonnull NSURL *)url;
+
+- (void)removeAllResponses;
+
+/** Drops every response held in memory. Responses on disk are kept. */
+- (void)purgeMemory;
+
+@end
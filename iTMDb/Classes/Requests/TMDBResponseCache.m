@@ -0,0 +1,540 @@
+//
+//  TMDBResponseCache.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBResponseCache.h"
+#import "TMDBRequest.h"
+
+// Decoded JSON takes up several times the size of the body it came from. The
+// memory cost of a response is its body plus this many times the body.
+static const NSUInteger TMDBResponseCacheDecodedSizeFactor = 3;
+
+static NSString * const TMDBCachedResponseURLKey = @"url";
+static NSString * const TMDBCachedResponseDataKey = @"data";
+static NSString * const TMDBCachedResponseEntityTagKey = @"etag";
+static NSString * const TMDBCachedResponseLastModifiedKey = @"last_modified";
+static NSString * const TMDBCachedResponseStoredAtKey = @"stored_at";
+static NSString * const TMDBCachedResponseLifetimeKey = @"lifetime";
+
+#pragma mark -
+
+@interface TMDBCachedResponse ()
+
+- (nonnull instancetype)initWithData:(nonnull NSData *)data entityTag:(nullable NSString *)entityTag lastModified:(nullable NSString *)lastModified storedAt:(CFAbsoluteTime)storedAt lifetime:(NSTimeInterval)lifetime NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic) CFAbsoluteTime storedAt;
+@property (nonatomic) NSTimeInterval lifetime;
+
+// Memory cache bookkeeping, only touched while holding the cache's lock
+@property (nonatomic, copy, nullable) NSString *key;
+@property (nonatomic) NSUInteger cost;
+@property (nonatomic, strong, nullable) TMDBCachedResponse *next;
+@property (nonatomic, weak, nullable) TMDBCachedResponse *previous;
+
+@end
+
+@implementation TMDBCachedResponse
+
+- (instancetype)init {
+	return (self = [self initWithData:[NSData data] entityTag:nil lastModified:nil storedAt:0.0 lifetime:0.0]);
+}
+
+- (instancetype)initWithData:(NSData *)data entityTag:(NSString *)entityTag lastModified:(NSString *)lastModified storedAt:(CFAbsoluteTime)storedAt lifetime:(NSTimeInterval)lifetime {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_data = [data copy];
+	_entityTag = [entityTag copy];
+	_lastModified = [lastModified copy];
+	_storedAt = storedAt;
+	_lifetime = lifetime;
+	_cost = data.length * (1 + TMDBResponseCacheDecodedSizeFactor);
+
+	return self;
+}
+
+- (BOOL)isFresh {
+	return CFAbsoluteTimeGetCurrent() < _storedAt + _lifetime;
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBResponseCache {
+@private
+	NSLock *_lock;
+	NSTimeInterval _lifetimes[TMDBCacheEndpointOther + 1];
+
+	NSMutableDictionary<NSString *, TMDBCachedResponse *> *_memoryResponses;
+	TMDBCachedResponse *_head; // Most recently used
+	__weak TMDBCachedResponse *_tail; // Least recently used
+	NSUInteger _memoryCost;
+
+	NSURL *_directoryURL;
+	dispatch_queue_t _ioQueue;
+	unsigned long long _diskUsage;
+	BOOL _diskUsageKnown;
+
+#if !TARGET_OS_IPHONE
+	dispatch_source_t _memoryPressureSource;
+#endif
+}
+
++ (instancetype)sharedCache {
+	static TMDBResponseCache *sharedCache;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		NSURL *cachesURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+		NSURL *directoryURL = [cachesURL URLByAppendingPathComponent:@"dk.devify.tmdb/Responses" isDirectory:YES];
+		sharedCache = [[self alloc] initWithDirectoryURL:directoryURL];
+	});
+	return sharedCache;
+}
+
+- (instancetype)init {
+	return (self = [self initWithDirectoryURL:nil]);
+}
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_lock = [[NSLock alloc] init];
+	_memoryResponses = [NSMutableDictionary dictionary];
+	_memoryCapacity = 4 * 1024 * 1024;
+	_diskCapacity = 20 * 1024 * 1024;
+
+	_lifetimes[TMDBCacheEndpointConfiguration] = 3 * 24 * 60 * 60;
+	_lifetimes[TMDBCacheEndpointMovie] = 24 * 60 * 60;
+	_lifetimes[TMDBCacheEndpointSearch] = 60 * 60;
+	_lifetimes[TMDBCacheEndpointPerson] = 24 * 60 * 60;
+	_lifetimes[TMDBCacheEndpointOther] = 0;
+
+	_directoryURL = [directoryURL copy];
+	_ioQueue = dispatch_queue_create("dk.devify.tmdb.responsecache", DISPATCH_QUEUE_SERIAL);
+
+	if (_directoryURL != nil) {
+		[[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+	}
+
+#if TARGET_OS_IPHONE
+	// Referenced by name, as the framework doesn't link against UIKit
+	[[NSNotificationCenter defaultCenter] addObserver:self
+											 selector:@selector(purgeMemory)
+												 name:@"UIApplicationDidReceiveMemoryWarningNotification"
+											   object:nil];
+#else
+	_memoryPressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0, DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0));
+	// Not every platform libdispatch runs on reports memory pressure
+	if (_memoryPressureSource != nil) {
+		__weak TMDBResponseCache *weakSelf = self;
+		dispatch_source_set_event_handler(_memoryPressureSource, ^{
+			[weakSelf purgeMemory];
+		});
+		dispatch_resume(_memoryPressureSource);
+	}
+#endif
+
+	return self;
+}
+
+- (void)dealloc {
+#if TARGET_OS_IPHONE
+	[[NSNotificationCenter defaultCenter] removeObserver:self];
+#else
+	if (_memoryPressureSource != nil) {
+		dispatch_source_cancel(_memoryPressureSource);
+	}
+#endif
+}
+
+#pragma mark - Lifetimes
+
++ (TMDBCacheEndpoint)endpointForURL:(NSURL *)url {
+	// Paths look like /3/movie/550, so the resource follows the API version
+	NSArray<NSString *> *components = url.pathComponents;
+	NSString *resource = components.count > 2 ? components[2] : nil;
+	NSString *subresource = components.count > 3 ? components[3] : nil;
+
+	// Change feeds must always be fetched
+	if ([subresource isEqualToString:@"changes"]) {
+		return TMDBCacheEndpointOther;
+	}
+
+	if ([resource isEqualToString:@"configuration"]) {
+		return TMDBCacheEndpointConfiguration;
+	}
+	else if ([resource isEqualToString:@"movie"]) {
+		return TMDBCacheEndpointMovie;
+	}
+	else if ([resource isEqualToString:@"search"]) {
+		return TMDBCacheEndpointSearch;
+	}
+	else if ([resource isEqualToString:@"person"]) {
+		return TMDBCacheEndpointPerson;
+	}
+
+	return TMDBCacheEndpointOther;
+}
+
+- (void)setLifetime:(NSTimeInterval)lifetime forEndpoint:(TMDBCacheEndpoint)endpoint {
+	if (endpoint > TMDBCacheEndpointOther) {
+		return;
+	}
+
+	[_lock lock];
+	_lifetimes[endpoint] = MAX(lifetime, 0.0);
+	[_lock unlock];
+}
+
+- (NSTimeInterval)lifetimeForEndpoint:(TMDBCacheEndpoint)endpoint {
+	if (endpoint > TMDBCacheEndpointOther) {
+		return 0.0;
+	}
+
+	[_lock lock];
+	NSTimeInterval lifetime = _lifetimes[endpoint];
+	[_lock unlock];
+
+	return lifetime;
+}
+
+#pragma mark - Keys
+
+// FNV-1a, which spreads short, similar keys well enough for file names
+static uint64_t TMDBCacheHash(const uint8_t *bytes, NSUInteger length, uint64_t hash) {
+	for (NSUInteger i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+NSString *TMDBCacheFileNameForKey(NSString *key) {
+	NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+
+	// Two hashes with different offset bases, so a collision takes 128 bits
+	uint64_t first = TMDBCacheHash(keyData.bytes, keyData.length, 0xcbf29ce484222325ULL);
+	uint64_t second = TMDBCacheHash(keyData.bytes, keyData.length, 0x84222325cbf29ce4ULL);
+
+	return [NSString stringWithFormat:@"%016llx%016llx", (unsigned long long)first, (unsigned long long)second];
+}
+
+- (NSString *)keyForURL:(NSURL *)url {
+	return [TMDBRequest canonicalStringForURL:url excludingQueryItems:[NSSet setWithObject:@"api_key"]];
+}
+
+- (NSURL *)fileURLForKey:(NSString *)key {
+	return [_directoryURL URLByAppendingPathComponent:TMDBCacheFileNameForKey(key) isDirectory:NO];
+}
+
+#pragma mark - Getting and Storing Responses
+
+- (TMDBCachedResponse *)cachedResponseForURL:(NSURL *)url {
+	NSString *key = [self keyForURL:url];
+
+	[_lock lock];
+	TMDBCachedResponse *cachedResponse = _memoryResponses[key];
+	if (cachedResponse != nil) {
+		[self unlinkResponse:cachedResponse];
+		[self linkResponseAtHead:cachedResponse];
+	}
+	[_lock unlock];
+
+	if (cachedResponse != nil) {
+		return cachedResponse;
+	}
+
+	cachedResponse = [self diskResponseForKey:key];
+
+	return cachedResponse;
+}
+
+- (void)storeData:(NSData *)data parsedData:(id)parsedData response:(NSHTTPURLResponse *)response forURL:(NSURL *)url {
+	NSTimeInterval lifetime = [self lifetimeForEndpoint:[TMDBResponseCache endpointForURL:url]];
+	if (lifetime <= 0.0 || data.length == 0) {
+		return;
+	}
+
+	NSDictionary *headers = response.allHeaderFields;
+	NSString *entityTag = TMDB_NSStringOrNil(headers[@"ETag"] ?: headers[@"Etag"]);
+	NSString *lastModified = TMDB_NSStringOrNil(headers[@"Last-Modified"]);
+
+	TMDBCachedResponse *cachedResponse = [[TMDBCachedResponse alloc] initWithData:data
+																		entityTag:entityTag
+																	 lastModified:lastModified
+																		 storedAt:CFAbsoluteTimeGetCurrent()
+																		 lifetime:lifetime];
+	cachedResponse.parsedData = parsedData;
+
+	NSString *key = [self keyForURL:url];
+	[self addMemoryResponse:cachedResponse forKey:key];
+	[self writeResponse:cachedResponse forKey:key url:url];
+}
+
+- (void)revalidateCachedResponse:(TMDBCachedResponse *)cachedResponse forURL:(NSURL *)url {
+	NSString *key = [self keyForURL:url];
+
+	[_lock lock];
+	cachedResponse.storedAt = CFAbsoluteTimeGetCurrent();
+	cachedResponse.lifetime = _lifetimes[[TMDBResponseCache endpointForURL:url]];
+	[_lock unlock];
+
+	if (cachedResponse.parsedData != nil) {
+		[self addMemoryResponse:cachedResponse forKey:key];
+	}
+	[self writeResponse:cachedResponse forKey:key url:url];
+}
+
+- (void)cacheParsedData:(id)parsedData forCachedResponse:(TMDBCachedResponse *)cachedResponse URL:(NSURL *)url {
+	cachedResponse.parsedData = parsedData;
+	[self addMemoryResponse:cachedResponse forKey:[self keyForURL:url]];
+}
+
+- (void)expireResponseForURL:(NSURL *)url {
+	TMDBCachedResponse *cachedResponse = [self cachedResponseForURL:url];
+	if (cachedResponse == nil || !cachedResponse.fresh) {
+		return;
+	}
+
+	[_lock lock];
+	cachedResponse.lifetime = 0.0;
+	[_lock unlock];
+
+	[self writeResponse:cachedResponse forKey:[self keyForURL:url] url:url];
+}
+
+- (void)removeAllResponses {
+	[self purgeMemory];
+
+	if (_directoryURL == nil) {
+		return;
+	}
+
+	dispatch_async(_ioQueue, ^{
+		NSFileManager *fileManager = [NSFileManager defaultManager];
+		[fileManager removeItemAtURL:_directoryURL error:nil];
+		[fileManager createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+		_diskUsage = 0;
+		_diskUsageKnown = YES;
+	});
+}
+
+#pragma mark - Memory
+
+- (void)setMemoryCapacity:(NSUInteger)memoryCapacity {
+	[_lock lock];
+	_memoryCapacity = memoryCapacity;
+	[self evictMemoryResponsesToFitCapacity];
+	[_lock unlock];
+}
+
+- (void)purgeMemory {
+	[_lock lock];
+	[_memoryResponses removeAllObjects];
+	_head = nil;
+	_tail = nil;
+	_memoryCost = 0;
+	[_lock unlock];
+}
+
+- (void)addMemoryResponse:(TMDBCachedResponse *)cachedResponse forKey:(NSString *)key {
+	if (cachedResponse.parsedData == nil) {
+		return;
+	}
+
+	[_lock lock];
+
+	TMDBCachedResponse *existingResponse = _memoryResponses[key];
+	if (existingResponse != nil) {
+		[self unlinkResponse:existingResponse];
+		[_memoryResponses removeObjectForKey:key];
+		_memoryCost -= existingResponse.cost;
+	}
+
+	cachedResponse.key = key;
+	_memoryResponses[key] = cachedResponse;
+	[self linkResponseAtHead:cachedResponse];
+	_memoryCost += cachedResponse.cost;
+
+	[self evictMemoryResponsesToFitCapacity];
+
+	[_lock unlock];
+}
+
+// Must be called while holding _lock
+- (void)evictMemoryResponsesToFitCapacity {
+	while (_memoryCost > _memoryCapacity && _tail != nil) {
+		TMDBCachedResponse *leastRecentlyUsed = _tail;
+		[self unlinkResponse:leastRecentlyUsed];
+		[_memoryResponses removeObjectForKey:leastRecentlyUsed.key];
+		_memoryCost -= leastRecentlyUsed.cost;
+	}
+}
+
+// Must be called while holding _lock
+- (void)linkResponseAtHead:(TMDBCachedResponse *)cachedResponse {
+	cachedResponse.previous = nil;
+	cachedResponse.next = _head;
+	_head.previous = cachedResponse;
+	_head = cachedResponse;
+
+	if (_tail == nil) {
+		_tail = cachedResponse;
+	}
+}
+
+// Must be called while holding _lock
+- (void)unlinkResponse:(TMDBCachedResponse *)cachedResponse {
+	TMDBCachedResponse *previous = cachedResponse.previous;
+	TMDBCachedResponse *next = cachedResponse.next;
+
+	if (previous != nil) {
+		previous.next = next;
+	}
+	else if (_head == cachedResponse) {
+		_head = next;
+	}
+
+	if (next != nil) {
+		next.previous = previous;
+	}
+	else if (_tail == cachedResponse) {
+		_tail = previous;
+	}
+
+	cachedResponse.previous = nil;
+	cachedResponse.next = nil;
+}
+
+#pragma mark - Disk
+
+- (TMDBCachedResponse *)diskResponseForKey:(NSString *)key {
+	if (_directoryURL == nil) {
+		return nil;
+	}
+
+	NSURL *fileURL = [self fileURLForKey:key];
+	NSData *fileData = [NSData dataWithContentsOfURL:fileURL];
+	if (fileData == nil) {
+		return nil;
+	}
+
+	NSDictionary *record = TMDB_NSDictionaryOrNil([NSPropertyListSerialization propertyListWithData:fileData options:NSPropertyListImmutable format:NULL error:nil]);
+	NSData *data = TMDB_ObjectOfClassOrNil(record[TMDBCachedResponseDataKey], [NSData class]);
+
+	// Guard against hash collisions and unreadable files
+	if (data == nil || ![TMDB_NSStringOrNil(record[TMDBCachedResponseURLKey]) isEqualToString:key]) {
+		return nil;
+	}
+
+	// Touch the file, so trimming removes the least recently used files first
+	dispatch_async(_ioQueue, ^{
+		[[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate: [NSDate date]} ofItemAtPath:fileURL.path error:nil];
+	});
+
+	return [[TMDBCachedResponse alloc] initWithData:data
+										  entityTag:TMDB_NSStringOrNil(record[TMDBCachedResponseEntityTagKey])
+									   lastModified:TMDB_NSStringOrNil(record[TMDBCachedResponseLastModifiedKey])
+										   storedAt:TMDB_NSNumberOrNil(record[TMDBCachedResponseStoredAtKey]).doubleValue
+										   lifetime:TMDB_NSNumberOrNil(record[TMDBCachedResponseLifetimeKey]).doubleValue];
+}
+
+- (void)writeResponse:(TMDBCachedResponse *)cachedResponse forKey:(NSString *)key url:(NSURL *)url {
+	if (_directoryURL == nil || _diskCapacity == 0) {
+		return;
+	}
+
+	NSMutableDictionary *record = [NSMutableDictionary dictionary];
+	record[TMDBCachedResponseURLKey] = key;
+	record[TMDBCachedResponseDataKey] = cachedResponse.data;
+	record[TMDBCachedResponseStoredAtKey] = @(cachedResponse.storedAt);
+	record[TMDBCachedResponseLifetimeKey] = @(cachedResponse.lifetime);
+	if (cachedResponse.entityTag != nil) {
+		record[TMDBCachedResponseEntityTagKey] = cachedResponse.entityTag;
+	}
+	if (cachedResponse.lastModified != nil) {
+		record[TMDBCachedResponseLastModifiedKey] = cachedResponse.lastModified;
+	}
+
+	NSURL *fileURL = [self fileURLForKey:key];
+
+	dispatch_async(_ioQueue, ^{
+		NSData *fileData = [NSPropertyListSerialization dataWithPropertyList:record format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+		if (fileData == nil) {
+			return;
+		}
+
+		[self calculateDiskUsageIfNeeded];
+
+		NSNumber *previousSize = [[NSFileManager defaultManager] attributesOfItemAtPath:fileURL.path error:nil][NSFileSize];
+		if ([fileData writeToURL:fileURL atomically:YES]) {
+			_diskUsage = _diskUsage - MIN(previousSize.unsignedLongLongValue, _diskUsage) + fileData.length;
+		}
+
+		[self trimDiskIfNeeded];
+	});
+}
+
+// Must be called on _ioQueue
+- (void)calculateDiskUsageIfNeeded {
+	if (_diskUsageKnown) {
+		return;
+	}
+
+	_diskUsage = 0;
+	for (NSURL *fileURL in [self diskFileURLs]) {
+		NSNumber *size = nil;
+		[fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+		_diskUsage += size.unsignedLongLongValue;
+	}
+	_diskUsageKnown = YES;
+}
+
+// Must be called on _ioQueue
+- (void)trimDiskIfNeeded {
+	if (_diskUsage <= _diskCapacity) {
+		return;
+	}
+
+	// Trim a little further than needed, so not every write ends up trimming
+	unsigned long long targetUsage = _diskCapacity / 4 * 3;
+
+	NSArray<NSURL *> *fileURLs = [[self diskFileURLs] sortedArrayUsingComparator:^NSComparisonResult(NSURL *url1, NSURL *url2) {
+		NSDate *date1 = nil, *date2 = nil;
+		[url1 getResourceValue:&date1 forKey:NSURLContentModificationDateKey error:nil];
+		[url2 getResourceValue:&date2 forKey:NSURLContentModificationDateKey error:nil];
+		return [date1 compare:date2];
+	}];
+
+	NSFileManager *fileManager = [NSFileManager defaultManager];
+	for (NSURL *fileURL in fileURLs) {
+		if (_diskUsage <= targetUsage) {
+			break;
+		}
+
+		NSNumber *size = nil;
+		[fileURL getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+
+		if ([fileManager removeItemAtURL:fileURL error:nil]) {
+			_diskUsage -= MIN(size.unsignedLongLongValue, _diskUsage);
+		}
+	}
+}
+
+- (NSArray<NSURL *> *)diskFileURLs {
+	NSArray *keys = @[NSURLFileSizeKey, NSURLContentModificationDateKey];
+	return [[NSFileManager defaultManager] contentsOfDirectoryAtURL:_directoryURL
+										 includingPropertiesForKeys:keys
+															options:NSDirectoryEnumerationSkipsHiddenFiles
+															  error:nil] ?: @[];
+}
+
+@end
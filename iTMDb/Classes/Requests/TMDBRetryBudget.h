@@ -0,0 +1,47 @@
+//
+//  TMDBRetryBudget.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDB.h"
+
+/**
+ * The allowance for retries and hedged requests shared by the requests of a
+ * context. Every retry withdraws a whole token, while every successful request only deposits
+ * a fraction of one, so retries can't multiply the load on a failing server.
+ */
+// Private class
+@interface TMDBRetryBudget : NSObject
+
+- (nonnull instancetype)initWithMaximumTokens:(double)maximumTokens NS_DESIGNATED_INITIALIZER;
+
+/** Adds `ratio` tokens for a successful request, up to the maximum. */
+- (void)depositWithRatio:(double)ratio;
+
+/** Takes a token for a retry, or returns `NO` if the budget is spent. */
+- (BOOL)withdraw;
+
+@end
+
+/**
+ * Recent response times of each endpoint of a context, used to decide when a
+ * request is slow enough to be hedged.
+ */
+// Private class
+@interface TMDBLatencyTracker : NSObject
+
+/** Records the time between sending a request and receiving its response. */
+- (void)addLatency:(NSTimeInterval)latency forEndpoint:(TMDBCacheEndpoint)endpoint;
+
+/**
+ * Returns the latency at `percentile`, between `0` and `1`, of the recent
+ * responses from `endpoint`, or `0` if there are too few of them yet.
+ */
+- (NSTimeInterval)latencyAtPercentile:(double)percentile forEndpoint:(TMDBCacheEndpoint)endpoint;
+
+@end
@@ -0,0 +1,111 @@
+//
+//  TMDBRetryBudget.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRetryBudget.h"
+
+// The number of retries allowed before any request has succeeded
+static const double TMDBRetryBudgetDefaultMaximumTokens = 10.0;
+
+// The number of recent responses per endpoint kept for the percentiles
+#define TMDBLatencyTrackerSampleCount 64
+
+// The number of responses needed before percentiles are trusted
+static const NSUInteger TMDBLatencyTrackerMinimumSamples = 20;
+
+@implementation TMDBRetryBudget {
+@private
+	double _maximumTokens;
+	double _tokens;
+}
+
+- (instancetype)init {
+	return (self = [self initWithMaximumTokens:TMDBRetryBudgetDefaultMaximumTokens]);
+}
+
+- (instancetype)initWithMaximumTokens:(double)maximumTokens {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_maximumTokens = MAX(maximumTokens, 1.0);
+	_tokens = _maximumTokens;
+
+	return self;
+}
+
+- (void)depositWithRatio:(double)ratio {
+	@synchronized(self) {
+		_tokens = MIN(_tokens + MAX(ratio, 0.0), _maximumTokens);
+	}
+}
+
+- (BOOL)withdraw {
+	@synchronized(self) {
+		if (_tokens < 1.0) {
+			return NO;
+		}
+
+		_tokens -= 1.0;
+		return YES;
+	}
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBLatencyTracker {
+@private
+	// A ring buffer of recent latencies per endpoint
+	NSTimeInterval _samples[TMDBCacheEndpointOther + 1][TMDBLatencyTrackerSampleCount];
+	NSUInteger _sampleCounts[TMDBCacheEndpointOther + 1];
+	NSUInteger _nextSamples[TMDBCacheEndpointOther + 1];
+}
+
+- (void)addLatency:(NSTimeInterval)latency forEndpoint:(TMDBCacheEndpoint)endpoint {
+	if (endpoint > TMDBCacheEndpointOther) {
+		return;
+	}
+
+	@synchronized(self) {
+		_samples[endpoint][_nextSamples[endpoint]] = latency;
+		_nextSamples[endpoint] = (_nextSamples[endpoint] + 1) % TMDBLatencyTrackerSampleCount;
+		_sampleCounts[endpoint] = MIN(_sampleCounts[endpoint] + 1, (NSUInteger)TMDBLatencyTrackerSampleCount);
+	}
+}
+
+static int TMDBCompareLatencies(const void *a, const void *b) {
+	NSTimeInterval x = *(const NSTimeInterval *)a;
+	NSTimeInterval y = *(const NSTimeInterval *)b;
+	return (x > y) - (x < y);
+}
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile forEndpoint:(TMDBCacheEndpoint)endpoint {
+	if (endpoint > TMDBCacheEndpointOther) {
+		return 0;
+	}
+
+	NSTimeInterval sorted[TMDBLatencyTrackerSampleCount];
+	NSUInteger count;
+
+	@synchronized(self) {
+		count = _sampleCounts[endpoint];
+		memcpy(sorted, _samples[endpoint], count * sizeof(NSTimeInterval));
+	}
+
+	if (count < TMDBLatencyTrackerMinimumSamples) {
+		return 0;
+	}
+
+	qsort(sorted, count, sizeof(NSTimeInterval), TMDBCompareLatencies);
+
+	NSUInteger index = (NSUInteger)(MIN(MAX(percentile, 0.0), 1.0) * (count - 1) + 0.5);
+	return sorted[index];
+}
+
+@end
@@ -0,0 +1,83 @@
+//
+//  TMDBRetryPolicy.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+/**
+ * A `TMDBRetryPolicy` describes how requests to the API recover from slow and
+ * failed connections. The context's policy is read when a request is created.
+ *
+ * Requests that fail to connect, time out, or get a `500`, `502`, `503` or
+ * `504` response are sent again after an exponential backoff with full
+ * jitter, waiting at least as long as a `Retry-After` header asks. All API
+ * requests are idempotent `GET` requests, so they are always safe to retry.
+ * Rate limited requests are retried by the rate limiter as before.
+ *
+ * Retries and hedged requests are drawn from a shared retry budget, which
+ * only grows as requests succeed, so a failing server doesn't get flooded
+ * with retries.
+ */
+@interface TMDBRetryPolicy : NSObject <NSCopying>
+
+/** A policy that never retries or hedges, and has no deadline. */
++ (nonnull instancetype)policyWithoutRetries;
+
+/** @name Retrying */
+
+/** The number of times a failed request is sent again. Default `2`. */
+@property (nonatomic) NSUInteger maximumRetries;
+
+/**
+ * The upper bound, in seconds, of the wait before the first retry. Each
+ * further retry doubles it, and the actual wait is picked at random below the
+ * bound. Default `0.5`.
+ */
+@property (nonatomic) NSTimeInterval initialBackoff;
+
+/** The largest upper bound of the wait before a retry. Default `8`. */
+@property (nonatomic) NSTimeInterval maximumBackoff;
+
+/**
+ * The number of retries and hedged requests allowed for every request that
+ * succeeds. Default `0.1`, so retries add no more than about a tenth to the
+ * load, after an initial allowance of 10.
+ */
+@property (nonatomic) double retryBudgetRatio;
+
+/** @name Deadlines */
+
+/**
+ * The number of seconds a request may take, retries included, before it
+ * fails with `NSURLErrorTimedOut`. Pass `0` for no deadline. Default `60`.
+ *
+ * A shorter deadline can be set for a single call with
+ * `-[TMDBRequestToken deadline]`.
+ */
+@property (nonatomic) NSTimeInterval timeout;
+
+/**
+ * The number of seconds a single attempt may take. Attempts are also cut
+ * short by the deadline. Default `30`.
+ */
+@property (nonatomic) NSTimeInterval attemptTimeout;
+
+/** @name Hedging */
+
+/**
+ * The percentile of recent response times of an endpoint after which a
+ * second, identical request is sent if the first hasn't responded yet. The
+ * first response wins, and the other request is cancelled. Pass `0` to
+ * disable hedging. Default `0`.
+ *
+ * Typical values are `0.9` to `0.99`. Hedging only starts once an endpoint
+ * has responded a few dozen times, and hedged requests must be let through
+ * by the rate limiter right away.
+ */
+@property (nonatomic) double hedgingPercentile;
+
+@end
@@ -0,0 +1,52 @@
+//
+//  TMDBRetryPolicy.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBRetryPolicy.h"
+
+@implementation TMDBRetryPolicy
+
++ (instancetype)policyWithoutRetries {
+	TMDBRetryPolicy *policy = [[self alloc] init];
+	policy.maximumRetries = 0;
+	policy.timeout = 0;
+	return policy;
+}
+
+- (instancetype)init {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_maximumRetries = 2;
+	_initialBackoff = 0.5;
+	_maximumBackoff = 8.0;
+	_retryBudgetRatio = 0.1;
+	_timeout = 60.0;
+	_attemptTimeout = 30.0;
+	_hedgingPercentile = 0.0;
+
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+	TMDBRetryPolicy *policy = [[[self class] allocWithZone:zone] init];
+	policy.maximumRetries = _maximumRetries;
+	policy.initialBackoff = _initialBackoff;
+	policy.maximumBackoff = _maximumBackoff;
+	policy.retryBudgetRatio = _retryBudgetRatio;
+	policy.timeout = _timeout;
+	policy.attemptTimeout = _attemptTimeout;
+	policy.hedgingPercentile = _hedgingPercentile;
+	return policy;
+}
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@ %p: %tu retries, timeout %.1f s, hedging at %.2f>", NSStringFromClass([self class]), self, _maximumRetries, _timeout, _hedgingPercentile];
+}
+
+@end
@@ -0,0 +1,50 @@
+//
+//  TMDBTransport.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+/**
+ * A task started by a transport. The only thing a request needs to be able to
+ * do with it is to stop it.
+ */
+@protocol TMDBTransportTask <NSObject>
+
+- (void)cancel;
+
+@end
+
+/**
+ * The callbacks a transport delivers for a task. Callbacks for a single task
+ * are serialized, but are not delivered on the main thread.
+ */
+@protocol TMDBTransportDelegate <NSObject>
+
+- (void)transportTask:(nonnull id<TMDBTransportTask>)task didReceiveResponse:(nonnull NSURLResponse *)response;
+- (void)transportTask:(nonnull id<TMDBTransportTask>)task didReceiveData:(nonnull NSData *)data;
+- (void)transportTask:(nonnull id<TMDBTransportTask>)task didCompleteWithError:(nullable NSError *)error;
+
+@optional
+
+/**
+ * Reports the time spent setting up the task's connection, right before the
+ * task completes. Not called by transports that can't measure it.
+ */
+- (void)transportTask:(nonnull id<TMDBTransportTask>)task didMeasureConnectDuration:(NSTimeInterval)duration;
+
+@end
+
+// Private protocol
+@protocol TMDBTransport <NSObject>
+
+/**
+ * Starts loading `request`, and returns the running task. The delegate is
+ * retained until the task has completed.
+ */
+- (nullable id<TMDBTransportTask>)startTaskWithRequest:(nonnull NSURLRequest *)request delegate:(nonnull id<TMDBTransportDelegate>)delegate;
+
+@end
@@ -0,0 +1,30 @@
+//
+//  TMDBURLSessionTransport.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBTransport.h"
+
+// Private class
+@interface TMDBURLSessionTransport : NSObject <TMDBTransport>
+
+/**
+ * The transport used by `TMDBRequest` unless another one has been set. All
+ * requests share one session, so connections to the API host are kept alive
+ * and reused between requests.
+ */
++ (nonnull instancetype)sharedTransport;
+
+- (nonnull instancetype)initWithSessionConfiguration:(nonnull NSURLSessionConfiguration *)configuration NS_DESIGNATED_INITIALIZER;
+
+/**
+ * The serial background queue on which all delegate callbacks are delivered.
+ */
+@property (nonatomic, strong, nonnull, readonly) NSOperationQueue *delegateQueue;
+
+@end
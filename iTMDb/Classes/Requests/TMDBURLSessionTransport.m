@@ -0,0 +1,133 @@
+//
+//  TMDBURLSessionTransport.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBURLSessionTransport.h"
+
+@interface NSURLSessionTask (TMDBTransportTask) <TMDBTransportTask>
+
+@end
+
+@implementation NSURLSessionTask (TMDBTransportTask)
+
+@end
+
+@interface TMDBURLSessionTransport () <NSURLSessionDataDelegate>
+
+@end
+
+@implementation TMDBURLSessionTransport {
+@private
+	NSURLSession *_session;
+	NSMutableDictionary<NSNumber *, id<TMDBTransportDelegate>> *_delegates;
+}
+
++ (instancetype)sharedTransport {
+	static TMDBURLSessionTransport *sharedTransport;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+		configuration.timeoutIntervalForRequest = 30.0;
+		configuration.HTTPMaximumConnectionsPerHost = 6;
+		configuration.HTTPAdditionalHeaders = @{@"Accept": @"application/json"};
+		// Responses are cached by TMDBResponseCache, which knows the API
+		configuration.URLCache = nil;
+		configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+		sharedTransport = [[self alloc] initWithSessionConfiguration:configuration];
+	});
+	return sharedTransport;
+}
+
+- (instancetype)init {
+	return (self = [self initWithSessionConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration]]);
+}
+
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration {
+	NSParameterAssert(configuration != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_delegateQueue = [[NSOperationQueue alloc] init];
+	_delegateQueue.name = [NSStringFromClass([self class]) stringByAppendingString:@"DelegateQueue"];
+	_delegateQueue.maxConcurrentOperationCount = 1;
+
+	_delegates = [NSMutableDictionary dictionary];
+	_session = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:_delegateQueue];
+
+	return self;
+}
+
+#pragma mark - TMDBTransport
+
+- (id<TMDBTransportTask>)startTaskWithRequest:(NSURLRequest *)request delegate:(id<TMDBTransportDelegate>)delegate {
+	NSParameterAssert(request != nil);
+	NSParameterAssert(delegate != nil);
+
+	NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
+	if (task == nil) {
+		return nil;
+	}
+
+	@synchronized(_delegates) {
+		_delegates[@(task.taskIdentifier)] = delegate;
+	}
+
+	[task resume];
+
+	return task;
+}
+
+#pragma mark -
+
+- (id<TMDBTransportDelegate>)delegateForTask:(NSURLSessionTask *)task remove:(BOOL)remove {
+	NSNumber *key = @(task.taskIdentifier);
+
+	@synchronized(_delegates) {
+		id<TMDBTransportDelegate> delegate = _delegates[key];
+		if (remove) {
+			[_delegates removeObjectForKey:key];
+		}
+		return delegate;
+	}
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+	[[self delegateForTask:dataTask remove:NO] transportTask:dataTask didReceiveResponse:response];
+	completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+	[[self delegateForTask:dataTask remove:NO] transportTask:dataTask didReceiveData:data];
+}
+
+// GNUstep has no task metrics
+#ifndef GNUSTEP
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(macos(10.12), ios(10.0), tvos(10.0), watchos(3.0)) {
+	id<TMDBTransportDelegate> delegate = [self delegateForTask:task remove:NO];
+	if (![delegate respondsToSelector:@selector(transportTask:didMeasureConnectDuration:)]) {
+		return;
+	}
+
+	// A reused connection has no connect dates
+	NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+	NSDate *start = transaction.domainLookupStartDate ?: transaction.connectStartDate;
+	NSDate *end = transaction.connectEndDate;
+	NSTimeInterval duration = (start != nil && end != nil) ? [end timeIntervalSinceDate:start] : 0;
+
+	[delegate transportTask:task didMeasureConnectDuration:duration];
+}
+#endif
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+	[[self delegateForTask:task remove:YES] transportTask:task didCompleteWithError:error];
+}
+
+@end
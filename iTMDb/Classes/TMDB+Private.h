@@ -0,0 +1,35 @@
+//
+//  TMDB+Private.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDB.h"
+
+@class TMDBIdentityMap;
+@class TMDBResponseCache;
+@class TMDBMetricsRecorder;
+@class TMDBRetryBudget;
+@class TMDBLatencyTracker;
+
+// Private methods shared with the model classes
+@interface TMDB (Private)
+
+/** The canonical persons and languages of the movies loaded by the context. */
+- (nonnull TMDBIdentityMap *)identityMap;
+
+/** The cache of the responses to requests made through the context. */
+- (nonnull TMDBResponseCache *)responseCache;
+
+/** The recorder of the metrics of requests made through the context. */
+- (nonnull TMDBMetricsRecorder *)metricsRecorder;
+
+/** The allowance for retries and hedges of requests made through the context. */
+- (nonnull TMDBRetryBudget *)retryBudget;
+
+/** The recent response times of requests made through the context. */
+- (nonnull TMDBLatencyTracker *)latencyTracker;
+
+@end
@@ -11,6 +11,11 @@
 #import "TMDBMovie.h"
 #import "TMDBError.h"
 #import "TMDBConfiguration.h"
+#import "TMDBRetryPolicy.h"
+
+@protocol TMDBRequestMetricsObserver;
+@class TMDBRequestHistogram;
+@class TMDBMovieTitleIndex;
 
 /**
  * A string value indicating the URL base of the API.
@@ -23,8 +28,29 @@ extern NSString * _Nonnull const TMDBAPIURLBase;
 extern NSString * _Nonnull const TMDBAPIVersion;
 
 /**
- * The `TMDB` singleton instance is used as the TMDb context for all requests to
- * the TMDb API.
+ * The groups of API endpoints for which the response cache lifetime can be
+ * set.
+ */
+typedef NS_ENUM(NSUInteger, TMDBCacheEndpoint) {
+	/** The `/configuration` endpoint. Default lifetime 3 days. */
+	TMDBCacheEndpointConfiguration,
+	/** Movie details. Default lifetime 1 day. */
+	TMDBCacheEndpointMovie,
+	/** Search results. Default lifetime 1 hour. */
+	TMDBCacheEndpointSearch,
+	/** Person details. Default lifetime 1 day. */
+	TMDBCacheEndpointPerson,
+	/** All other endpoints, including change feeds. Not cached by default. */
+	TMDBCacheEndpointOther
+};
+
+/**
+ * A `TMDB` object is a context for requests to the TMDb API. It holds its own
+ * API key, language, configuration, completion queue and response cache.
+ *
+ * The shared instance is used by every call that isn't given a context. Create
+ * more contexts to use several API keys or languages side by side, and spread
+ * work across them with a `TMDBContextPool`.
  */
 @interface TMDB : NSObject
 
@@ -32,6 +58,16 @@ extern NSString * _Nonnull const TMDBAPIVersion;
 
 + (nonnull instancetype)sharedInstance;
 
+/** @name Creating a Context */
+
+/**
+ * Creates a context independent of the shared instance.
+ *
+ * @param apiKey The API key used by the context.
+ * @param language The language used by the context. Pass `nil` for English.
+ */
+- (nonnull instancetype)initWithAPIKey:(nullable NSString *)apiKey language:(nullable NSString *)language;
+
 /** @name Context Settings */
 
 /** The API key used by the context. Required. */
@@ -40,6 +76,118 @@ extern NSString * _Nonnull const TMDBAPIVersion;
 /** The language used by the context. Default `@"en"` (English). Optional. */
 @property (nonatomic, copy, nonnull) NSString *language;
 
+/**
+ * The queue on which completion blocks are called, unless another queue is
+ * passed with the call itself. Responses are decoded and model objects
+ * populated on a background queue before the completion block is dispatched
+ * here. Default is the main queue.
+ */
+@property (nonatomic, strong, null_resettable) dispatch_queue_t completionQueue;
+
+/** @name Rate Limiting */
+
+/**
+ * Sets the request budget for the context's API key. No more than `requests`
+ * requests are started within any `window` seconds, and requests beyond that
+ * wait for their turn. Default 40 requests per 10 seconds.
+ *
+ * The budget belongs to the API key, so contexts using the same key share it,
+ * and setting it through one of them changes it for all. A context given a
+ * key that is already in use adopts the existing budget instead of replacing
+ * it. The budget is lowered automatically while TMDb responds with `429`
+ * errors.
+ */
+- (void)setRateLimitRequests:(NSUInteger)requests perWindow:(NSTimeInterval)window;
+
+/**
+ * The number of requests allowed within `rateLimitWindow` by the budget of
+ * the context's API key, including changes made through other contexts with
+ * the same key. Only changes made through this context are observable.
+ */
+@property (nonatomic, readonly) NSUInteger rateLimitRequests;
+
+/** The length of the rate limit window of the API key's budget in seconds. */
+@property (nonatomic, readonly) NSTimeInterval rateLimitWindow;
+
+/** @name Retrying */
+
+/**
+ * How requests recover from slow and failed connections. The policy is
+ * copied when set, and read when a request is created. Setting it to `nil`
+ * restores the default policy.
+ */
+@property (atomic, copy, null_resettable) TMDBRetryPolicy *retryPolicy;
+
+/** @name Caching */
+
+/**
+ * Sets the number of seconds responses from `endpoint` are used without
+ * asking the server. Once a response has expired, it is revalidated using
+ * `If-None-Match` and `If-Modified-Since`, so unchanged data isn't downloaded
+ * again. Pass `0` to disable caching for the endpoint.
+ */
+- (void)setCacheLifetime:(NSTimeInterval)lifetime forEndpoint:(TMDBCacheEndpoint)endpoint;
+
+- (NSTimeInterval)cacheLifetimeForEndpoint:(TMDBCacheEndpoint)endpoint;
+
+/**
+ * The number of bytes of decoded responses kept in memory. Default 4 MB.
+ * Memory is purged when the system is low on memory.
+ */
+@property (nonatomic) NSUInteger cacheMemoryCapacity;
+
+/**
+ * The number of bytes of raw responses kept on disk. Default 20 MB.
+ *
+ * Every context has its own response cache, but only the shared instance keeps
+ * responses on disk. Other contexts keep theirs in memory only.
+ */
+@property (nonatomic) NSUInteger cacheDiskCapacity;
+
+/** Removes all of the context's cached responses from memory and disk. */
+- (void)removeAllCachedResponses;
+
+/** @name Measuring Requests */
+
+/**
+ * Registers an observer for the metrics of every request made through the
+ * context, and starts measuring them. Requests are only measured while at
+ * least one observer is registered, and cost next to nothing extra otherwise.
+ * Observers are held weakly.
+ *
+ * Identical requests from contexts with the same API key and language share
+ * a single download, which is measured by the context that started it.
+ */
+- (void)addRequestMetricsObserver:(nonnull id<TMDBRequestMetricsObserver>)observer;
+
+- (void)removeRequestMetricsObserver:(nonnull id<TMDBRequestMetricsObserver>)observer;
+
+/**
+ * Snapshots of the durations of the requests the context has measured so far,
+ * keyed by their `TMDBCacheEndpoint`. Endpoints without any measured requests are left out.
+ */
+- (nonnull NSDictionary<NSNumber *, TMDBRequestHistogram *> *)requestHistograms;
+
+/** Clears the counts behind `requestHistograms`. */
+- (void)resetRequestHistograms;
+
+/** @name Populating Movies */
+
+/**
+ * How movies loaded through the context are populated. Default `0`, which
+ * decodes everything up front and keeps `rawResults`.
+ */
+@property (atomic) TMDBMoviePopulateOptions moviePopulateOptions;
+
+/** @name Searching Locally */
+
+/**
+ * The index every movie populated through the context is added to, and which
+ * `TMDBMovieSearch` searches before asking TMDb. Default `nil`, which always
+ * searches TMDb. Several contexts may share an index.
+ */
+@property (atomic, strong, nullable) TMDBMovieTitleIndex *titleIndex;
+
 /** @name Getting Configuration */
 
 /** The TMDb configuration. */
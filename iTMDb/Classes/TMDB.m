@@ -7,34 +7,205 @@
 //
 
 #import "TMDB.h"
+#import "TMDBRateLimiter.h"
+#import "TMDBResponseCache.h"
+#import "TMDB+Private.h"
+#import "TMDBIdentityMap.h"
+#import "TMDBConfiguration+Private.h"
+#import "TMDBMetricsRecorder.h"
+#import "TMDBRetryBudget.h"
 
 NSString * const TMDBAPIURLBase = @"http://api.themoviedb.org/";
 NSString * const TMDBAPIVersion = @"3";
 
-@implementation TMDB
+@implementation TMDB {
+@private
+	TMDBIdentityMap *_identityMap;
+	TMDBResponseCache *_responseCache;
+	TMDBMetricsRecorder *_metricsRecorder;
+	TMDBRetryBudget *_retryBudget;
+	TMDBLatencyTracker *_latencyTracker;
+}
+
+@synthesize retryPolicy=_retryPolicy;
 
 + (instancetype)sharedInstance {
 	static TMDB *sharedInstance;
 	static dispatch_once_t onceToken;
 	dispatch_once(&onceToken, ^{
-		sharedInstance = [[self alloc] init];
+		sharedInstance = [[self alloc] initWithAPIKey:nil language:nil responseCache:[TMDBResponseCache sharedCache]];
 	});
 	return sharedInstance;
 }
 
 - (instancetype)init {
+	return (self = [self initWithAPIKey:nil language:nil]);
+}
+
+- (instancetype)initWithAPIKey:(NSString *)apiKey language:(NSString *)language {
+	// Only the shared instance keeps responses on disk, so contexts don't
+	// compete for the same cache directory.
+	return (self = [self initWithAPIKey:apiKey language:language responseCache:[[TMDBResponseCache alloc] initWithDirectoryURL:nil]]);
+}
+
+// Private
+- (instancetype)initWithAPIKey:(NSString *)apiKey language:(NSString *)language responseCache:(TMDBResponseCache *)responseCache {
 	if (!(self = [super init])) {
 		return nil;
 	}
 
-	_configuration = [[TMDBConfiguration alloc] init];
-	_language = @"en";
+	_configuration = [[TMDBConfiguration alloc] initWithContext:self];
+	_identityMap = [[TMDBIdentityMap alloc] initWithContext:self];
+	_responseCache = responseCache;
+	_metricsRecorder = [[TMDBMetricsRecorder alloc] init];
+	_retryBudget = [[TMDBRetryBudget alloc] init];
+	_latencyTracker = [[TMDBLatencyTracker alloc] init];
+	_language = language.length > 0 ? [language copy] : @"en";
+	_retryPolicy = [[TMDBRetryPolicy alloc] init];
+
+	if (apiKey != nil) {
+		self.apiKey = apiKey;
+	}
 
 	return self;
 }
 
+#pragma mark - Rate Limiting
+
+- (void)setRateLimitRequests:(NSUInteger)requests perWindow:(NSTimeInterval)window {
+	[self willChangeValueForKey:@"rateLimitRequests"];
+	[self willChangeValueForKey:@"rateLimitWindow"];
+	[[TMDBRateLimiter rateLimiterForAPIKey:self.apiKey] setRequestsPerWindow:requests window:window];
+	[self didChangeValueForKey:@"rateLimitWindow"];
+	[self didChangeValueForKey:@"rateLimitRequests"];
+}
+
+// The budget belongs to the key, so it's read from the limiter every time and
+// a change made through another context with the same key is seen here too.
+- (NSUInteger)rateLimitRequests {
+	return [TMDBRateLimiter rateLimiterForAPIKey:self.apiKey].requestsPerWindow;
+}
+
+- (NSTimeInterval)rateLimitWindow {
+	return [TMDBRateLimiter rateLimiterForAPIKey:self.apiKey].window;
+}
+
+#pragma mark - Retrying
+
+- (TMDBRetryPolicy *)retryPolicy {
+	@synchronized(self) {
+		return _retryPolicy;
+	}
+}
+
+- (void)setRetryPolicy:(TMDBRetryPolicy *)retryPolicy {
+	@synchronized(self) {
+		_retryPolicy = [retryPolicy copy] ?: [[TMDBRetryPolicy alloc] init];
+	}
+}
+
+#pragma mark - Caching
+
+- (void)setCacheLifetime:(NSTimeInterval)lifetime forEndpoint:(TMDBCacheEndpoint)endpoint {
+	[_responseCache setLifetime:lifetime forEndpoint:endpoint];
+}
+
+- (NSTimeInterval)cacheLifetimeForEndpoint:(TMDBCacheEndpoint)endpoint {
+	return [_responseCache lifetimeForEndpoint:endpoint];
+}
+
+- (NSUInteger)cacheMemoryCapacity {
+	return _responseCache.memoryCapacity;
+}
+
+- (void)setCacheMemoryCapacity:(NSUInteger)cacheMemoryCapacity {
+	_responseCache.memoryCapacity = cacheMemoryCapacity;
+}
+
+- (NSUInteger)cacheDiskCapacity {
+	return _responseCache.diskCapacity;
+}
+
+- (void)setCacheDiskCapacity:(NSUInteger)cacheDiskCapacity {
+	_responseCache.diskCapacity = cacheDiskCapacity;
+}
+
+- (void)removeAllCachedResponses {
+	[_responseCache removeAllResponses];
+}
+
+#pragma mark - Measuring Requests
+
+- (void)addRequestMetricsObserver:(id<TMDBRequestMetricsObserver>)observer {
+	[_metricsRecorder addObserver:observer];
+}
+
+- (void)removeRequestMetricsObserver:(id<TMDBRequestMetricsObserver>)observer {
+	[_metricsRecorder removeObserver:observer];
+}
+
+- (NSDictionary<NSNumber *, TMDBRequestHistogram *> *)requestHistograms {
+	return [_metricsRecorder histograms];
+}
+
+- (void)resetRequestHistograms {
+	[_metricsRecorder resetHistograms];
+}
+
 #pragma mark - Getters and setters
 
+- (TMDBIdentityMap *)identityMap {
+	return _identityMap;
+}
+
+- (TMDBResponseCache *)responseCache {
+	return _responseCache;
+}
+
+- (TMDBMetricsRecorder *)metricsRecorder {
+	return _metricsRecorder;
+}
+
+- (TMDBRetryBudget *)retryBudget {
+	return _retryBudget;
+}
+
+- (TMDBLatencyTracker *)latencyTracker {
+	return _latencyTracker;
+}
+
+- (void)setApiKey:(NSString *)apiKey {
+	// A budget set before the key is carried over to it, unless another
+	// context is already using the key, in which case its budget is kept and
+	// adopted.
+	TMDBRateLimiter *previousLimiter = [TMDBRateLimiter rateLimiterForAPIKey:_apiKey];
+	NSUInteger requests = previousLimiter.requestsPerWindow;
+	NSTimeInterval window = previousLimiter.window;
+
+	TMDBRateLimiter *rateLimiter = [TMDBRateLimiter rateLimiterForAPIKey:apiKey requestsPerWindow:requests window:window];
+	BOOL budgetChanged = rateLimiter.requestsPerWindow != requests || rateLimiter.window != window;
+
+	if (budgetChanged) {
+		[self willChangeValueForKey:@"rateLimitRequests"];
+		[self willChangeValueForKey:@"rateLimitWindow"];
+	}
+	_apiKey = [apiKey copy];
+	if (budgetChanged) {
+		[self didChangeValueForKey:@"rateLimitWindow"];
+		[self didChangeValueForKey:@"rateLimitRequests"];
+	}
+
+	// The configuration stored by the last launch is already in use, so this
+	// only refreshes it in the background when it has expired.
+	if (_apiKey.length > 0 && _configuration.isStale) {
+		[_configuration reload:nil];
+	}
+}
+
+- (dispatch_queue_t)completionQueue {
+	return _completionQueue ?: dispatch_get_main_queue();
+}
+
 - (void)setLanguage:(NSString *)language {
 	if (language == nil || language.length == 0) {
 		_language = @"en";
@@ -0,0 +1,58 @@
+//
+//  TMDBContextPool.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDB.h"
+
+/**
+ * A `TMDBContextPool` spreads work across several contexts, typically one per
+ * API key, so the total throughput grows with the number of request budgets.
+ */
+@interface TMDBContextPool : NSObject
+
+/** @name Creating a Pool */
+
+/**
+ * Creates a pool of the given contexts.
+ *
+ * @param contexts The contexts to spread work across. Must not be empty.
+ */
+- (nonnull instancetype)initWithContexts:(nonnull NSArray<TMDB *> *)contexts NS_DESIGNATED_INITIALIZER;
+
+- (nullable instancetype)init NS_UNAVAILABLE;
+
+/** The contexts of the pool. */
+@property (nonatomic, copy, nonnull, readonly) NSArray<TMDB *> *contexts;
+
+/** @name Spreading Work */
+
+/**
+ * Returns the context to use for the next call. Contexts take turns in
+ * proportion to their rate limit, so a context allowed twice the requests is
+ * returned twice as often.
+ */
+- (nonnull TMDB *)nextContext;
+
+/**
+ * Loads the movies with the given TMDb IDs across all contexts of the pool.
+ *
+ * Each context keeps a handful of requests in flight, and every movie is
+ * loaded through the context with the fewest requests in flight when its turn
+ * comes. Otherwise the batch behaves like
+ * `+[TMDBMovie loadMoviesWithIDs:options:completionQueue:progress:completion:]`,
+ * and `movies` holds each movie with the context it was loaded through.
+ *
+ * @param completionQueue The queue on which to call both blocks. Pass `nil` to
+ * use the `completionQueue` of the first context.
+ * @return A progress object counting finished movies. Cancel it to cancel the
+ * whole batch.
+ */
+- (nonnull NSProgress *)loadMoviesWithIDs:(nonnull NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options completionQueue:(nullable dispatch_queue_t)completionQueue progress:(nullable TMDBMovieBatchProgressBlock)progressBlock completion:(nullable TMDBMovieBatchCompletionBlock)completionBlock;
+
+@end
@@ -0,0 +1,74 @@
+//
+//  TMDBContextPool.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBContextPool.h"
+#import "TMDBMovie+Private.h"
+
+@implementation TMDBContextPool {
+@private
+	// The running weights of the smooth weighted round robin behind
+	// -nextContext, one for every context, guarded by self
+	double *_currentWeights;
+}
+
+- (instancetype)init {
+	[self doesNotRecognizeSelector:_cmd];
+	return nil;
+}
+
+- (instancetype)initWithContexts:(NSArray<TMDB *> *)contexts {
+	NSParameterAssert(contexts.count > 0);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_contexts = [contexts copy];
+	_currentWeights = calloc(_contexts.count, sizeof(double));
+
+	return self;
+}
+
+- (void)dealloc {
+	free(_currentWeights);
+}
+
+#pragma mark - Spreading Work
+
+- (TMDB *)nextContext {
+	@synchronized(self) {
+		NSUInteger count = _contexts.count;
+		NSUInteger best = 0;
+		double totalWeight = 0.0;
+
+		// Every context gains its request rate, the one ahead is picked and
+		// falls back by the total, which interleaves contexts evenly instead
+		// of handing out runs of the same one.
+		for (NSUInteger i = 0; i < count; i++) {
+			TMDB *context = _contexts[i];
+			double weight = context.rateLimitWindow > 0 ? context.rateLimitRequests / context.rateLimitWindow : 1.0;
+
+			_currentWeights[i] += weight;
+			totalWeight += weight;
+
+			if (_currentWeights[i] > _currentWeights[best]) {
+				best = i;
+			}
+		}
+
+		_currentWeights[best] -= totalWeight;
+
+		return _contexts[best];
+	}
+}
+
+- (NSProgress *)loadMoviesWithIDs:(NSArray<NSNumber *> *)tmdbIDs options:(TMDBMovieFetchOptions)options completionQueue:(dispatch_queue_t)completionQueue progress:(TMDBMovieBatchProgressBlock)progressBlock completion:(TMDBMovieBatchCompletionBlock)completionBlock {
+	return [TMDBMovie loadMoviesWithIDs:tmdbIDs options:options contexts:_contexts completionQueue:completionQueue ?: _contexts.firstObject.completionQueue progress:progressBlock completion:completionBlock];
+}
+
+@end
@@ -12,5 +12,7 @@ extern NSString * _Nonnull const TMDBErrorDomain;
 
 typedef NS_ENUM(NSUInteger, TMDBErrorCode) {
 	TMDBErrorCodeReceivedInvalidData = 1001,
-	TMDBErrorCodeInvalidURL
+	TMDBErrorCodeInvalidURL,
+	TMDBErrorCodeRateLimitExceeded,
+	TMDBErrorCodeInvalidSnapshot
 };
@@ -0,0 +1,47 @@
+//
+//  TMDBFootprint.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBImage.h"
+#import "TMDBPerson.h"
+#import "TMDBCredit.h"
+#import "TMDBLanguage.h"
+
+// Approximate heap sizes of model objects, used by -[TMDBMovie footprint].
+// Each object's allocation is measured with malloc_size(), so the numbers
+// include allocator rounding but not memory shared with other objects, such
+// as the buffers of constant strings.
+
+/** The size of a single object's own allocation. `0` for tagged pointers. */
+extern NSUInteger TMDBFootprintOfObject(id _Nullable object);
+
+/** The size of a string, including its characters. */
+extern NSUInteger TMDBFootprintOfString(NSString * _Nullable string);
+
+/**
+ * The size of a decoded JSON value, including everything it contains, such
+ * as `rawResults`.
+ */
+extern NSUInteger TMDBFootprintOfJSONObject(id _Nullable object);
+
+@interface TMDBImage (TMDBFootprint)
+- (NSUInteger)footprint;
+@end
+
+@interface TMDBPerson (TMDBFootprint)
+- (NSUInteger)footprint;
+@end
+
+@interface TMDBCredit (TMDBFootprint)
+- (NSUInteger)footprint;
+@end
+
+@interface TMDBLanguage (TMDBFootprint)
+- (NSUInteger)footprint;
+@end
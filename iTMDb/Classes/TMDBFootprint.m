@@ -0,0 +1,77 @@
+//
+//  TMDBFootprint.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBFootprint.h"
+
+#include <malloc/malloc.h>
+#include <objc/runtime.h>
+
+NSUInteger TMDBFootprintOfObject(id object) {
+	if (object == nil) {
+		return 0;
+	}
+
+	// malloc_size() returns 0 for tagged pointers and objects that weren't
+	// allocated with malloc, such as constant strings.
+	return malloc_size((__bridge const void *)object);
+}
+
+NSUInteger TMDBFootprintOfString(NSString *string) {
+	NSUInteger size = TMDBFootprintOfObject(string);
+	if (size == 0) {
+		return 0;
+	}
+
+	// Short strings keep their characters inline, longer ones in a separate
+	// buffer. Either way, the characters take at least this much.
+	NSUInteger characters = string.length * (string.fastestEncoding == NSUnicodeStringEncoding ? 2 : 1);
+
+	return MAX(size, class_getInstanceSize(object_getClass(string)) + characters);
+}
+
+NSUInteger TMDBFootprintOfJSONObject(id object) {
+	if ([object isKindOfClass:[NSString class]]) {
+		return TMDBFootprintOfString(object);
+	}
+
+	NSUInteger size = TMDBFootprintOfObject(object);
+
+	if ([object isKindOfClass:[NSDictionary class]]) {
+		for (id key in (NSDictionary *)object) {
+			size += TMDBFootprintOfJSONObject(key);
+			size += TMDBFootprintOfJSONObject(((NSDictionary *)object)[key]);
+		}
+	}
+	else if ([object isKindOfClass:[NSArray class]]) {
+		for (id element in (NSArray *)object) {
+			size += TMDBFootprintOfJSONObject(element);
+		}
+	}
+
+	return size;
+}
+
+@implementation TMDBCredit (TMDBFootprint)
+
+- (NSUInteger)footprint {
+	return TMDBFootprintOfObject(self) +
+		   TMDBFootprintOfString(self.character) +
+		   TMDBFootprintOfString(self.job) +
+		   TMDBFootprintOfString(self.department) +
+		   self.person.footprint;
+}
+
+@end
+
+@implementation TMDBLanguage (TMDBFootprint)
+
+- (NSUInteger)footprint {
+	return TMDBFootprintOfObject(self) + TMDBFootprintOfString(self.name) + TMDBFootprintOfString(self.iso639_1);
+}
+
+@end
@@ -0,0 +1,49 @@
+//
+//  TMDBIdentityMap.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+@class TMDB;
+@class TMDBPerson;
+@class TMDBLanguage;
+
+/**
+ * Hands out one canonical instance per person and language, so the same
+ * actor or language appearing in many movies is only kept in memory once.
+ *
+ * Instances are held weakly, and are gone once no movie uses them anymore.
+ * Safe to use from any thread.
+ */
+// Private class
+@interface TMDBIdentityMap : NSObject
+
+/**
+ * Creates an identity map whose persons are updated through `context`. The
+ * context isn't retained. Pass `nil` to use the shared instance.
+ */
+- (nonnull instancetype)initWithContext:(nullable TMDB *)context NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Returns the canonical person for the `id` in `personInfo`, creating it if
+ * needed. The person's own information, such as its name, is filled in from
+ * `personInfo` where it's missing. Returns a new, unshared person if
+ * `personInfo` has no ID.
+ */
+- (nonnull TMDBPerson *)personWithInfo:(nonnull NSDictionary *)personInfo;
+
+/**
+ * Returns the canonical language for the `iso_639_1` code in `dictionary`,
+ * creating it if needed. Returns a new, unshared language if `dictionary` has
+ * no code.
+ */
+- (nonnull TMDBLanguage *)languageWithDictionary:(nonnull NSDictionary *)dictionary;
+
+/** Forgets all canonical instances. Objects already in use are unaffected. */
+- (void)removeAllObjects;
+
+@end
@@ -0,0 +1,89 @@
+//
+//  TMDBIdentityMap.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBIdentityMap.h"
+#import "TMDBPerson.h"
+#import "TMDBPerson+Private.h"
+#import "TMDBLanguage.h"
+
+@implementation TMDBIdentityMap {
+@private
+	// Both tables are guarded by self
+	NSMapTable<NSNumber *, TMDBPerson *> *_persons;
+	NSMapTable<NSString *, TMDBLanguage *> *_languages;
+
+	// The context owns the identity map
+	__weak TMDB *_context;
+}
+
+- (instancetype)init {
+	return (self = [self initWithContext:nil]);
+}
+
+- (instancetype)initWithContext:(TMDB *)context {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_context = context;
+
+	_persons = [NSMapTable strongToWeakObjectsMapTable];
+	_languages = [NSMapTable strongToWeakObjectsMapTable];
+
+	return self;
+}
+
+- (TMDBPerson *)personWithInfo:(NSDictionary *)personInfo {
+	NSNumber *personID = TMDB_NSNumberOrNil(personInfo[@"id"]);
+
+	if (personID == nil) {
+		TMDBPerson *person = [[TMDBPerson alloc] initWithID:0 context:_context];
+		[person populateIdentity:personInfo];
+		return person;
+	}
+
+	TMDBPerson *person = nil;
+
+	@synchronized(self) {
+		person = [_persons objectForKey:personID];
+		if (person == nil) {
+			person = [[TMDBPerson alloc] initWithID:personID.unsignedIntegerValue context:_context];
+			[_persons setObject:person forKey:personID];
+		}
+	}
+
+	[person populateIdentity:personInfo];
+
+	return person;
+}
+
+- (TMDBLanguage *)languageWithDictionary:(NSDictionary *)dictionary {
+	NSString *code = TMDB_NSStringOrNil(dictionary[@"iso_639_1"]);
+
+	if (code == nil) {
+		return [[TMDBLanguage alloc] initWithDictionary:dictionary];
+	}
+
+	@synchronized(self) {
+		TMDBLanguage *language = [_languages objectForKey:code];
+		if (language == nil) {
+			language = [[TMDBLanguage alloc] initWithDictionary:dictionary];
+			[_languages setObject:language forKey:code];
+		}
+		return language;
+	}
+}
+
+- (void)removeAllObjects {
+	@synchronized(self) {
+		[_persons removeAllObjects];
+		[_languages removeAllObjects];
+	}
+}
+
+@end
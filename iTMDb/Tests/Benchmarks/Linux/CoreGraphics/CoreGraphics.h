@@ -0,0 +1,30 @@
+//
+//  CoreGraphics.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+// The geometry types the framework uses from Core Graphics, for building the
+// benchmarks with GNUstep.
+
+#ifndef TMDBCoreGraphics_h
+#define TMDBCoreGraphics_h
+
+#ifndef CGFLOAT_DEFINED
+	typedef double CGFloat;
+	#define CGFLOAT_DEFINED 1
+#endif
+
+typedef struct CGSize {
+	CGFloat width;
+	CGFloat height;
+} CGSize;
+
+static inline CGSize CGSizeMake(CGFloat width, CGFloat height) {
+	CGSize size = {width, height};
+	return size;
+}
+
+#endif // TMDBCoreGraphics_h
@@ -0,0 +1,62 @@
+//
+//  TMDBLinuxCompat.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+// Included ahead of every file when building the benchmarks with GNUstep.
+// Fills in the few Core Foundation and Darwin functions the framework uses
+// that GNUstep doesn't have.
+
+#ifndef TMDBLinuxCompat_h
+#define TMDBLinuxCompat_h
+
+#ifndef __APPLE__
+
+#import <Foundation/Foundation.h>
+
+#include <dispatch/dispatch.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef TARGET_OS_IPHONE
+	#define TARGET_OS_IPHONE 0
+#endif
+
+#ifndef API_AVAILABLE
+	#define API_AVAILABLE(...)
+#endif
+
+typedef double CFAbsoluteTime;
+
+// Seconds since 1 January 2001, like on Darwin
+static inline CFAbsoluteTime CFAbsoluteTimeGetCurrent(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return (double)now.tv_sec - 978307200.0 + now.tv_nsec / 1e9;
+}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	#define CFSwapInt32HostToLittle(x) ((uint32_t)(x))
+	#define CFSwapInt32LittleToHost(x) ((uint32_t)(x))
+	#define CFSwapInt64HostToLittle(x) ((uint64_t)(x))
+	#define CFSwapInt64LittleToHost(x) ((uint64_t)(x))
+#else
+	#define CFSwapInt32HostToLittle(x) __builtin_bswap32((uint32_t)(x))
+	#define CFSwapInt32LittleToHost(x) __builtin_bswap32((uint32_t)(x))
+	#define CFSwapInt64HostToLittle(x) __builtin_bswap64((uint64_t)(x))
+	#define CFSwapInt64LittleToHost(x) __builtin_bswap64((uint64_t)(x))
+#endif
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 36)
+static inline uint32_t arc4random_uniform(uint32_t upperBound) {
+	return upperBound > 0 ? (uint32_t)(random() % upperBound) : 0;
+}
+#endif
+
+#endif // __APPLE__
+
+#endif // TMDBLinuxCompat_h
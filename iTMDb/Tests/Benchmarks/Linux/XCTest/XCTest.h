@@ -0,0 +1,119 @@
+//
+//  XCTest.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+// Just enough of XCTest to run the benchmarks and the test cases they build
+// on where there is no XCTest, such as Linux with GNUstep. XCTest.m has a
+// main() that runs every test case linked in, or those named on the command
+// line.
+
+#import <Foundation/Foundation.h>
+
+typedef void (^XCWaitCompletionHandler)(NSError * _Nullable error);
+
+@interface XCTestExpectation : NSObject
+
+@property (nonatomic, copy, nonnull, readonly) NSString *expectationDescription;
+
+- (void)fulfill;
+
+@end
+
+@interface XCTestCase : NSObject
+
++ (void)setUp;
++ (void)tearDown;
+
+- (nonnull instancetype)initWithSelector:(nonnull SEL)selector;
+
+@property (nonatomic, assign, readonly, nonnull) SEL selector;
+
+- (void)setUp;
+- (void)tearDown;
+
+- (nonnull XCTestExpectation *)expectationWithDescription:(nonnull NSString *)description;
+
+/** Runs the main run loop until every expectation is fulfilled, or fails. */
+- (void)waitForExpectationsWithTimeout:(NSTimeInterval)timeout handler:(nullable XCWaitCompletionHandler)handler;
+
+- (void)recordFailureWithDescription:(nonnull NSString *)description inFile:(nonnull NSString *)filePath atLine:(NSUInteger)lineNumber expected:(BOOL)expected;
+
+@end
+
+#pragma mark - Assertions
+
+/** Describes a value of any type the comparison assertions are used with. */
+extern NSString * _Nonnull _XCTDescriptionForValue(const void * _Nonnull value, const char * _Nonnull objCType);
+
+#define _XCTRecordFailure(test, ...) \
+	[self recordFailureWithDescription:[NSString stringWithFormat:@"%@ %@", test, [NSString stringWithFormat:@"" __VA_ARGS__]] inFile:@(__FILE__) atLine:__LINE__ expected:YES]
+
+#define XCTFail(...) \
+	_XCTRecordFailure(@"failed", __VA_ARGS__)
+
+#define XCTAssertTrue(expression, ...) \
+	do { \
+		if (!(expression)) { \
+			_XCTRecordFailure(@"(" #expression ") is not true", __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define XCTAssert(expression, ...) \
+	XCTAssertTrue(expression, __VA_ARGS__)
+
+#define XCTAssertFalse(expression, ...) \
+	do { \
+		if ((expression)) { \
+			_XCTRecordFailure(@"(" #expression ") is not false", __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define XCTAssertNil(expression, ...) \
+	do { \
+		id _value = (expression); \
+		if (_value != nil) { \
+			_XCTRecordFailure(([NSString stringWithFormat:@"(" #expression ") is not nil: %@", _value]), __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define XCTAssertNotNil(expression, ...) \
+	do { \
+		if ((expression) == nil) { \
+			_XCTRecordFailure(@"(" #expression ") is nil", __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define XCTAssertEqualObjects(expression1, expression2, ...) \
+	do { \
+		id _value1 = (expression1); \
+		id _value2 = (expression2); \
+		if (_value1 != _value2 && ![_value1 isEqual:_value2]) { \
+			_XCTRecordFailure(([NSString stringWithFormat:@"(" #expression1 ") equal to (" #expression2 "): %@ != %@", _value1, _value2]), __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define _XCTAssertCompare(expression1, operator, expression2, ...) \
+	do { \
+		__typeof__(expression1) _value1 = (expression1); \
+		__typeof__(expression2) _value2 = (expression2); \
+		if (!(_value1 operator _value2)) { \
+			_XCTRecordFailure(([NSString stringWithFormat:@"(" #expression1 ") " #operator " (" #expression2 "): %@ vs %@", _XCTDescriptionForValue(&_value1, @encode(__typeof__(_value1))), _XCTDescriptionForValue(&_value2, @encode(__typeof__(_value2)))]), __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define XCTAssertEqual(expression1, expression2, ...) \
+	_XCTAssertCompare(expression1, ==, expression2, __VA_ARGS__)
+#define XCTAssertNotEqual(expression1, expression2, ...) \
+	_XCTAssertCompare(expression1, !=, expression2, __VA_ARGS__)
+#define XCTAssertLessThan(expression1, expression2, ...) \
+	_XCTAssertCompare(expression1, <, expression2, __VA_ARGS__)
+#define XCTAssertLessThanOrEqual(expression1, expression2, ...) \
+	_XCTAssertCompare(expression1, <=, expression2, __VA_ARGS__)
+#define XCTAssertGreaterThan(expression1, expression2, ...) \
+	_XCTAssertCompare(expression1, >, expression2, __VA_ARGS__)
+#define XCTAssertGreaterThanOrEqual(expression1, expression2, ...) \
+	_XCTAssertCompare(expression1, >=, expression2, __VA_ARGS__)
@@ -0,0 +1,232 @@
+//
+//  XCTest.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "XCTest.h"
+
+#import <objc/runtime.h>
+
+// Failures recorded by the test running now, from any thread
+static NSUInteger XCTFailureCount;
+
+NSString *_XCTDescriptionForValue(const void *value, const char *objCType) {
+	switch (objCType[0]) {
+		case 'c': return @(*(const char *)value).description;
+		case 'C': return @(*(const unsigned char *)value).description;
+		case 'B': return *(const bool *)value ? @"YES" : @"NO";
+		case 's': return @(*(const short *)value).description;
+		case 'S': return @(*(const unsigned short *)value).description;
+		case 'i': return @(*(const int *)value).description;
+		case 'I': return @(*(const unsigned int *)value).description;
+		case 'l': return @(*(const long *)value).description;
+		case 'L': return @(*(const unsigned long *)value).description;
+		case 'q': return @(*(const long long *)value).description;
+		case 'Q': return @(*(const unsigned long long *)value).description;
+		case 'f': return @(*(const float *)value).description;
+		case 'd': return @(*(const double *)value).description;
+		case '@': return [NSString stringWithFormat:@"%@", *(__unsafe_unretained const id *)value];
+		default: return [NSValue valueWithBytes:value objCType:objCType].description;
+	}
+}
+
+@implementation XCTestExpectation {
+@private
+	BOOL _fulfilled;
+}
+
+- (instancetype)initWithDescription:(NSString *)description {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_expectationDescription = [description copy];
+
+	return self;
+}
+
+- (void)fulfill {
+	@synchronized(self) {
+		_fulfilled = YES;
+	}
+}
+
+- (BOOL)isFulfilled {
+	@synchronized(self) {
+		return _fulfilled;
+	}
+}
+
+@end
+
+@implementation XCTestCase {
+@private
+	NSMutableArray<XCTestExpectation *> *_expectations;
+}
+
++ (void)setUp {
+}
+
++ (void)tearDown {
+}
+
+- (instancetype)initWithSelector:(SEL)selector {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_selector = selector;
+	_expectations = [NSMutableArray array];
+
+	return self;
+}
+
+- (void)setUp {
+}
+
+- (void)tearDown {
+}
+
+- (XCTestExpectation *)expectationWithDescription:(NSString *)description {
+	XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:description];
+	[_expectations addObject:expectation];
+	return expectation;
+}
+
+- (void)waitForExpectationsWithTimeout:(NSTimeInterval)timeout handler:(XCWaitCompletionHandler)handler {
+	NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+	NSArray<XCTestExpectation *> *unfulfilled = nil;
+
+	while (YES) {
+		unfulfilled = [_expectations filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(XCTestExpectation *expectation, NSDictionary *bindings) {
+			return ![expectation isFulfilled];
+		}]];
+		if (unfulfilled.count == 0 || deadline.timeIntervalSinceNow <= 0) {
+			break;
+		}
+		@autoreleasepool {
+			[[NSRunLoop mainRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+		}
+	}
+
+	[_expectations removeAllObjects];
+
+	NSError *error = nil;
+	if (unfulfilled.count > 0) {
+		[self recordFailureWithDescription:[NSString stringWithFormat:@"Timed out waiting for %@", [unfulfilled valueForKey:@"expectationDescription"]] inFile:@(__FILE__) atLine:__LINE__ expected:NO];
+		error = [NSError errorWithDomain:@"com.apple.XCTestErrorDomain" code:0 userInfo:nil];
+	}
+	if (handler != nil) {
+		handler(error);
+	}
+}
+
+- (void)recordFailureWithDescription:(NSString *)description inFile:(NSString *)filePath atLine:(NSUInteger)lineNumber expected:(BOOL)expected {
+	@synchronized([XCTestCase class]) {
+		XCTFailureCount++;
+	}
+	fprintf(stderr, "%s:%lu: error: -[%s %s] : %s\n", filePath.UTF8String, (unsigned long)lineNumber, class_getName([self class]), sel_getName(_selector), description.UTF8String);
+}
+
+@end
+
+#pragma mark - Running
+
+static BOOL XCTIsTestCaseClass(Class cls) {
+	for (Class superclass = class_getSuperclass(cls); superclass != Nil; superclass = class_getSuperclass(superclass)) {
+		if (superclass == [XCTestCase class]) {
+			return YES;
+		}
+	}
+	return NO;
+}
+
+// The test methods of a class itself and its test case superclasses, by name
+static NSArray<NSString *> *XCTTestMethodNames(Class cls) {
+	NSMutableSet<NSString *> *names = [NSMutableSet set];
+	for (Class c = cls; c != [XCTestCase class]; c = class_getSuperclass(c)) {
+		unsigned int count = 0;
+		Method *methods = class_copyMethodList(c, &count);
+		for (unsigned int i = 0; i < count; i++) {
+			NSString *name = @(sel_getName(method_getName(methods[i])));
+			if ([name hasPrefix:@"test"] && ![name containsString:@":"]) {
+				[names addObject:name];
+			}
+		}
+		free(methods);
+	}
+	return [names.allObjects sortedArrayUsingSelector:@selector(compare:)];
+}
+
+int main(int argc, const char *argv[]) {
+	@autoreleasepool {
+		// Test case classes to run; all of them if none are named
+		NSMutableSet<NSString *> *only = [NSMutableSet set];
+		for (int i = 1; i < argc; i++) {
+			[only addObject:@(argv[i])];
+		}
+
+		NSMutableArray<Class> *classes = [NSMutableArray array];
+		unsigned int classCount = 0;
+		Class *classList = objc_copyClassList(&classCount);
+		for (unsigned int i = 0; i < classCount; i++) {
+			if (XCTIsTestCaseClass(classList[i]) && (only.count == 0 || [only containsObject:@(class_getName(classList[i]))])) {
+				[classes addObject:classList[i]];
+			}
+		}
+		free(classList);
+		[classes sortUsingComparator:^NSComparisonResult(Class a, Class b) {
+			return [@(class_getName(a)) compare:@(class_getName(b))];
+		}];
+
+		NSUInteger testCount = 0, failedCount = 0;
+
+		for (Class cls in classes) {
+			NSArray<NSString *> *names = XCTTestMethodNames(cls);
+			if (names.count == 0) {
+				continue;
+			}
+
+			[cls setUp];
+
+			for (NSString *name in names) {
+				@autoreleasepool {
+					SEL selector = NSSelectorFromString(name);
+					XCTestCase *test = [[cls alloc] initWithSelector:selector];
+					NSUInteger failuresBefore;
+					@synchronized([XCTestCase class]) {
+						failuresBefore = XCTFailureCount;
+					}
+
+					fprintf(stderr, "Test Case '-[%s %s]' started.\n", class_getName(cls), name.UTF8String);
+					NSDate *start = [NSDate date];
+					@try {
+						[test setUp];
+						((void (*)(id, SEL))[test methodForSelector:selector])(test, selector);
+						[test tearDown];
+					}
+					@catch (NSException *exception) {
+						[test recordFailureWithDescription:[NSString stringWithFormat:@"Exception: %@", exception] inFile:@(__FILE__) atLine:__LINE__ expected:NO];
+					}
+
+					BOOL failed;
+					@synchronized([XCTestCase class]) {
+						failed = XCTFailureCount > failuresBefore;
+					}
+					fprintf(stderr, "Test Case '-[%s %s]' %s (%.3f seconds).\n", class_getName(cls), name.UTF8String, failed ? "failed" : "passed", -start.timeIntervalSinceNow);
+
+					testCount++;
+					failedCount += failed ? 1 : 0;
+				}
+			}
+
+			[cls tearDown];
+		}
+
+		fprintf(stderr, "Executed %lu tests, with %lu failures\n", (unsigned long)testCount, (unsigned long)failedCount);
+		return failedCount > 0 ? 1 : 0;
+	}
+}
@@ -0,0 +1,26 @@
+//
+//  malloc.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+// Darwin's malloc_size(), for building the benchmarks with glibc.
+
+#ifndef TMDBMalloc_h
+#define TMDBMalloc_h
+
+#include <malloc.h>
+#include <stdint.h>
+
+// The runtime keeps small objects in tagged pointers, which aren't
+// allocations; the low bits of a real object's address are always clear.
+static inline size_t malloc_size(const void *pointer) {
+	if (pointer == NULL || ((uintptr_t)pointer & 7) != 0) {
+		return 0;
+	}
+	return malloc_usable_size((void *)pointer);
+}
+
+#endif // TMDBMalloc_h
@@ -0,0 +1,106 @@
+#!/bin/sh
+#
+#  run-benchmarks.sh
+#  iTMDb
+#
+#  Created by agent on 17/10/2026.
+#  Copyright (c) 2026 Devify. All rights reserved.
+#
+#  Builds and runs TMDBBenchmarkTests against the local stand-in server,
+#  writing the results as JSON to $TMDB_BENCHMARK_OUTPUT, or to
+#  iTMDb-benchmarks.json in the current directory.
+#
+#  On macOS the benchmarks run with xcodebuild. Elsewhere they are built with
+#  clang and GNUstep, which needs libobjc2 and a gnustep-base with blocks,
+#  libdispatch and NSURLSession (1.29 or later), and run by the small XCTest
+#  stand-in in Linux/XCTest.
+#
+#  Usage: run-benchmarks.sh [TestCaseClass ...]
+#
+
+set -e
+
+[ $# -eq 0 ] && set -- TMDBBenchmarkTests
+
+BENCHMARKS_DIR=$(cd "$(dirname "$0")" && pwd)
+TESTS_DIR=$(dirname "$BENCHMARKS_DIR")
+SOURCE_DIR=$(dirname "$TESTS_DIR")
+PROJECT_DIR=$(dirname "$SOURCE_DIR")
+
+TMDB_BENCHMARK_OUTPUT=${TMDB_BENCHMARK_OUTPUT:-$PWD/iTMDb-benchmarks.json}
+export TMDB_BENCHMARK_OUTPUT
+
+BUILD_DIR=${BUILD_DIR:-$PROJECT_DIR/build/benchmarks}
+mkdir -p "$BUILD_DIR"
+
+# The stand-in server, which goes away with this script
+SERVER_OUTPUT="$BUILD_DIR/stand-in-server.out"
+python3 "$BENCHMARKS_DIR/stand_in_server.py" --port 0 --parent-pid $$ > "$SERVER_OUTPUT" &
+SERVER_PID=$!
+trap 'kill $SERVER_PID 2>/dev/null' EXIT INT TERM
+
+TMDB_BENCHMARK_SERVER=
+for i in $(seq 50); do
+	TMDB_BENCHMARK_SERVER=$(head -n 1 "$SERVER_OUTPUT")
+	[ -n "$TMDB_BENCHMARK_SERVER" ] && break
+	sleep 0.1
+done
+if [ -z "$TMDB_BENCHMARK_SERVER" ]; then
+	echo "The stand-in server didn't start" >&2
+	exit 1
+fi
+export TMDB_BENCHMARK_SERVER
+echo "Stand-in server at $TMDB_BENCHMARK_SERVER"
+
+if [ "$(uname)" = Darwin ]; then
+	ONLY_TESTING=
+	for TEST_CASE in "$@"; do
+		ONLY_TESTING="$ONLY_TESTING -only-testing:iTMDbTests/$TEST_CASE"
+	done
+
+	# Variables prefixed with TEST_RUNNER_ are passed on to the tests
+	TEST_RUNNER_TMDB_BENCHMARK_SERVER=$TMDB_BENCHMARK_SERVER \
+	TEST_RUNNER_TMDB_BENCHMARK_OUTPUT=$TMDB_BENCHMARK_OUTPUT \
+	xcodebuild test \
+		-project "$PROJECT_DIR/iTMDb.xcodeproj" \
+		-scheme "iTMDb (OS X framework)" \
+		-derivedDataPath "$BUILD_DIR/DerivedData" \
+		$ONLY_TESTING
+	exit $?
+fi
+
+CC=${CC:-clang}
+LINUX_DIR="$BENCHMARKS_DIR/Linux"
+SOURCES_DIR="$BUILD_DIR/Sources"
+OBJECTS_DIR="$BUILD_DIR/Objects"
+rm -rf "$SOURCES_DIR" "$OBJECTS_DIR"
+mkdir -p "$SOURCES_DIR" "$OBJECTS_DIR"
+
+# The framework, the tests the benchmarks build on, and the XCTest stand-in,
+# in one directory, with modules imported as headers
+for FILE in $(find "$SOURCE_DIR/Classes" -name '*.[hm]') \
+	"$SOURCE_DIR/iTMDb.h" \
+	"$SOURCE_DIR/iTMDb_Prefix.pch" \
+	"$TESTS_DIR"/TMDBTestCase.[hm] \
+	"$TESTS_DIR"/TMDBScriptedTransport.[hm] \
+	"$TESTS_DIR"/TMDBFixtureTransport.[hm] \
+	"$TESTS_DIR"/TMDBStandInServer.[hm] \
+	"$TESTS_DIR"/TMDBBenchmarkTests.m \
+	"$LINUX_DIR"/XCTest/XCTest.m; do
+	sed 's/^\([[:space:]]*\)@import \([A-Za-z]*\);/\1#import <\2\/\2.h>/' "$FILE" > "$SOURCES_DIR/$(basename "$FILE")"
+done
+
+OBJC_FLAGS="$(gnustep-config --objc-flags) -fobjc-arc -fblocks -O2 -w \
+	-I$LINUX_DIR -I$SOURCES_DIR \
+	-include $LINUX_DIR/TMDBLinuxCompat.h -include $SOURCES_DIR/iTMDb_Prefix.pch"
+
+OBJECTS=
+for FILE in "$SOURCES_DIR"/*.m; do
+	OBJECT="$OBJECTS_DIR/$(basename "$FILE" .m).o"
+	$CC $OBJC_FLAGS -c "$FILE" -o "$OBJECT"
+	OBJECTS="$OBJECTS $OBJECT"
+done
+
+$CC -o "$BUILD_DIR/iTMDbBenchmarks" $OBJECTS $(gnustep-config --base-libs) -ldispatch
+
+TMDB_FIXTURE_DIRECTORY="$TESTS_DIR/Fixtures" "$BUILD_DIR/iTMDbBenchmarks" "$@"
@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+#
+#  stand_in_server.py
+#  iTMDb
+#
+#  Created by agent on 17/10/2026.
+#  Copyright (c) 2026 Devify. All rights reserved.
+#
+
+"""A local stand-in for the TMDb API, replaying the recorded fixtures.
+
+Serves the API paths the benchmarks use, over HTTP/1.1 with keep-alive:
+
+  /3/configuration         Fixtures/configuration.json
+  /3/movie/{id}[/...]      Fixtures/movie_full.json, renumbered to {id}
+  /3/search/movie          Fixtures/search_movie.json, for the page asked for
+  /t/p/{size}/{file}       made-up image data, larger for larger sizes
+
+Every response is held back by the latency, plus a random part of the jitter.
+Both can be changed while the server runs:
+
+  POST /_stand-in/latency?latency=0.02&jitter=0.02
+  GET  /_stand-in/stats    the number of requests per path, as JSON
+  POST /_stand-in/reset    clears the request counts
+
+Prints the URL it listens on as its first line of output, so the port can be
+left to the system with --port 0. With --parent-pid, it exits along with the
+process that started it.
+"""
+
+import argparse
+import copy
+import hashlib
+import json
+import os
+import random
+import re
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlsplit
+
+FIXTURES = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Fixtures')
+
+# Approximate sizes of TMDb's JPEGs, by the width or height they are scaled to
+IMAGE_BYTES_PER_PIXEL_WIDTH = 110
+ORIGINAL_IMAGE_BYTES = 400 * 1024
+
+MOVIE_PATH = re.compile(r'^/3/movie/(\d+)(/.*)?$')
+IMAGE_PATH = re.compile(r'^/t/p/([a-z]+)(\d*)/(.+)$')
+
+
+class StandIn(object):
+
+	def __init__(self, fixtures, latency, jitter):
+		self.lock = threading.Lock()
+		self.latency = latency
+		self.jitter = jitter
+		self.counts = {}
+		self.images = {}
+
+		def load(name):
+			with open(os.path.join(fixtures, name + '.json'), 'rb') as f:
+				return json.load(f)
+
+		self.configuration = json.dumps(load('configuration')).encode('utf-8')
+		self.movie = load('movie_full')
+		self.search = load('search_movie')
+
+	def delay(self):
+		with self.lock:
+			latency, jitter = self.latency, self.jitter
+		return latency + (random.random() * jitter if jitter > 0 else 0)
+
+	def count(self, path):
+		with self.lock:
+			self.counts[path] = self.counts.get(path, 0) + 1
+
+	def movie_body(self, tmdb_id):
+		movie = dict(self.movie)
+		movie['id'] = tmdb_id
+		return json.dumps(movie).encode('utf-8')
+
+	def search_body(self, page):
+		search = copy.copy(self.search)
+		search['page'] = page
+		return json.dumps(search).encode('utf-8')
+
+	def image_body(self, dimension, file_name):
+		key = (dimension, file_name)
+		with self.lock:
+			body = self.images.get(key)
+		if body is not None:
+			return body
+
+		length = dimension * IMAGE_BYTES_PER_PIXEL_WIDTH if dimension > 0 else ORIGINAL_IMAGE_BYTES
+		seed = hashlib.sha256(('%d/%s' % key).encode('utf-8')).digest()
+		body = b'\xff\xd8\xff\xe0' + (seed * (length // len(seed) + 1))[:max(length - 6, 0)] + b'\xff\xd9'
+
+		with self.lock:
+			self.images[key] = body
+		return body
+
+
+class StandInServer(ThreadingHTTPServer):
+	daemon_threads = True
+	# Batches open many connections at once
+	request_queue_size = 128
+
+
+class Handler(BaseHTTPRequestHandler):
+	protocol_version = 'HTTP/1.1'
+	server_version = 'iTMDbStandIn/1.0'
+
+	def log_message(self, format, *args):
+		pass
+
+	def respond(self, status, body, content_type='application/json;charset=utf-8'):
+		self.send_response(status)
+		self.send_header('Content-Type', content_type)
+		self.send_header('Content-Length', str(len(body)))
+		self.end_headers()
+		self.wfile.write(body)
+
+	def not_found(self):
+		body = json.dumps({'status_code': 34, 'status_message': 'The resource you requested could not be found.'})
+		self.respond(404, body.encode('utf-8'))
+
+	def do_POST(self):
+		stand_in = self.server.stand_in
+		url = urlsplit(self.path)
+		query = parse_qs(url.query)
+
+		length = int(self.headers.get('Content-Length') or 0)
+		if length > 0:
+			self.rfile.read(length)
+
+		if url.path == '/_stand-in/latency':
+			with stand_in.lock:
+				stand_in.latency = float(query.get('latency', [stand_in.latency])[0])
+				stand_in.jitter = float(query.get('jitter', [stand_in.jitter])[0])
+			self.respond(204, b'')
+		elif url.path == '/_stand-in/reset':
+			with stand_in.lock:
+				stand_in.counts = {}
+			self.respond(204, b'')
+		else:
+			self.not_found()
+
+	def do_GET(self):
+		stand_in = self.server.stand_in
+		url = urlsplit(self.path)
+		query = parse_qs(url.query)
+
+		if url.path == '/_stand-in/stats':
+			with stand_in.lock:
+				body = json.dumps({'requests': stand_in.counts}).encode('utf-8')
+			self.respond(200, body)
+			return
+
+		stand_in.count(url.path)
+		time.sleep(stand_in.delay())
+
+		movie = MOVIE_PATH.match(url.path)
+		image = IMAGE_PATH.match(url.path)
+
+		if url.path == '/3/configuration':
+			self.respond(200, stand_in.configuration)
+		elif url.path == '/3/search/movie':
+			page = int(query.get('page', ['1'])[0] or 1)
+			self.respond(200, stand_in.search_body(max(page, 1)))
+		elif movie is not None:
+			self.respond(200, stand_in.movie_body(int(movie.group(1))))
+		elif image is not None:
+			dimension = int(image.group(2)) if image.group(2) else 0
+			self.respond(200, stand_in.image_body(dimension, image.group(3)), 'image/jpeg')
+		else:
+			self.not_found()
+
+
+def exit_with_parent(parent_pid):
+	while True:
+		time.sleep(1.0)
+		try:
+			os.kill(parent_pid, 0)
+		except OSError:
+			os._exit(0)
+
+
+def main():
+	parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+	parser.add_argument('--host', default='127.0.0.1')
+	parser.add_argument('--port', type=int, default=0, help='0 to let the system pick one')
+	parser.add_argument('--latency', type=float, default=0.0, help='seconds before every response')
+	parser.add_argument('--jitter', type=float, default=0.0, help='upper bound of a random extra delay')
+	parser.add_argument('--fixtures', default=FIXTURES)
+	parser.add_argument('--parent-pid', type=int, default=0, help='exit once this process is gone')
+	args = parser.parse_args()
+
+	server = StandInServer((args.host, args.port), Handler)
+	server.stand_in = StandIn(args.fixtures, args.latency, args.jitter)
+
+	print('http://%s:%d' % server.server_address[:2])
+	sys.stdout.flush()
+
+	if args.parent_pid > 0:
+		threading.Thread(target=exit_with_parent, args=(args.parent_pid,), daemon=True).start()
+
+	try:
+		server.serve_forever()
+	except KeyboardInterrupt:
+		pass
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,1054 @@
+//
+//  TMDBBenchmarkTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBFixtureTransport.h"
+#import "TMDBStandInServer.h"
+#import "TMDBRequest.h"
+#import "TMDBMovie.h"
+#import "TMDBMovieSearch.h"
+#import "TMDBMovieSearch+Private.h"
+#import "TMDBMovieSnapshot.h"
+#import "TMDBMovieTitleIndex.h"
+#import "TMDBImage.h"
+#import "TMDBImage+Private.h"
+#import "TMDBImageLoader.h"
+#import "TMDBPerson.h"
+#import "TMDBCredit.h"
+#import "TMDB+Private.h"
+#import "TMDBIdentityMap.h"
+
+#ifdef __APPLE__
+	#include <mach/mach.h>
+	#include <malloc/malloc.h>
+#else
+	#include <malloc.h>
+#endif
+
+#pragma mark - Main Thread Delivery
+
+/**
+ * Delivers another transport's callbacks on the main thread, and decodes each
+ * response there before passing it on, the way requests were loaded when they
+ * ran on an `NSURLConnection` scheduled in the main run loop.
+ */
+@interface TMDBMainThreadTransport : NSObject <TMDBTransport>
+
+- (nonnull instancetype)initWithTransport:(nonnull id<TMDBTransport>)transport;
+
+@end
+
+@interface TMDBMainThreadTransportDelegate : NSObject <TMDBTransportDelegate>
+
+- (nonnull instancetype)initWithDelegate:(nonnull id<TMDBTransportDelegate>)delegate;
+
+@end
+
+@implementation TMDBMainThreadTransport {
+	id<TMDBTransport> _transport;
+}
+
+- (instancetype)initWithTransport:(id<TMDBTransport>)transport {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_transport = transport;
+
+	return self;
+}
+
+- (id<TMDBTransportTask>)startTaskWithRequest:(NSURLRequest *)request delegate:(id<TMDBTransportDelegate>)delegate {
+	return [_transport startTaskWithRequest:request delegate:[[TMDBMainThreadTransportDelegate alloc] initWithDelegate:delegate]];
+}
+
+@end
+
+@implementation TMDBMainThreadTransportDelegate {
+	id<TMDBTransportDelegate> _delegate;
+	NSMutableData *_data;
+}
+
+- (instancetype)initWithDelegate:(id<TMDBTransportDelegate>)delegate {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_delegate = delegate;
+	_data = [NSMutableData data];
+
+	return self;
+}
+
+- (void)transportTask:(id<TMDBTransportTask>)task didReceiveResponse:(NSURLResponse *)response {
+	dispatch_async(dispatch_get_main_queue(), ^{
+		[self->_delegate transportTask:task didReceiveResponse:response];
+	});
+}
+
+- (void)transportTask:(id<TMDBTransportTask>)task didReceiveData:(NSData *)data {
+	dispatch_async(dispatch_get_main_queue(), ^{
+		[self->_data appendData:data];
+		[self->_delegate transportTask:task didReceiveData:data];
+	});
+}
+
+- (void)transportTask:(id<TMDBTransportTask>)task didCompleteWithError:(NSError *)error {
+	dispatch_async(dispatch_get_main_queue(), ^{
+		if (error == nil && self->_data.length > 0) {
+			[NSJSONSerialization JSONObjectWithData:self->_data options:0 error:NULL];
+		}
+		[self->_delegate transportTask:task didCompleteWithError:error];
+	});
+}
+
+@end
+
+// The processor time used by the calling thread so far, in seconds
+static NSTimeInterval TMDBThreadCPUTime(void) {
+#ifdef __APPLE__
+	thread_basic_info_data_t info;
+	mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+	mach_port_t thread = mach_thread_self();
+	kern_return_t result = thread_info(thread, THREAD_BASIC_INFO, (thread_info_t)&info, &count);
+	mach_port_deallocate(mach_task_self(), thread);
+	if (result != KERN_SUCCESS) {
+		return 0;
+	}
+	return info.user_time.seconds + info.user_time.microseconds / 1e6 + info.system_time.seconds + info.system_time.microseconds / 1e6;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+	return time.tv_sec + time.tv_nsec / 1e9;
+#endif
+}
+
+// The memory of the process that is resident, in bytes
+static NSUInteger TMDBResidentMemory(void) {
+#ifdef __APPLE__
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+		return 0;
+	}
+	return (NSUInteger)info.resident_size;
+#else
+	unsigned long pages = 0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm != NULL) {
+		if (fscanf(statm, "%*lu %lu", &pages) != 1) {
+			pages = 0;
+		}
+		fclose(statm);
+	}
+	return (NSUInteger)pages * (NSUInteger)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+// The bytes allocated on the heap and not yet freed
+static NSUInteger TMDBHeapSize(void) {
+#ifdef __APPLE__
+	malloc_statistics_t statistics;
+	malloc_zone_statistics(NULL, &statistics);
+	return statistics.size_in_use;
+#else
+	return mallinfo2().uordblks;
+#endif
+}
+
+#pragma mark - Uninterned Context
+
+/**
+ * A context that gives every movie persons and languages of its own, the way
+ * they were allocated before the identity map.
+ */
+@interface TMDBUninternedContext : TMDB
+
+@end
+
+@implementation TMDBUninternedContext
+
+- (TMDBIdentityMap *)identityMap {
+	return [[TMDBIdentityMap alloc] initWithContext:self];
+}
+
+@end
+
+#pragma mark -
+
+/**
+ * Benchmarks over the recorded fixtures. The end-to-end ones go over HTTP to
+ * the local stand-in server, `Benchmarks/stand_in_server.py`, or replay the
+ * fixtures in process if it can't be started. The results of a run are
+ * written as JSON to the path in the environment variable
+ * `TMDB_BENCHMARK_OUTPUT`, or to `iTMDb-benchmarks.json` in the temporary
+ * directory, so runs can be compared between releases.
+ *
+ * `Benchmarks/run-benchmarks.sh` runs them outside Xcode, on Linux too.
+ */
+@interface TMDBBenchmarkTests : TMDBTestCase
+
+@end
+
+// The results of all benchmarks run so far, written out once the class is done
+static NSMutableArray<NSDictionary *> *TMDBBenchmarkResults;
+
+@implementation TMDBBenchmarkTests {
+	TMDBFixtureTransport *_fixtureTransport;
+}
+
+// One for the whole run, so connections to the server are kept alive
++ (TMDBStandInTransport *)standInTransport {
+	static TMDBStandInTransport *standInTransport;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		TMDBStandInServer *server = [TMDBStandInServer sharedServer];
+		if (server != nil) {
+			standInTransport = [[TMDBStandInTransport alloc] initWithServer:server];
+		}
+	});
+	return standInTransport;
+}
+
++ (void)setUp {
+	[super setUp];
+	TMDBBenchmarkResults = [NSMutableArray array];
+}
+
++ (void)tearDown {
+	NSString *path = [NSProcessInfo processInfo].environment[@"TMDB_BENCHMARK_OUTPUT"];
+	if (path.length == 0) {
+		path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"iTMDb-benchmarks.json"];
+	}
+
+	NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+	formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+	formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"UTC"];
+	formatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ss'Z'";
+
+	NSDictionary *run = @{
+		@"suite": @"iTMDb",
+		@"version": [[NSBundle bundleForClass:[TMDB class]] objectForInfoDictionaryKey:@"CFBundleShortVersionString"] ?: @"",
+		@"date": [formatter stringFromDate:[NSDate date]],
+		@"host": @{
+			@"os": [NSProcessInfo processInfo].operatingSystemVersionString,
+			@"processors": @([NSProcessInfo processInfo].activeProcessorCount)
+		},
+		@"server": [self standInTransport].server.baseURL.absoluteString ?: @"in-process",
+		@"results": TMDBBenchmarkResults
+	};
+
+	NSData *data = [NSJSONSerialization dataWithJSONObject:run options:NSJSONWritingPrettyPrinted error:NULL];
+	if ([data writeToFile:path atomically:YES]) {
+		NSLog(@"iTMDb: Wrote %tu benchmark results to %@", TMDBBenchmarkResults.count, path);
+	}
+
+	[super tearDown];
+}
+
+- (void)setUp {
+	[super setUp];
+
+	_fixtureTransport = [[TMDBFixtureTransport alloc] initWithLatency:0];
+	[_fixtureTransport replayJSONObject:[TMDBTestCase configurationDictionary] forPathPrefix:[NSString stringWithFormat:@"/%@/configuration", TMDBAPIVersion]];
+	[_fixtureTransport replayFixtureNamed:@"movie_full" forPathPrefix:[NSString stringWithFormat:@"/%@/movie/", TMDBAPIVersion]];
+	[_fixtureTransport replayFixtureNamed:@"search_movie" forPathPrefix:[NSString stringWithFormat:@"/%@/search/movie", TMDBAPIVersion]];
+	[TMDBRequest setTransport:_fixtureTransport];
+
+	TMDBStandInTransport *standInTransport = [TMDBBenchmarkTests standInTransport];
+	if (standInTransport != nil) {
+		[standInTransport.server setLatency:0 jitter:0];
+		[TMDBRequest setTransport:standInTransport];
+	}
+
+	[self.context setRateLimitRequests:100000 perWindow:1.0];
+}
+
+#pragma mark - Recording
+
+// Summarises samples, in the unit they were measured in
+- (void)recordBenchmark:(NSString *)name unit:(NSString *)unit samples:(NSArray<NSNumber *> *)samples {
+	NSArray<NSNumber *> *sorted = [samples sortedArrayUsingSelector:@selector(compare:)];
+	NSUInteger count = sorted.count;
+	if (count == 0) {
+		return;
+	}
+
+	double sum = 0;
+	for (NSNumber *sample in sorted) {
+		sum += sample.doubleValue;
+	}
+
+	NSNumber *(^percentile)(double) = ^NSNumber *(double p) {
+		return sorted[(NSUInteger)(p * (count - 1) + 0.5)];
+	};
+
+	NSDictionary *result = @{
+		@"name": name,
+		@"unit": unit,
+		@"samples": @(count),
+		@"mean": @(sum / count),
+		@"min": sorted.firstObject,
+		@"median": percentile(0.5),
+		@"p90": percentile(0.9),
+		@"p95": percentile(0.95),
+		@"p99": percentile(0.99),
+		@"max": sorted.lastObject
+	};
+
+	NSLog(@"iTMDb: %@ median %.3f %@, p95 %.3f %@ (%tu samples)", name, [result[@"median"] doubleValue], unit, [result[@"p95"] doubleValue], unit, count);
+	@synchronized(TMDBBenchmarkResults) {
+		[TMDBBenchmarkResults addObject:result];
+	}
+}
+
+/**
+ * Runs `block` `operations` times per sample, after a warm-up sample, and
+ * records the time per operation in microseconds.
+ */
+- (void)measureBenchmark:(NSString *)name samples:(NSUInteger)sampleCount operationsPerSample:(NSUInteger)operations block:(void (^)(NSUInteger i))block {
+	NSMutableArray<NSNumber *> *samples = [NSMutableArray arrayWithCapacity:sampleCount];
+
+	for (NSUInteger s = 0; s <= sampleCount; s++) {
+		CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+		@autoreleasepool {
+			for (NSUInteger i = 0; i < operations; i++) {
+				block(s * operations + i);
+			}
+		}
+		NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+		if (s > 0) {
+			[samples addObject:@(elapsed * 1e6 / operations)];
+		}
+	}
+
+	[self recordBenchmark:name unit:@"us" samples:samples];
+}
+
+#pragma mark - Microbenchmarks
+
+- (void)testPopulate {
+	NSDictionary *d = [TMDBFixtureTransport JSONObjectForFixtureNamed:@"movie_full"];
+	XCTAssertNotNil(d);
+
+	[self measureBenchmark:@"populate.eager" samples:50 operationsPerSample:10 block:^(NSUInteger i) {
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+		[movie populate:d options:0];
+	}];
+
+	[self measureBenchmark:@"populate.lazy" samples:50 operationsPerSample:10 block:^(NSUInteger i) {
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+		[movie populate:d options:TMDBMoviePopulateOptionLazy];
+	}];
+
+	[self measureBenchmark:@"populate.lazy_then_credits" samples:50 operationsPerSample:10 block:^(NSUInteger i) {
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+		[movie populate:d options:TMDBMoviePopulateOptionLazy];
+		(void)movie.credits;
+	}];
+
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	[movie populate:d options:0];
+	XCTAssertEqualObjects(movie.title, @"Fight Club");
+	XCTAssertEqual(movie.credits.count, [d[@"casts"][@"cast"] count] + [d[@"casts"][@"crew"] count]);
+}
+
+/**
+ * Populates 10,000 movies from `results` with `options`, a few times, and
+ * records the time it takes and the resident memory they add.
+ */
+- (void)measurePopulating:(NSString *)name results:(NSArray<NSDictionary *> *)results options:(TMDBMoviePopulateOptions)options {
+	const NSUInteger count = 10000;
+	const NSUInteger rounds = 5;
+	NSMutableArray<NSNumber *> *durations = [NSMutableArray arrayWithCapacity:rounds];
+	NSMutableArray<NSNumber *> *residents = [NSMutableArray arrayWithCapacity:rounds];
+
+	for (NSUInteger round = 0; round < rounds; round++) {
+		@autoreleasepool {
+			NSMutableArray<TMDBMovie *> *movies = [NSMutableArray arrayWithCapacity:count];
+			NSUInteger residentBefore = TMDBResidentMemory();
+
+			CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+			for (NSUInteger i = 0; i < count; i++) {
+				TMDBMovie *movie = [[TMDBMovie alloc] initWithID:i + 1 context:self.context];
+				[movie populate:results[i % results.count] options:options];
+				[movies addObject:movie];
+			}
+			[durations addObject:@((CFAbsoluteTimeGetCurrent() - start) * 1000.0)];
+
+			NSUInteger residentAfter = TMDBResidentMemory();
+			[residents addObject:@((residentAfter > residentBefore ? residentAfter - residentBefore : 0) / (1024.0 * 1024.0))];
+			XCTAssertEqual(movies.count, count);
+		}
+	}
+
+	[self recordBenchmark:[NSString stringWithFormat:@"populate_10k.%@.time", name] unit:@"ms" samples:durations];
+	[self recordBenchmark:[NSString stringWithFormat:@"populate_10k.%@.resident", name] unit:@"MB" samples:residents];
+}
+
+// Search results, and full movies, which have the most to decode lazily
+- (void)testPopulate10kEagerAndLazy {
+	NSArray<NSDictionary *> *results = [TMDBFixtureTransport JSONObjectForFixtureNamed:@"search_movie"][@"results"];
+	NSArray<NSDictionary *> *movies = @[[TMDBFixtureTransport JSONObjectForFixtureNamed:@"movie_full"]];
+	XCTAssertEqual(results.count, 20u);
+
+	[self measurePopulating:@"search_result.eager" results:results options:0];
+	[self measurePopulating:@"search_result.lazy" results:results options:TMDBMoviePopulateOptionLazy];
+	[self measurePopulating:@"search_result.lazy_discarding" results:results options:TMDBMoviePopulateOptionLazy | TMDBMoviePopulateOptionDiscardRawResults];
+	[self measurePopulating:@"full.eager" results:movies options:0];
+	[self measurePopulating:@"full.lazy" results:movies options:TMDBMoviePopulateOptionLazy];
+	[self measurePopulating:@"full.lazy_discarding" results:movies options:TMDBMoviePopulateOptionLazy | TMDBMoviePopulateOptionDiscardRawResults];
+}
+
+// Records each part of a movie's footprint, in bytes
+- (void)recordFootprint:(NSString *)name ofMovie:(TMDBMovie *)movie {
+	TMDBMovieFootprint footprint = movie.footprint;
+	NSDictionary<NSString *, NSNumber *> *parts = @{
+		@"images": @(footprint.images),
+		@"credits": @(footprint.credits),
+		@"raw_results": @(footprint.rawResults),
+		@"strings": @(footprint.strings),
+		@"total": @(footprint.total)
+	};
+	for (NSString *part in [parts.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+		[self recordBenchmark:[NSString stringWithFormat:@"footprint.%@.%@", name, part] unit:@"bytes" samples:@[parts[part]]];
+	}
+
+	XCTAssertGreaterThanOrEqual(footprint.total, footprint.images + footprint.credits + footprint.rawResults + footprint.strings);
+}
+
+- (void)testMovieFootprint {
+	NSDictionary *d = [TMDBFixtureTransport JSONObjectForFixtureNamed:@"movie_full"];
+
+	@autoreleasepool {
+		TMDBMovie *eager = [[TMDBMovie alloc] initWithID:550 context:self.context];
+		[eager populate:d options:0];
+		[self recordFootprint:@"movie_full.eager" ofMovie:eager];
+
+		TMDBMovie *lazy = [[TMDBMovie alloc] initWithID:550 context:self.context];
+		[lazy populate:d options:TMDBMoviePopulateOptionLazy | TMDBMoviePopulateOptionDiscardRawResults];
+		[self recordFootprint:@"movie_full.lazy_discarding" ofMovie:lazy];
+
+		XCTAssertGreaterThan(eager.footprint.credits, 0u);
+		XCTAssertGreaterThan(eager.footprint.images, 0u);
+		XCTAssertLessThan(lazy.footprint.total, eager.footprint.total);
+	}
+
+	// Movies and their persons hold each other, which must not keep either
+	// alive once nobody else does. The persons are shared between the
+	// movies, so the last one goes with the last movie.
+	__weak TMDBMovie *weakMovie = nil;
+	__weak TMDBPerson *weakPerson = nil;
+	NSUInteger residentBefore = TMDBResidentMemory();
+	@autoreleasepool {
+		for (NSUInteger i = 0; i < 1000; i++) {
+			TMDBMovie *movie = [[TMDBMovie alloc] initWithID:200000 + i context:self.context];
+			[movie populate:d options:0];
+			weakMovie = movie;
+			weakPerson = movie.credits.firstObject.person;
+		}
+	}
+	NSUInteger residentAfter = TMDBResidentMemory();
+
+	XCTAssertNil(weakMovie);
+	XCTAssertNil(weakPerson);
+	[self recordBenchmark:@"footprint.movie_full.released_1k.resident" unit:@"MB" samples:@[@((residentAfter > residentBefore ? residentAfter - residentBefore : 0) / (1024.0 * 1024.0))]];
+}
+
+/**
+ * Populates `movieDictionaries` in `context`, and records the time it takes
+ * and the heap the movies hold on to.
+ */
+- (void)measureWorkingSet:(NSString *)name movies:(NSArray<NSDictionary *> *)movieDictionaries context:(TMDB *)context {
+	@autoreleasepool {
+		NSMutableArray<TMDBMovie *> *movies = [NSMutableArray arrayWithCapacity:movieDictionaries.count];
+		NSUInteger heapBefore = TMDBHeapSize();
+
+		CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+		for (NSDictionary *d in movieDictionaries) {
+			@autoreleasepool {
+				TMDBMovie *movie = [[TMDBMovie alloc] initWithID:[d[@"id"] unsignedIntegerValue] context:context];
+				[movie populate:d options:TMDBMoviePopulateOptionDiscardRawResults];
+				[movies addObject:movie];
+			}
+		}
+		NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+		NSUInteger heapAfter = TMDBHeapSize();
+		[self recordBenchmark:[NSString stringWithFormat:@"working_set_50k.%@.heap", name] unit:@"MB" samples:@[@((heapAfter > heapBefore ? heapAfter - heapBefore : 0) / (1024.0 * 1024.0))]];
+		[self recordBenchmark:[NSString stringWithFormat:@"working_set_50k.%@.populate", name] unit:@"ms" samples:@[@(elapsed * 1000.0)]];
+		XCTAssertEqual(movies.count, movieDictionaries.count);
+	}
+}
+
+// 50,000 movies with 20 credits each, cast from 5,000 actors, in one of five
+// languages. Persons and languages are allocated per movie, as before the
+// identity map, and then shared, as now.
+- (void)testWorkingSetHeap {
+	const NSUInteger movieCount = 50000;
+	const NSUInteger creditCount = 20;
+	const NSUInteger personCount = 5000;
+	NSArray<NSDictionary *> *languages = @[
+		@{@"iso_639_1": @"en", @"name": @"English"},
+		@{@"iso_639_1": @"fr", @"name": @"Français"},
+		@{@"iso_639_1": @"de", @"name": @"Deutsch"},
+		@{@"iso_639_1": @"es", @"name": @"Español"},
+		@{@"iso_639_1": @"ja", @"name": @"日本語"}
+	];
+
+	NSMutableArray<NSDictionary *> *persons = [NSMutableArray arrayWithCapacity:personCount];
+	for (NSUInteger i = 0; i < personCount; i++) {
+		[persons addObject:@{
+			@"id": @(1000 + i),
+			@"name": [NSString stringWithFormat:@"Person Number %tu", i],
+			@"profile_path": [NSString stringWithFormat:@"/person%tu.jpg", i]
+		}];
+	}
+
+	NSMutableArray<NSDictionary *> *movies = [NSMutableArray arrayWithCapacity:movieCount];
+	for (NSUInteger i = 0; i < movieCount; i++) {
+		NSMutableArray *cast = [NSMutableArray arrayWithCapacity:creditCount];
+		for (NSUInteger c = 0; c < creditCount; c++) {
+			NSMutableDictionary *credit = [persons[(i * 7 + c * 131) % personCount] mutableCopy];
+			credit[@"character"] = [NSString stringWithFormat:@"Character %tu", c];
+			credit[@"order"] = @(c);
+			credit[@"cast_id"] = @(c + 1);
+			[cast addObject:credit];
+		}
+
+		NSMutableDictionary *movie = [[TMDBTestCase movieDictionaryWithID:300000 + i] mutableCopy];
+		movie[@"spoken_languages"] = @[languages[i % languages.count]];
+		movie[@"casts"] = @{@"cast": cast, @"crew": @[]};
+		[movies addObject:movie];
+	}
+
+	TMDBUninternedContext *uninternedContext = [[TMDBUninternedContext alloc] initWithAPIKey:nil language:@"en"];
+	[self measureWorkingSet:@"before" movies:movies context:uninternedContext];
+	[self measureWorkingSet:@"after" movies:movies context:self.context];
+}
+
+- (void)testMoviesFromSearchData {
+	NSDictionary *d = [TMDBFixtureTransport JSONObjectForFixtureNamed:@"search_movie"];
+	XCTAssertNotNil(d);
+
+	[self measureBenchmark:@"search.moviesFromSearchData" samples:50 operationsPerSample:20 block:^(NSUInteger i) {
+		[TMDBMovieSearch moviesFromSearchData:d context:self.context error:NULL];
+	}];
+
+	NSError *error = nil;
+	NSArray<TMDBMovie *> *movies = [TMDBMovieSearch moviesFromSearchData:d context:self.context error:&error];
+	XCTAssertNil(error);
+	XCTAssertEqual(movies.count, 20u);
+}
+
+- (void)testDateFromString {
+	NSMutableArray<NSString *> *dates = [NSMutableArray array];
+	for (NSDictionary *result in [TMDBFixtureTransport JSONObjectForFixtureNamed:@"search_movie"][@"results"]) {
+		[dates addObject:result[@"release_date"]];
+	}
+	XCTAssertEqual(dates.count, 20u);
+
+	[self measureBenchmark:@"movie.dateFromString" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		[TMDBMovie dateFromString:dates[i % dates.count]];
+	}];
+}
+
+// What populating a movie's release date cost with NSDateFormatter, and what
+// it costs now, followed by populating whole search results
+- (void)testReleaseDatePopulate {
+	NSArray<NSDictionary *> *results = [TMDBFixtureTransport JSONObjectForFixtureNamed:@"search_movie"][@"results"];
+	NSMutableArray<NSString *> *dates = [NSMutableArray array];
+	for (NSDictionary *result in results) {
+		[dates addObject:result[@"release_date"]];
+	}
+
+	NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+	dateFormatter.dateFormat = @"yyyy-MM-dd";
+	NSDateFormatter *yearFormatter = [[NSDateFormatter alloc] init];
+	yearFormatter.dateFormat = @"yyyy";
+
+	[self measureBenchmark:@"populate.release_date.before" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		NSDate *released = [dateFormatter dateFromString:dates[i % dates.count]];
+		(void)[yearFormatter stringFromDate:released].integerValue;
+	}];
+
+	[self measureBenchmark:@"populate.release_date.after" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		(void)[TMDBMovie yearFromString:dates[i % dates.count]];
+	}];
+
+	[self measureBenchmark:@"populate.search_result" samples:50 operationsPerSample:200 block:^(NSUInteger i) {
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:100000 + i context:self.context];
+		[movie populate:results[i % results.count] options:0];
+	}];
+
+	for (NSString *date in dates) {
+		NSDate *released = [dateFormatter dateFromString:date];
+		XCTAssertEqual([TMDBMovie yearFromString:date], (NSUInteger)[yearFormatter stringFromDate:released].integerValue);
+	}
+}
+
+- (void)testSizeClosestMatchingSize {
+	NSArray<NSString *> *sizes = [TMDBTestCase configurationDictionary][@"images"][@"poster_sizes"];
+
+	[self measureBenchmark:@"image.sizeClosestMatchingSize" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		[TMDBImage sizeClosestMatchingSize:(float)(50 + (i * 37) % 1000) inSizes:sizes dimension:TMDBImageSizeWidth];
+	}];
+
+	XCTAssertEqualObjects([TMDBImage sizeClosestMatchingSize:500 inSizes:sizes dimension:TMDBImageSizeWidth], @"w500");
+}
+
+// From a movie's poster to its URL at the size closest to the one asked for,
+// with the configuration loaded, as a grid view cell does
+- (void)testImageURLResolve {
+	XCTestExpectation *expectation = [self expectationWithDescription:@"configuration"];
+	[self.context.configuration reload:^(NSError *error) {
+		XCTAssertNil(error);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	[movie populate:[TMDBFixtureTransport JSONObjectForFixtureNamed:@"movie_full"] options:0];
+	NSArray<TMDBImage *> *posters = movie.posters;
+	NSArray<TMDBImage *> *backdrops = movie.backdrops;
+	XCTAssertGreaterThan(posters.count, 0u);
+	XCTAssertGreaterThan(backdrops.count, 0u);
+
+	[self measureBenchmark:@"image.urlForClosestSize.poster" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		[posters[i % posters.count] urlForClosestSize:(float)(50 + (i * 37) % 1000) dimension:TMDBImageSizeWidth];
+	}];
+
+	[self measureBenchmark:@"image.urlForClosestSize.backdrop" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		[backdrops[i % backdrops.count] urlForClosestSize:(float)(200 + (i * 37) % 1500) dimension:TMDBImageSizeWidth];
+	}];
+
+	[self measureBenchmark:@"image.urlForSize" samples:50 operationsPerSample:1000 block:^(NSUInteger i) {
+		[posters[i % posters.count] urlForSize:@"w342"];
+	}];
+
+	NSURL *url = [posters.firstObject urlForClosestSize:500 dimension:TMDBImageSizeWidth];
+	XCTAssertEqualObjects(url.lastPathComponent, [posters.firstObject urlForSize:@"original"].lastPathComponent);
+	XCTAssertTrue([url.absoluteString containsString:@"/w500/"]);
+}
+
+#pragma mark - Snapshots
+
+// Writes `count` made-up movies to a snapshot in the temporary directory
+- (NSURL *)writeSnapshotWithMovieCount:(NSUInteger)count firstID:(NSUInteger)firstID {
+	TMDBMovieSnapshotWriter *writer = [[TMDBMovieSnapshotWriter alloc] init];
+	for (NSUInteger i = 0; i < count; i++) {
+		@autoreleasepool {
+			TMDBMovie *movie = [[TMDBMovie alloc] initWithID:firstID + i context:self.context];
+			[movie populate:[TMDBTestCase movieDictionaryWithID:firstID + i] options:0];
+			[writer addMovie:movie];
+		}
+	}
+
+	NSString *name = [NSString stringWithFormat:@"iTMDb-benchmark-%@.snapshot", [NSUUID UUID].UUIDString];
+	NSURL *url = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+	NSError *error = nil;
+	XCTAssertTrue([writer writeToURL:url error:&error], @"%@", error);
+	return url;
+}
+
+// Opening a snapshot of 10,000 movies and reading one of them, as on launch.
+// The file stays in the page cache between samples, so this measures mapping
+// it and checking its header rather than reading it from disk.
+- (void)testSnapshotColdOpen {
+	const NSUInteger count = 10000;
+	const NSUInteger firstID = 400000;
+	NSURL *url = [self writeSnapshotWithMovieCount:count firstID:firstID];
+	NSMutableArray<NSNumber *> *samples = [NSMutableArray array];
+
+	for (NSUInteger s = 0; s < 50; s++) {
+		@autoreleasepool {
+			NSUInteger tmdbID = firstID + (s * 997) % count;
+
+			CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+			TMDBMovieSnapshot *snapshot = [[TMDBMovieSnapshot alloc] initWithContentsOfURL:url error:NULL];
+			TMDBMovie *movie = [snapshot movieWithID:tmdbID context:self.context];
+			NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+			XCTAssertEqual(movie.tmdbID, (NSInteger)tmdbID);
+			[samples addObject:@(elapsed * 1e6)];
+		}
+	}
+
+	[self recordBenchmark:@"snapshot.cold_open" unit:@"us" samples:samples];
+	[[NSFileManager defaultManager] removeItemAtURL:url error:NULL];
+}
+
+// Decoding movies picked at random from a snapshot of 10,000, and reading
+// every title in place without decoding the movies.
+- (void)testSnapshotRandomLookups {
+	const NSUInteger count = 10000;
+	const NSUInteger firstID = 400000;
+	const NSUInteger lookups = 1000;
+	NSURL *url = [self writeSnapshotWithMovieCount:count firstID:firstID];
+
+	NSError *error = nil;
+	TMDBMovieSnapshot *snapshot = [[TMDBMovieSnapshot alloc] initWithContentsOfURL:url error:&error];
+	XCTAssertNotNil(snapshot, @"%@", error);
+	XCTAssertEqual(snapshot.count, count);
+
+	NSMutableArray<NSNumber *> *samples = [NSMutableArray array];
+	for (NSUInteger s = 0; s <= 20; s++) {
+		CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+		@autoreleasepool {
+			for (NSUInteger i = 0; i < lookups; i++) {
+				[snapshot movieWithID:firstID + arc4random_uniform((uint32_t)count) context:self.context];
+			}
+		}
+		NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+		// The first sample warms up
+		if (s > 0) {
+			[samples addObject:@(lookups / elapsed)];
+		}
+	}
+	[self recordBenchmark:@"snapshot.random_lookup" unit:@"lookups/s" samples:samples];
+
+	__block NSUInteger titleCount = 0;
+	[self measureBenchmark:@"snapshot.enumerate_titles_10k" samples:20 operationsPerSample:1 block:^(NSUInteger i) {
+		titleCount = 0;
+		[snapshot enumerateMovieTitlesUsingBlock:^(NSUInteger tmdbID, NSString *title, BOOL *stop) {
+			titleCount += title.length > 0 ? 1 : 0;
+		}];
+	}];
+	XCTAssertEqual(titleCount, count);
+
+	snapshot = nil;
+	[[NSFileManager defaultManager] removeItemAtURL:url error:NULL];
+}
+
+#pragma mark - Title Index
+
+/**
+ * Fills a title index with `count` made-up titles of two to four words, and
+ * queries it with whole titles, the start of a title, and a word with the
+ * start of the next, recording the time per query in microseconds.
+ */
+- (void)measureTitleIndex:(NSString *)name count:(NSUInteger)count {
+	NSArray<NSString *> *words = @[
+		@"star", @"wars", @"night", @"dark", @"knight", @"return", @"king", @"lord", @"rings", @"fight",
+		@"club", @"pulp", @"fiction", @"matrix", @"godfather", @"part", @"empire", @"strikes", @"back", @"lost",
+		@"ark", @"raiders", @"alien", @"aliens", @"blade", @"runner", @"terminator", @"judgment", @"day", @"back",
+		@"future", @"jurassic", @"park", @"world", @"toy", @"story", @"finding", @"nemo", @"inside", @"out",
+		@"city", @"god", @"spirited", @"away", @"seven", @"samurai", @"good", @"bad", @"ugly", @"once",
+		@"upon", @"time", @"west", @"america", @"apocalypse", @"now", @"full", @"metal", @"jacket", @"shining",
+		@"clockwork", @"orange", @"space", @"odyssey", @"léon", @"professional", @"amélie", @"cité", @"peur", @"nuit"
+	];
+
+	// A fixed sequence, so every run indexes the same titles
+	__block uint64_t seed = 0x5DEECE66DULL;
+	NSUInteger (^randomBelow)(NSUInteger) = ^NSUInteger(NSUInteger upperBound) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		return (NSUInteger)((seed >> 33) % upperBound);
+	};
+
+	NSMutableArray<NSString *> *titles = [NSMutableArray arrayWithCapacity:count];
+	for (NSUInteger i = 0; i < count; i++) {
+		NSUInteger wordCount = 2 + randomBelow(3);
+		NSMutableArray<NSString *> *titleWords = [NSMutableArray arrayWithCapacity:wordCount];
+		for (NSUInteger w = 0; w < wordCount; w++) {
+			[titleWords addObject:[words[randomBelow(words.count)] capitalizedString]];
+		}
+		[titles addObject:[titleWords componentsJoinedByString:@" "]];
+	}
+
+	TMDBMovieTitleIndex *index = [[TMDBMovieTitleIndex alloc] init];
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	for (NSUInteger i = 0; i < count; i++) {
+		@autoreleasepool {
+			TMDBMovie *movie = [[TMDBMovie alloc] initWithID:1000000 + i context:self.context];
+			[movie populate:@{@"id": @(1000000 + i), @"title": titles[i], @"release_date": @"1999-10-15", @"popularity": @(randomBelow(1000) / 10.0)} options:TMDBMoviePopulateOptionDiscardRawResults];
+			[index addMovie:movie];
+		}
+	}
+	[self recordBenchmark:[NSString stringWithFormat:@"title_index.%@.build", name] unit:@"ms" samples:@[@((CFAbsoluteTimeGetCurrent() - start) * 1000.0)]];
+	XCTAssertEqual(index.count, count);
+
+	NSMutableArray<NSString *> *queries = [NSMutableArray array];
+	for (NSUInteger q = 0; q < 300; q++) {
+		NSString *title = titles[randomBelow(count)];
+		NSArray<NSString *> *titleWords = [title componentsSeparatedByString:@" "];
+		switch (q % 3) {
+			case 0:
+				[queries addObject:title];
+				break;
+			case 1:
+				[queries addObject:[title substringToIndex:MIN(title.length, (NSUInteger)5)]];
+				break;
+			default:
+				[queries addObject:[NSString stringWithFormat:@"%@ %@", titleWords[0], [titleWords[1] substringToIndex:MIN([titleWords[1] length], (NSUInteger)2)]]];
+				break;
+		}
+	}
+
+	NSMutableArray<NSNumber *> *samples = [NSMutableArray arrayWithCapacity:queries.count];
+	NSUInteger emptyCount = 0;
+	for (NSString *query in queries) {
+		@autoreleasepool {
+			CFAbsoluteTime queryStart = CFAbsoluteTimeGetCurrent();
+			NSArray<NSNumber *> *tmdbIDs = [index movieIDsMatchingTitle:query year:0 limit:20];
+			[samples addObject:@((CFAbsoluteTimeGetCurrent() - queryStart) * 1e6)];
+			emptyCount += tmdbIDs.count == 0 ? 1 : 0;
+		}
+	}
+	[self recordBenchmark:[NSString stringWithFormat:@"title_index.%@.query", name] unit:@"us" samples:samples];
+
+	// Every query comes from an indexed title
+	XCTAssertEqual(emptyCount, 0u);
+}
+
+- (void)testTitleIndex100k {
+	[self measureTitleIndex:@"100k" count:100000];
+}
+
+- (void)testTitleIndex1M {
+	[self measureTitleIndex:@"1m" count:1000000];
+}
+
+#pragma mark - End to end
+
+// A connection with 20 to 40 ms between request and response
+- (void)useTypicalLatency {
+	_fixtureTransport.latency = 0.02;
+	_fixtureTransport.latencyJitter = 0.02;
+	[[TMDBBenchmarkTests standInTransport].server setLatency:0.02 jitter:0.02];
+}
+
+- (void)testLoadLatency {
+	[self useTypicalLatency];
+
+	const NSUInteger count = 100;
+	TMDBMovieFetchOptions options = TMDBMovieFetchOptionBasic | TMDBMovieFetchOptionCasts | TMDBMovieFetchOptionKeywords | TMDBMovieFetchOptionImages;
+	NSMutableArray<NSNumber *> *samples = [NSMutableArray arrayWithCapacity:count];
+
+	for (NSUInteger i = 0; i < count; i++) {
+		XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:1000 + i context:self.context];
+
+		CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+		[movie load:options completion:^(NSError *error) {
+			XCTAssertNil(error);
+			[samples addObject:@((CFAbsoluteTimeGetCurrent() - start) * 1000.0)];
+			[expectation fulfill];
+		}];
+		[self waitForExpectationsWithTimeout:5.0 handler:nil];
+	}
+
+	[self recordBenchmark:@"e2e.load_full.latency" unit:@"ms" samples:samples];
+	XCTAssertEqual(samples.count, count);
+}
+
+- (void)testBatchThroughput {
+	[self useTypicalLatency];
+
+	const NSUInteger count = 500;
+	NSMutableArray<NSNumber *> *tmdbIDs = [NSMutableArray arrayWithCapacity:count];
+	for (NSUInteger i = 0; i < count; i++) {
+		[tmdbIDs addObject:@(2000 + i)];
+	}
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	TMDBMovieFetchOptions options = TMDBMovieFetchOptionBasic | TMDBMovieFetchOptionCasts | TMDBMovieFetchOptionKeywords | TMDBMovieFetchOptionImages;
+	__block NSTimeInterval elapsed = 0;
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	[TMDBMovie loadMoviesWithIDs:tmdbIDs options:options context:self.context completionQueue:nil progress:nil completion:^(NSArray<TMDBMovie *> *movies, NSDictionary<NSNumber *, NSError *> *errors) {
+		elapsed = CFAbsoluteTimeGetCurrent() - start;
+		XCTAssertEqual(movies.count, count);
+		XCTAssertEqual(errors.count, 0u);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:60.0 handler:nil];
+
+	[self recordBenchmark:@"e2e.batch_full.throughput" unit:@"movies/s" samples:@[@(count / elapsed)]];
+}
+
+- (void)testSearchLatency {
+	[self useTypicalLatency];
+
+	const NSUInteger count = 50;
+	NSMutableArray<NSNumber *> *samples = [NSMutableArray arrayWithCapacity:count];
+
+	for (NSUInteger i = 0; i < count; i++) {
+		XCTestExpectation *expectation = [self expectationWithDescription:@"searched"];
+
+		CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+		[TMDBMovieSearch moviesWithTitle:[NSString stringWithFormat:@"Fight Club %tu", i] year:0 context:self.context completionQueue:nil resultBlock:nil completion:^(NSArray<TMDBMovie *> *movies, NSError *error) {
+			XCTAssertNil(error);
+			XCTAssertEqual(movies.count, 20u);
+			[samples addObject:@((CFAbsoluteTimeGetCurrent() - start) * 1000.0)];
+			[expectation fulfill];
+		}];
+		[self waitForExpectationsWithTimeout:5.0 handler:nil];
+	}
+
+	[self recordBenchmark:@"e2e.search.latency" unit:@"ms" samples:samples];
+}
+
+#pragma mark - Images
+
+/**
+ * Scrolls a grid of 300 posters, three to a row and four rows on screen, down
+ * to the bottom, back to the top and down again, a row per frame. Cells load
+ * their poster when they scroll on screen and cancel it when they scroll off.
+ * Records the time from a cell asking for its poster to getting it, and the
+ * share of loads that didn't need a download.
+ */
+- (void)testScrollingGrid {
+	TMDBStandInServer *server = [TMDBBenchmarkTests standInTransport].server;
+	if (server == nil) {
+		NSLog(@"iTMDb: Skipping the grid benchmark, as images are only served by the stand-in server");
+		return;
+	}
+
+	[self useTypicalLatency];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"configuration"];
+	[self.context.configuration reload:^(NSError *error) {
+		XCTAssertNil(error);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	const NSUInteger columns = 3;
+	const NSUInteger visibleRows = 4;
+	const NSUInteger rows = 100;
+
+	NSMutableArray<NSDictionary *> *rawPosters = [NSMutableArray arrayWithCapacity:rows * columns];
+	for (NSUInteger i = 0; i < rows * columns; i++) {
+		[rawPosters addObject:@{@"file_path": [NSString stringWithFormat:@"/grid%tu.jpg", i], @"width": @500, @"height": @750}];
+	}
+	NSArray<TMDBImage *> *posters = [TMDBImage imageArrayWithRawImageDictionaries:rawPosters ofType:TMDBImageTypePoster context:self.context];
+
+	NSMutableArray<NSNumber *> *firstRows = [NSMutableArray array];
+	for (NSUInteger row = 0; row + visibleRows <= rows; row++) {
+		[firstRows addObject:@(row)];
+	}
+	NSArray<NSNumber *> *downAndUp = [firstRows arrayByAddingObjectsFromArray:firstRows.reverseObjectEnumerator.allObjects];
+	NSArray<NSNumber *> *scroll = [downAndUp arrayByAddingObjectsFromArray:firstRows];
+
+	TMDBImageLoader *loader = [[TMDBImageLoader alloc] initWithDirectoryURL:nil];
+	loader.completionQueue = dispatch_get_main_queue();
+	[server resetRequestCounts];
+
+	NSMutableDictionary<NSNumber *, TMDBImageLoadToken *> *cells = [NSMutableDictionary dictionary];
+	NSMutableSet<NSNumber *> *waiting = [NSMutableSet set];
+	NSMutableArray<NSNumber *> *latencies = [NSMutableArray array];
+	NSUInteger loads = 0;
+
+	for (NSNumber *firstRow in scroll) {
+		NSRange onScreen = NSMakeRange(firstRow.unsignedIntegerValue * columns, visibleRows * columns);
+
+		for (NSNumber *index in cells.allKeys) {
+			if (!NSLocationInRange(index.unsignedIntegerValue, onScreen)) {
+				[cells[index] cancel];
+				[cells removeObjectForKey:index];
+				[waiting removeObject:index];
+			}
+		}
+
+		for (NSUInteger i = onScreen.location; i < NSMaxRange(onScreen); i++) {
+			NSNumber *index = @(i);
+			if (cells[index] != nil) {
+				continue;
+			}
+
+			loads++;
+			[waiting addObject:index];
+			CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+			cells[index] = [loader loadImage:posters[i] closestToSize:185 dimension:TMDBImageSizeWidth priority:NSOperationQueuePriorityNormal completion:^(NSData *data, NSError *error) {
+				XCTAssertNotNil(data);
+				[latencies addObject:@((CFAbsoluteTimeGetCurrent() - start) * 1000.0)];
+				[waiting removeObject:index];
+			}];
+		}
+
+		[[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1.0 / 60.0]];
+	}
+
+	// The cells left on screen
+	NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:10.0];
+	while (waiting.count > 0 && deadline.timeIntervalSinceNow > 0) {
+		[[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}
+	XCTAssertEqual(waiting.count, 0u);
+
+	NSUInteger downloads = 0;
+	NSDictionary<NSString *, NSNumber *> *requestCounts = server.requestCounts;
+	for (NSString *path in requestCounts) {
+		if ([path hasPrefix:@"/t/p/"]) {
+			downloads += requestCounts[path].unsignedIntegerValue;
+		}
+	}
+
+	[self recordBenchmark:@"images.grid.cell_latency" unit:@"ms" samples:latencies];
+	[self recordBenchmark:@"images.grid.hit_rate" unit:@"%" samples:@[@(100.0 * (loads - MIN(downloads, loads)) / loads)]];
+	XCTAssertLessThanOrEqual(downloads, rows * columns * 3);
+}
+
+#pragma mark - Transport
+
+/**
+ * Loads `rounds` rounds of `count` movies at once, and records the movies
+ * loaded per second and the share of the time the main thread was busy.
+ */
+- (void)measureTransport:(NSString *)name rounds:(NSUInteger)rounds count:(NSUInteger)count firstID:(NSUInteger)firstID {
+	NSMutableArray<NSNumber *> *throughputs = [NSMutableArray arrayWithCapacity:rounds];
+	NSMutableArray<NSNumber *> *occupancies = [NSMutableArray arrayWithCapacity:rounds];
+	TMDBMovieFetchOptions options = TMDBMovieFetchOptionBasic | TMDBMovieFetchOptionCasts | TMDBMovieFetchOptionKeywords | TMDBMovieFetchOptionImages;
+
+	for (NSUInteger round = 0; round < rounds; round++) {
+		XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+		__block NSUInteger remaining = count;
+		__block NSTimeInterval elapsed = 0;
+
+		CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+		NSTimeInterval mainStart = TMDBThreadCPUTime();
+		for (NSUInteger i = 0; i < count; i++) {
+			TMDBMovie *movie = [[TMDBMovie alloc] initWithID:firstID + round * count + i context:self.context];
+			[movie load:options completion:^(NSError *error) {
+				XCTAssertNil(error);
+				if (--remaining == 0) {
+					elapsed = CFAbsoluteTimeGetCurrent() - start;
+					[expectation fulfill];
+				}
+			}];
+		}
+		[self waitForExpectationsWithTimeout:60.0 handler:nil];
+		NSTimeInterval mainTime = TMDBThreadCPUTime() - mainStart;
+
+		if (elapsed > 0) {
+			[throughputs addObject:@(count / elapsed)];
+			[occupancies addObject:@(100.0 * mainTime / elapsed)];
+		}
+	}
+
+	[self recordBenchmark:[NSString stringWithFormat:@"e2e.transport.%@.throughput", name] unit:@"movies/s" samples:throughputs];
+	[self recordBenchmark:[NSString stringWithFormat:@"e2e.transport.%@.main_thread_occupancy", name] unit:@"%" samples:occupancies];
+	XCTAssertEqual(throughputs.count, rounds);
+}
+
+// Requests delivered and decoded on the main thread, as before the transport
+// moved to a background queue, and as they are now
+- (void)testTransportMainThreadOccupancy {
+	[self useTypicalLatency];
+
+	id<TMDBTransport> transport = [TMDBRequest transport];
+	[TMDBRequest setTransport:[[TMDBMainThreadTransport alloc] initWithTransport:transport]];
+	[self measureTransport:@"main_thread_delivery" rounds:10 count:100 firstID:10000];
+
+	[TMDBRequest setTransport:transport];
+	[self measureTransport:@"background_delivery" rounds:10 count:100 firstID:20000];
+}
+
+@end
@@ -0,0 +1,88 @@
+//
+//  TMDBCreditTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovie.h"
+#import "TMDBMovie+Private.h"
+#import "TMDBCredit.h"
+#import "TMDBPerson.h"
+
+@interface TMDBCreditTests : TMDBTestCase
+
+@end
+
+@implementation TMDBCreditTests
+
+- (void)testCastMembershipComesFromTheListTheCreditWasIn {
+	NSMutableDictionary *d = [[TMDBTestCase movieDictionaryWithID:550] mutableCopy];
+	d[@"casts"] = @{
+		// Cast members without a known character, and crew members with one
+		@"cast": @[@{@"id": @287, @"name": @"Brad Pitt", @"character": [NSNull null], @"order": @0, @"cast_id": @4},
+				   @{@"id": @819, @"name": @"Edward Norton", @"order": @1, @"cast_id": @5}],
+		@"crew": @[@{@"id": @7467, @"name": @"David Fincher", @"job": @"Director", @"department": @"Directing", @"character": @"Himself"}]
+	};
+
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	[movie populate:d];
+
+	XCTAssertEqual(movie.credits.count, 3u);
+	XCTAssertTrue(movie.credits[0].isCastMember);
+	XCTAssertTrue(movie.credits[1].isCastMember);
+	XCTAssertFalse(movie.credits[2].isCastMember);
+
+	// A snapshot puts every credit back in the list it came from
+	NSDictionary *casts = [movie responseDictionary][@"casts"];
+	XCTAssertEqual([casts[@"cast"] count], 2u);
+	XCTAssertEqual([casts[@"crew"] count], 1u);
+
+	TMDBMovie *restored = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	[restored populate:[movie responseDictionary]];
+	XCTAssertEqual([[restored.credits filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"castMember == YES"]] count], 2u);
+}
+
+- (void)testMovieCreditsLetGoOfTheirPerson {
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:@{
+			@"id": @287,
+			@"name": @"Brad Pitt",
+			@"movie_credits": @{@"cast": @[@{@"id": @550, @"title": @"Fight Club", @"character": @"Tyler Durden"}]}
+		}];
+	}];
+
+	__weak TMDBPerson *weakPerson = nil;
+	TMDBCredit *credit = nil;
+
+	@autoreleasepool {
+		TMDBPerson *person = [[TMDBPerson alloc] initWithID:287 context:self.context];
+		weakPerson = person;
+
+		XCTestExpectation *expectation = [self expectationWithDescription:@"updated"];
+		[person update:TMDBPersonUpdateOptionBasic | TMDBPersonUpdateOptionCredits completion:^(NSError *error) {
+			XCTAssertNil(error);
+			[expectation fulfill];
+		}];
+		[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+		credit = person.movieCredits.firstObject;
+		XCTAssertEqual(credit.person, person);
+	}
+
+	// The request lets go of the person once it has cleaned up
+	NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:2.0];
+	while (weakPerson != nil && timeout.timeIntervalSinceNow > 0) {
+		[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}
+
+	// The credit keeps its movie, but not the person it was found through
+	XCTAssertNil(weakPerson);
+	XCTAssertNil(credit.person);
+	XCTAssertEqualObjects(credit.movie.title, @"Fight Club");
+	XCTAssertEqualObjects(credit.character, @"Tyler Durden");
+}
+
+@end
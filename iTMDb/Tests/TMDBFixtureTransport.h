@@ -0,0 +1,47 @@
+//
+//  TMDBFixtureTransport.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBScriptedTransport.h"
+
+/**
+ * A stand-in for TMDb that replays recorded responses from the test bundle's
+ * `Fixtures`, after a configurable latency. Requests for paths without a
+ * fixture get an empty `404` response.
+ *
+ * A fixture replayed for a path ending in an ID, such as `/3/movie/550`, is
+ * answered with its top-level `id` changed to the requested one, so a single
+ * recorded movie can stand in for any number of them.
+ */
+@interface TMDBFixtureTransport : TMDBScriptedTransport
+
+/**
+ * The contents of `name`.json in the test bundle, or in the directory in the
+ * environment variable `TMDB_FIXTURE_DIRECTORY` if it is set.
+ */
++ (nullable NSData *)dataForFixtureNamed:(nonnull NSString *)name;
+
+/** The parsed contents of `name`.json in the test bundle. */
++ (nullable id)JSONObjectForFixtureNamed:(nonnull NSString *)name;
+
+- (nonnull instancetype)initWithLatency:(NSTimeInterval)latency;
+
+/** The time from starting a task to delivering its response. */
+@property (atomic) NSTimeInterval latency;
+
+/** The upper bound of a random delay added to each response. Default `0`. */
+@property (atomic) NSTimeInterval latencyJitter;
+
+/** Replays `name`.json for every request whose path has `prefix`. */
+- (void)replayFixtureNamed:(nonnull NSString *)name forPathPrefix:(nonnull NSString *)prefix;
+
+/** Replays `object`, encoded as JSON, for every request whose path has `prefix`. */
+- (void)replayJSONObject:(nonnull id)object forPathPrefix:(nonnull NSString *)prefix;
+
+@end
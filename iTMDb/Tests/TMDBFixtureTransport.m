@@ -0,0 +1,119 @@
+//
+//  TMDBFixtureTransport.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBFixtureTransport.h"
+
+@implementation TMDBFixtureTransport {
+@private
+	// Path prefixes, longest first, and what they are answered with
+	NSMutableArray<NSString *> *_prefixes;
+	NSMutableDictionary<NSString *, id> *_objects;
+	NSMutableDictionary<NSString *, NSData *> *_bodies;
+}
+
++ (NSData *)dataForFixtureNamed:(NSString *)name {
+	// Builds without a test bundle name the fixtures directory instead
+	NSString *directory = [NSProcessInfo processInfo].environment[@"TMDB_FIXTURE_DIRECTORY"];
+	NSURL *url = nil;
+	if (directory.length > 0) {
+		url = [NSURL fileURLWithPath:[directory stringByAppendingPathComponent:[name stringByAppendingPathExtension:@"json"]]];
+	}
+	else {
+		url = [[NSBundle bundleForClass:self] URLForResource:name withExtension:@"json"];
+	}
+	return url != nil ? [NSData dataWithContentsOfURL:url] : nil;
+}
+
++ (id)JSONObjectForFixtureNamed:(NSString *)name {
+	NSData *data = [self dataForFixtureNamed:name];
+	return data != nil ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil;
+}
+
+- (instancetype)initWithHandler:(TMDBScriptedResponseHandler)handler {
+	return (self = [self initWithLatency:0]);
+}
+
+- (instancetype)initWithLatency:(NSTimeInterval)latency {
+	if (!(self = [super initWithHandler:nil])) {
+		return nil;
+	}
+
+	_latency = latency;
+	_prefixes = [NSMutableArray array];
+	_objects = [NSMutableDictionary dictionary];
+	_bodies = [NSMutableDictionary dictionary];
+
+	__weak TMDBFixtureTransport *weakSelf = self;
+	self.handler = ^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [weakSelf responseForRequest:request];
+	};
+
+	return self;
+}
+
+#pragma mark -
+
+- (void)replayFixtureNamed:(NSString *)name forPathPrefix:(NSString *)prefix {
+	NSData *body = [TMDBFixtureTransport dataForFixtureNamed:name];
+	NSAssert(body != nil, @"No fixture named %@", name);
+
+	[self replayBody:body object:[NSJSONSerialization JSONObjectWithData:body options:0 error:NULL] forPathPrefix:prefix];
+}
+
+- (void)replayJSONObject:(id)object forPathPrefix:(NSString *)prefix {
+	[self replayBody:[NSJSONSerialization dataWithJSONObject:object options:0 error:NULL] object:object forPathPrefix:prefix];
+}
+
+- (void)replayBody:(NSData *)body object:(id)object forPathPrefix:(NSString *)prefix {
+	@synchronized(self) {
+		if (_bodies[prefix] == nil) {
+			[_prefixes addObject:prefix];
+			[_prefixes sortUsingComparator:^NSComparisonResult(NSString *a, NSString *b) {
+				return [@(b.length) compare:@(a.length)];
+			}];
+		}
+		_bodies[prefix] = body;
+		_objects[prefix] = object;
+	}
+}
+
+- (TMDBScriptedResponse *)responseForRequest:(NSURLRequest *)request {
+	NSString *path = request.URL.path;
+	NSData *body = nil;
+	id object = nil;
+
+	@synchronized(self) {
+		for (NSString *prefix in _prefixes) {
+			if ([path hasPrefix:prefix]) {
+				body = _bodies[prefix];
+				object = _objects[prefix];
+				break;
+			}
+		}
+	}
+
+	TMDBScriptedResponse *response;
+	if (body == nil) {
+		response = [TMDBScriptedResponse responseWithStatusCode:404 headers:nil body:nil];
+	}
+	else {
+		NSInteger tmdbID = path.lastPathComponent.integerValue;
+		if (tmdbID > 0 && [object isKindOfClass:[NSDictionary class]] && [object[@"id"] integerValue] != tmdbID) {
+			NSMutableDictionary *renumbered = [object mutableCopy];
+			renumbered[@"id"] = @(tmdbID);
+			body = [NSJSONSerialization dataWithJSONObject:renumbered options:0 error:NULL];
+		}
+		response = [TMDBScriptedResponse responseWithStatusCode:200 headers:@{@"Content-Type": @"application/json;charset=utf-8"} body:body];
+	}
+
+	NSTimeInterval jitter = self.latencyJitter;
+	response.latency = self.latency + (jitter > 0 ? jitter * arc4random_uniform(1001) / 1000.0 : 0);
+	return response;
+}
+
+@end
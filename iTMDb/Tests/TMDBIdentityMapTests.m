@@ -0,0 +1,64 @@
+//
+//  TMDBIdentityMapTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovie.h"
+#import "TMDBCredit.h"
+#import "TMDBPerson.h"
+#import "TMDBLanguage.h"
+
+@interface TMDBIdentityMapTests : TMDBTestCase
+
+@end
+
+@implementation TMDBIdentityMapTests
+
+- (TMDBMovie *)movieWithID:(NSUInteger)tmdbID context:(TMDB *)context {
+	NSMutableDictionary *d = [[TMDBTestCase movieDictionaryWithID:tmdbID] mutableCopy];
+	d[@"casts"] = @{
+		@"cast": @[@{@"id": @287, @"name": @"Brad Pitt", @"character": @"Tyler Durden", @"order": @1, @"cast_id": @4, @"profile_path": @"/pitt.jpg"}],
+		@"crew": @[@{@"id": @7467, @"name": @"David Fincher", @"job": @"Director", @"department": @"Directing", @"profile_path": @"/fincher.jpg"}]
+	};
+
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:tmdbID context:context];
+	[movie populate:d];
+	return movie;
+}
+
+- (void)testCastIsTheCreditsSharedPersons {
+	TMDBMovie *first = [self movieWithID:550 context:self.context];
+	TMDBMovie *second = [self movieWithID:551 context:self.context];
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+	XCTAssertEqual(first.cast.count, first.credits.count);
+	for (NSUInteger i = 0; i < first.credits.count; i++) {
+		XCTAssertEqual(first.cast[i], first.credits[i].person);
+	}
+
+	// The same person in two movies is one object
+	XCTAssertEqual(first.cast[0], second.cast[0]);
+#pragma clang diagnostic pop
+	XCTAssertEqualObjects(first.credits[0].character, @"Tyler Durden");
+}
+
+- (void)testLanguagesAreSharedWithinTheMoviesContext {
+	TMDB *otherContext = [[TMDB alloc] initWithAPIKey:nil language:@"en"];
+
+	TMDBMovie *first = [self movieWithID:550 context:self.context];
+	TMDBMovie *second = [self movieWithID:551 context:self.context];
+	TMDBMovie *elsewhere = [self movieWithID:550 context:otherContext];
+
+	TMDBLanguage *english = first.languagesSpoken.firstObject;
+	XCTAssertEqualObjects(english.iso639_1, @"en");
+	XCTAssertEqual(second.languagesSpoken.firstObject, english);
+	XCTAssertNotEqual(elsewhere.languagesSpoken.firstObject, english);
+	XCTAssertNotEqual([TMDBLanguage languagesFromArrayOfDictionaries:@[@{@"iso_639_1": @"en", @"name": @"English"}]].firstObject, english);
+}
+
+@end
@@ -0,0 +1,115 @@
+//
+//  TMDBImageLoaderTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBImageLoader.h"
+#import "TMDBImage+Private.h"
+#import "TMDBConfiguration.h"
+
+@interface TMDBImageLoaderTests : TMDBTestCase
+
+@end
+
+@implementation TMDBImageLoaderTests {
+	TMDBImageLoader *_loader;
+	dispatch_queue_t _completionQueue;
+}
+
+- (void)setUp {
+	[super setUp];
+
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		NSData *body = [@"JFIF image data" dataUsingEncoding:NSUTF8StringEncoding];
+		return [TMDBScriptedResponse responseWithStatusCode:200 headers:@{@"Content-Type": @"image/jpeg"} body:body];
+	}];
+
+	// Image URLs can only be resolved with a loaded configuration
+	XCTestExpectation *expectation = [self expectationWithDescription:@"configuration"];
+	[self.context.configuration reload:^(NSError *error) {
+		XCTAssertNil(error);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	_loader = [[TMDBImageLoader alloc] initWithDirectoryURL:nil];
+	_completionQueue = dispatch_queue_create("dk.devify.iTMDbTests.images", DISPATCH_QUEUE_SERIAL);
+	_loader.completionQueue = _completionQueue;
+}
+
+- (TMDBImage *)posterWithPath:(NSString *)filePath {
+	NSDictionary *rawImage = @{@"file_path": filePath, @"width": @500, @"height": @750};
+	return [TMDBImage imageArrayWithRawImageDictionaries:@[rawImage] ofType:TMDBImageTypePoster context:self.context].firstObject;
+}
+
+- (void)drainCompletionQueue {
+	dispatch_sync(_completionQueue, ^{});
+}
+
+- (void)testCancellingAnInvalidLoad {
+	__block BOOL called = NO;
+
+	dispatch_suspend(_completionQueue);
+	TMDBImageLoadToken *token = [_loader loadImage:[self posterWithPath:@""] size:@"w500" priority:NSOperationQueuePriorityNormal completion:^(NSData *data, NSError *error) {
+		called = YES;
+	}];
+	[token cancel];
+	dispatch_resume(_completionQueue);
+
+	[self drainCompletionQueue];
+	XCTAssertTrue(token.isCancelled);
+	XCTAssertFalse(called);
+}
+
+- (void)testCancellingAMemoryCacheHit {
+	TMDBImage *poster = [self posterWithPath:@"/poster.jpg"];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	[_loader loadImage:poster size:@"w500" priority:NSOperationQueuePriorityNormal completion:^(NSData *data, NSError *error) {
+		XCTAssertNotNil(data);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	__block BOOL called = NO;
+
+	dispatch_suspend(_completionQueue);
+	TMDBImageLoadToken *token = [_loader loadImage:poster size:@"w500" priority:NSOperationQueuePriorityNormal completion:^(NSData *data, NSError *error) {
+		called = YES;
+	}];
+	[token cancel];
+	dispatch_resume(_completionQueue);
+
+	[self drainCompletionQueue];
+	XCTAssertFalse(called);
+	XCTAssertEqual([self.transport requestCountForPath:@"/t/p/w500/poster.jpg"], 1u);
+}
+
+- (void)testCancellingAfterTheDownloadFinished {
+	__block BOOL called = NO;
+
+	// Hold the completion back until the download has finished and the token
+	// has been let go by its operation.
+	dispatch_suspend(_completionQueue);
+	TMDBImageLoadToken *token = [_loader loadImage:[self posterWithPath:@"/poster.jpg"] size:@"w500" priority:NSOperationQueuePriorityNormal completion:^(NSData *data, NSError *error) {
+		called = YES;
+	}];
+
+	NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5.0];
+	while (([self.transport requestCountForPath:@"/t/p/w500/poster.jpg"] == 0 || self.transport.runningTaskCount > 0) && timeout.timeIntervalSinceNow > 0) {
+		[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+	[token cancel];
+	dispatch_resume(_completionQueue);
+
+	[self drainCompletionQueue];
+	XCTAssertFalse(called);
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  TMDBMovieBatchTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovie.h"
+
+@interface TMDBMovieBatchTests : TMDBTestCase
+
+@end
+
+@implementation TMDBMovieBatchTests
+
+- (NSArray<NSNumber *> *)movieIDsWithCount:(NSUInteger)count {
+	NSMutableArray<NSNumber *> *tmdbIDs = [NSMutableArray arrayWithCapacity:count];
+	for (NSUInteger i = 0; i < count; i++) {
+		// Out of order, so the results can't come back sorted by accident
+		[tmdbIDs addObject:@(count - i)];
+	}
+	return tmdbIDs;
+}
+
+- (void)testLoadsTenThousandMoviesInOrder {
+	const NSUInteger count = 10000;
+	NSArray<NSNumber *> *tmdbIDs = [self movieIDsWithCount:count];
+
+	// A budget the batch can't exhaust, so the benchmark measures the pipeline
+	[self.context setRateLimitRequests:100000 perWindow:1.0];
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]]];
+		response.latency = 0.005;
+		return response;
+	}];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	dispatch_queue_t queue = dispatch_queue_create("dk.devify.iTMDbTests.batch", DISPATCH_QUEUE_SERIAL);
+	__block NSUInteger progressCount = 0;
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	NSProgress *progress = [TMDBMovie loadMoviesWithIDs:tmdbIDs options:TMDBMovieFetchOptionBasic context:self.context completionQueue:queue progress:^(TMDBMovie *movie, NSUInteger index, NSError *error) {
+		XCTAssertEqual(movie.tmdbID, tmdbIDs[index].integerValue);
+		progressCount++;
+	} completion:^(NSArray<TMDBMovie *> *movies, NSDictionary<NSNumber *, NSError *> *errors) {
+		NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+		NSLog(@"iTMDb: Loaded %tu movies in %.2f s, %.0f movies/s, at most %tu requests in flight",
+			  movies.count, elapsed, movies.count / elapsed, self.transport.maximumConcurrentTasks);
+
+		XCTAssertEqual(movies.count, count);
+		XCTAssertEqual(errors.count, 0u);
+		for (NSUInteger i = 0; i < count; i++) {
+			if (movies[i].tmdbID != tmdbIDs[i].integerValue || movies[i].title == nil) {
+				XCTFail(@"Movie %tu is out of order or not loaded", i);
+				break;
+			}
+		}
+		[expectation fulfill];
+	}];
+
+	[self waitForExpectationsWithTimeout:120.0 handler:nil];
+
+	XCTAssertEqual(progressCount, count);
+	XCTAssertEqual(progress.completedUnitCount, (int64_t)count);
+	XCTAssertEqual([self.transport requestCountForPathPrefix:[NSString stringWithFormat:@"/%@/movie/", TMDBAPIVersion]], count);
+	// The configuration may be loading alongside the batch
+	XCTAssertLessThanOrEqual(self.transport.maximumConcurrentTasks, 9u);
+}
+
+- (void)testCancellingTheProgressCancelsTheWholeBatch {
+	const NSUInteger count = 100;
+	NSArray<NSNumber *> *tmdbIDs = [self movieIDsWithCount:count];
+
+	[self.context setRateLimitRequests:1000 perWindow:1.0];
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse hangingResponse];
+	}];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"cancelled"];
+
+	NSProgress *progress = [TMDBMovie loadMoviesWithIDs:tmdbIDs options:TMDBMovieFetchOptionBasic context:self.context completionQueue:nil progress:nil completion:^(NSArray<TMDBMovie *> *movies, NSDictionary<NSNumber *, NSError *> *errors) {
+		XCTAssertEqual(movies.count, count);
+		XCTAssertEqual(errors.count, count);
+		for (NSError *error in errors.allValues) {
+			XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+			XCTAssertEqual(error.code, NSURLErrorCancelled);
+		}
+		[expectation fulfill];
+	}];
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+		[progress cancel];
+	});
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	// Give the transport a moment to wind down the cancelled tasks
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+
+	NSUInteger requestCount = [self.transport requestCountForPathPrefix:[NSString stringWithFormat:@"/%@/movie/", TMDBAPIVersion]];
+	XCTAssertEqual(requestCount, 8u);
+	XCTAssertEqual(self.transport.cancelledTaskCount, requestCount);
+}
+
+@end
@@ -0,0 +1,99 @@
+//
+//  TMDBMovieSearchCursorTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovieSearchCursor.h"
+
+@interface TMDBMovieSearchCursorTests : TMDBTestCase
+
+@end
+
+@implementation TMDBMovieSearchCursorTests
+
+- (void)setUp {
+	[super setUp];
+
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		NSURLComponents *components = [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:NO];
+		NSUInteger page = 1;
+		for (NSURLQueryItem *item in components.queryItems) {
+			if ([item.name isEqualToString:@"page"]) {
+				page = (NSUInteger)MAX(item.value.integerValue, 1);
+			}
+		}
+
+		NSDictionary *body = [TMDBTestCase searchPageDictionaryWithPage:page totalPages:10 firstID:page * 100 count:20];
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:body];
+	}];
+}
+
+- (void)takePagesFromCursor:(TMDBMovieSearchCursor *)cursor count:(NSUInteger)count {
+	for (NSUInteger i = 0; i < count; i++) {
+		XCTestExpectation *expectation = [self expectationWithDescription:@"page"];
+		[cursor nextPage:^(NSArray<TMDBMovie *> *movies, NSError *error) {
+			XCTAssertNil(error);
+			XCTAssertEqual(movies.count, 20u);
+			[expectation fulfill];
+		}];
+		[self waitForExpectationsWithTimeout:5.0 handler:nil];
+	}
+
+	// Let any lookahead requests reach the transport
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+}
+
+- (NSUInteger)searchRequestCount {
+	return [self requestCountForPath:@"/search/movie"];
+}
+
+- (void)testLookaheadOfZeroOnlyLoadsOnDemand {
+	TMDBMovieSearchCursor *cursor = [[TMDBMovieSearchCursor alloc] initWithTitle:@"Movie" year:0 context:self.context];
+	cursor.lookahead = 0;
+
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+	XCTAssertEqual([self searchRequestCount], 0u);
+
+	[self takePagesFromCursor:cursor count:1];
+	XCTAssertEqual([self searchRequestCount], 1u);
+
+	[self takePagesFromCursor:cursor count:2];
+	XCTAssertEqual([self searchRequestCount], 3u);
+}
+
+- (void)testLookaheadLoadsThatManyPagesAhead {
+	TMDBMovieSearchCursor *cursor = [[TMDBMovieSearchCursor alloc] initWithTitle:@"Movie" year:0 context:self.context];
+	cursor.lookahead = 2;
+
+	[self takePagesFromCursor:cursor count:1];
+	XCTAssertEqual([self searchRequestCount], 3u);
+
+	[self takePagesFromCursor:cursor count:1];
+	XCTAssertEqual([self searchRequestCount], 4u);
+}
+
+- (void)testStopsAtMaximumPages {
+	TMDBMovieSearchCursor *cursor = [[TMDBMovieSearchCursor alloc] initWithTitle:@"Movie" year:0 context:self.context];
+	cursor.lookahead = 5;
+	cursor.maximumPages = 2;
+
+	[self takePagesFromCursor:cursor count:2];
+	XCTAssertEqual([self searchRequestCount], 2u);
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"end"];
+	[cursor nextPage:^(NSArray<TMDBMovie *> *movies, NSError *error) {
+		XCTAssertNil(error);
+		XCTAssertEqual(movies.count, 0u);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	XCTAssertEqual([self searchRequestCount], 2u);
+	XCTAssertEqual(cursor.currentPage, 2u);
+}
+
+@end
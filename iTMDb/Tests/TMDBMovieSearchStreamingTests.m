@@ -0,0 +1,77 @@
+//
+//  TMDBMovieSearchStreamingTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovieSearch.h"
+
+@interface TMDBMovieSearchStreamingTests : TMDBTestCase
+
+@end
+
+@implementation TMDBMovieSearchStreamingTests
+
+- (void)setUp {
+	[super setUp];
+
+	// A throttled connection, delivering a page of 20 results over about a second
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		NSDictionary *page = [TMDBTestCase searchPageDictionaryWithPage:1 totalPages:1 firstID:100 count:20];
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:page];
+		response.latency = 0.05;
+		response.chunkLength = 512;
+		response.chunkInterval = response.body.length > 0 ? 1.0 / (response.body.length / 512.0) : 0;
+		return response;
+	}];
+}
+
+- (void)searchStreaming:(BOOL)streaming timeToFirstResult:(NSTimeInterval *)timeToFirstResult timeToCompletion:(NSTimeInterval *)timeToCompletion {
+	XCTestExpectation *expectation = [self expectationWithDescription:@"searched"];
+	NSMutableArray<TMDBMovie *> *results = [NSMutableArray array];
+	__block CFAbsoluteTime firstResultAt = 0;
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	TMDBMovieSearchResultBlock resultBlock = ^(TMDBMovie *movie) {
+		if (firstResultAt == 0) {
+			firstResultAt = CFAbsoluteTimeGetCurrent();
+		}
+		[results addObject:movie];
+	};
+
+	[TMDBMovieSearch moviesWithTitle:@"Movie" year:0 context:self.context completionQueue:nil resultBlock:streaming ? resultBlock : nil completion:^(NSArray<TMDBMovie *> *movies, NSError *error) {
+		CFAbsoluteTime completedAt = CFAbsoluteTimeGetCurrent();
+
+		XCTAssertNil(error);
+		XCTAssertEqual(movies.count, 20u);
+		if (streaming) {
+			XCTAssertEqualObjects(results, movies);
+		}
+
+		*timeToFirstResult = (firstResultAt > 0 ? firstResultAt : completedAt) - start;
+		*timeToCompletion = completedAt - start;
+		[expectation fulfill];
+	}];
+
+	[self waitForExpectationsWithTimeout:10.0 handler:nil];
+}
+
+- (void)testFirstResultArrivesBeforeTheBodyIsComplete {
+	NSTimeInterval bufferedFirst = 0, bufferedCompletion = 0;
+	[self searchStreaming:NO timeToFirstResult:&bufferedFirst timeToCompletion:&bufferedCompletion];
+
+	NSTimeInterval streamedFirst = 0, streamedCompletion = 0;
+	[self searchStreaming:YES timeToFirstResult:&streamedFirst timeToCompletion:&streamedCompletion];
+
+	NSLog(@"iTMDb: Time to first result %.0f ms streamed, %.0f ms buffered (completion %.0f ms)",
+		  streamedFirst * 1000.0, bufferedFirst * 1000.0, streamedCompletion * 1000.0);
+
+	XCTAssertLessThan(streamedFirst, streamedCompletion / 4.0);
+	XCTAssertLessThan(streamedFirst, bufferedFirst / 4.0);
+	XCTAssertEqual([self requestCountForPath:@"/search/movie"], 2u);
+}
+
+@end
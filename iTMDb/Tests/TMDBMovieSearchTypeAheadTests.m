@@ -0,0 +1,102 @@
+//
+//  TMDBMovieSearchTypeAheadTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovieSearch.h"
+
+@interface TMDBMovieSearchTypeAheadTests : TMDBTestCase
+
+@end
+
+@implementation TMDBMovieSearchTypeAheadTests
+
++ (NSString *)queryOfRequest:(NSURLRequest *)request {
+	for (NSURLQueryItem *item in [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:NO].queryItems) {
+		if ([item.name isEqualToString:@"query"]) {
+			return item.value;
+		}
+	}
+	return nil;
+}
+
+// Types a title a character at a time, faster than searches are answered,
+// searching for every prefix and cancelling the search for the previous one,
+// as a search field does. Counts the requests nobody was listening for.
+- (void)testTypingCancelsStaleSearches {
+	NSString *title = @"Fight Club";
+	NSTimeInterval keystrokeInterval = 0.05;
+
+	// Queries whose search has been cancelled, and the requests started for them
+	NSMutableSet<NSString *> *cancelledQueries = [NSMutableSet set];
+	__block NSUInteger requestsStartedUnheard = 0;
+
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		@synchronized(cancelledQueries) {
+			if ([cancelledQueries containsObject:[TMDBMovieSearchTypeAheadTests queryOfRequest:request]]) {
+				requestsStartedUnheard++;
+			}
+		}
+
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase searchPageDictionaryWithPage:1 totalPages:1 firstID:100 count:5]];
+		response.latency = keystrokeInterval * 3;
+		return response;
+	}];
+
+	__block NSUInteger staleCompletions = 0;
+	__block NSArray<TMDBMovie *> *results = nil;
+	TMDBRequestToken *token = nil;
+	NSString *previousQuery = nil;
+	XCTestExpectation *expectation = [self expectationWithDescription:@"searched"];
+
+	for (NSUInteger length = 1; length <= title.length; length++) {
+		NSString *query = [title substringToIndex:length];
+		BOOL isLast = length == title.length;
+
+		if (token != nil) {
+			@synchronized(cancelledQueries) {
+				[cancelledQueries addObject:previousQuery];
+			}
+			[token cancel];
+		}
+
+		token = [TMDBMovieSearch moviesWithTitle:query year:0 context:self.context completionQueue:nil resultBlock:nil completion:^(NSArray<TMDBMovie *> *movies, NSError *error) {
+			if (!isLast) {
+				staleCompletions++;
+				return;
+			}
+			XCTAssertNil(error);
+			results = movies;
+			[expectation fulfill];
+		}];
+		previousQuery = query;
+
+		[[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:keystrokeInterval]];
+	}
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	// Let cancelled tasks finish winding down
+	NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:2.0];
+	while (self.transport.runningTaskCount > 0 && deadline.timeIntervalSinceNow > 0) {
+		[[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}
+
+	NSUInteger requestsStarted = [self requestCountForPath:@"/search/movie"];
+	NSUInteger requestsCompleted = requestsStarted - self.transport.cancelledTaskCount;
+	NSUInteger requestsCompletedUnheard = requestsCompleted - MIN(requestsCompleted, (NSUInteger)1);
+	NSLog(@"iTMDb: Typing %tu characters started %tu searches, %tu of them for a cancelled query, and completed %tu that nobody was waiting for", title.length, requestsStarted, requestsStartedUnheard, requestsCompletedUnheard);
+
+	XCTAssertEqual(results.count, 5u);
+	XCTAssertEqual(staleCompletions, 0u);
+	XCTAssertLessThanOrEqual(requestsStarted, title.length);
+	XCTAssertEqual(requestsStartedUnheard, 0u);
+	XCTAssertEqual(requestsCompletedUnheard, 0u);
+	XCTAssertEqual(self.transport.runningTaskCount, 0u);
+}
+
+@end
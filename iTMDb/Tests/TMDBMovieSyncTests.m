@@ -0,0 +1,130 @@
+//
+//  TMDBMovieSyncTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovieSync.h"
+
+// The number of changes TMDb lists per page of the changes feed
+static const NSUInteger TMDBMovieSyncTestsPageSize = 100;
+
+@interface TMDBMovieSyncTests : TMDBTestCase
+
+@end
+
+@implementation TMDBMovieSyncTests
+
+- (void)setUp {
+	[super setUp];
+
+	[self.context setRateLimitRequests:100000 perWindow:1.0];
+}
+
+/**
+ * Serves a changes feed listing `changedIDs`, a page at a time, and answers
+ * every movie request.
+ */
+- (void)serveChangedIDs:(NSArray<NSNumber *> *)changedIDs {
+	NSString *changesPath = [NSString stringWithFormat:@"/%@/movie/changes", TMDBAPIVersion];
+	NSUInteger totalPages = MAX((changedIDs.count + TMDBMovieSyncTestsPageSize - 1) / TMDBMovieSyncTestsPageSize, (NSUInteger)1);
+
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		if (![request.URL.path isEqualToString:changesPath]) {
+			return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]]];
+		}
+
+		NSUInteger page = 1;
+		for (NSURLQueryItem *item in [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:NO].queryItems) {
+			if ([item.name isEqualToString:@"page"]) {
+				page = (NSUInteger)MAX(item.value.integerValue, 1);
+			}
+		}
+
+		NSMutableArray *results = [NSMutableArray array];
+		NSUInteger first = (page - 1) * TMDBMovieSyncTestsPageSize;
+		for (NSUInteger i = first; i < MIN(first + TMDBMovieSyncTestsPageSize, changedIDs.count); i++) {
+			[results addObject:@{@"id": changedIDs[i], @"adult": @NO}];
+		}
+
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:@{@"results": results, @"page": @(page), @"total_pages": @(totalPages), @"total_results": @(changedIDs.count)}];
+	}];
+}
+
+/**
+ * Syncs `trackedCount` movies, of which `changedCount` have changed, in a
+ * feed that also lists `untrackedCount` changes to other movies. Returns the
+ * number of requests for changes and for movies the sync made.
+ */
+- (void)syncTracking:(NSUInteger)trackedCount changed:(NSUInteger)changedCount untracked:(NSUInteger)untrackedCount changesRequests:(NSUInteger *)changesRequests movieRequests:(NSUInteger *)movieRequests {
+	NSMutableArray<TMDBMovie *> *movies = [NSMutableArray arrayWithCapacity:trackedCount];
+	NSMutableArray<NSNumber *> *changedIDs = [NSMutableArray array];
+
+	TMDBMovieSync *sync = [[TMDBMovieSync alloc] initWithContext:self.context];
+	sync.options = TMDBMovieFetchOptionBasic;
+	sync.highWaterMark = [NSDate dateWithTimeIntervalSinceNow:-86400.0];
+
+	for (NSUInteger i = 1; i <= trackedCount; i++) {
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:i context:self.context];
+		[movies addObject:movie];
+		[sync addMovie:movie];
+
+		// Changes spread over the tracked movies
+		if (changedCount > 0 && i % (trackedCount / changedCount) == 0 && changedIDs.count < changedCount) {
+			[changedIDs addObject:@(i)];
+		}
+	}
+	for (NSUInteger i = 0; i < untrackedCount; i++) {
+		[changedIDs insertObject:@(1000000 + i) atIndex:(changedIDs.count * i) / MAX(untrackedCount, (NSUInteger)1)];
+	}
+	XCTAssertEqual(changedIDs.count, changedCount + untrackedCount);
+
+	[self serveChangedIDs:changedIDs];
+
+	NSString *changesPath = [NSString stringWithFormat:@"/%@/movie/changes", TMDBAPIVersion];
+	NSString *moviePrefix = [NSString stringWithFormat:@"/%@/movie/", TMDBAPIVersion];
+	NSUInteger changesBefore = [self.transport requestCountForPath:changesPath];
+	NSUInteger moviesBefore = [self.transport requestCountForPathPrefix:moviePrefix] - changesBefore;
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"synced"];
+	[sync syncWithCompletionQueue:nil completion:^(NSArray<TMDBMovie *> *updatedMovies, NSError *error) {
+		XCTAssertNil(error);
+		XCTAssertEqual(updatedMovies.count, changedCount);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:30.0 handler:nil];
+
+	NSUInteger changesAfter = [self.transport requestCountForPath:changesPath];
+	*changesRequests = changesAfter - changesBefore;
+	*movieRequests = [self.transport requestCountForPathPrefix:moviePrefix] - changesAfter - moviesBefore;
+}
+
+- (void)testRequestsAreProportionalToTheChanges {
+	for (NSNumber *changed in @[@0, @10, @100, @250]) {
+		NSUInteger changedCount = changed.unsignedIntegerValue;
+		NSUInteger changesRequests = 0, movieRequests = 0;
+
+		[self syncTracking:1000 changed:changedCount untracked:150 changesRequests:&changesRequests movieRequests:&movieRequests];
+
+		NSLog(@"iTMDb: Synced 1000 movies with %tu changed in %tu + %tu requests", changedCount, changesRequests, movieRequests);
+		XCTAssertEqual(movieRequests, changedCount);
+		XCTAssertEqual(changesRequests, (changedCount + 150 + TMDBMovieSyncTestsPageSize - 1) / TMDBMovieSyncTestsPageSize);
+	}
+}
+
+- (void)testRequestsDoNotDependOnTheNumberOfTrackedMovies {
+	NSUInteger fewChanges = 0, fewMovies = 0;
+	[self syncTracking:100 changed:20 untracked:150 changesRequests:&fewChanges movieRequests:&fewMovies];
+
+	NSUInteger manyChanges = 0, manyMovies = 0;
+	[self syncTracking:5000 changed:20 untracked:150 changesRequests:&manyChanges movieRequests:&manyMovies];
+
+	XCTAssertEqual(fewMovies, 20u);
+	XCTAssertEqual(manyMovies, 20u);
+	XCTAssertEqual(fewChanges, manyChanges);
+}
+
+@end
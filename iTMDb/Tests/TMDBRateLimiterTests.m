@@ -0,0 +1,140 @@
+//
+//  TMDBRateLimiterTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovie.h"
+
+// Requests may reach the server a little later than the limiter let them go,
+// so the server forgives arrivals that are this close to the window edge.
+static const NSTimeInterval TMDBRateLimiterTestsTolerance = 0.05;
+
+@interface TMDBRateLimiterTests : TMDBTestCase
+
+@end
+
+@implementation TMDBRateLimiterTests {
+	NSMutableArray<NSNumber *> *_arrivals;
+	NSUInteger _rateLimitedCount;
+}
+
+// Stands in for TMDb enforcing `limit` requests per `window` seconds, and
+// answering any request over it with a 429.
+- (void)serveWithLimit:(NSUInteger)limit window:(NSTimeInterval)window {
+	_arrivals = [NSMutableArray array];
+	_rateLimitedCount = 0;
+
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+		NSDictionary *limitHeaders = @{@"X-RateLimit-Limit": [NSString stringWithFormat:@"%tu", limit]};
+
+		@synchronized(self) {
+			while (_arrivals.count > 0 && _arrivals.firstObject.doubleValue + window - TMDBRateLimiterTestsTolerance <= now) {
+				[_arrivals removeObjectAtIndex:0];
+			}
+
+			if (_arrivals.count >= limit) {
+				_rateLimitedCount++;
+				NSMutableDictionary *headers = [limitHeaders mutableCopy];
+				headers[@"Retry-After"] = [NSString stringWithFormat:@"%.0f", ceil(window)];
+				return [TMDBScriptedResponse responseWithStatusCode:429 headers:headers body:nil];
+			}
+
+			[_arrivals addObject:@(now)];
+		}
+
+		NSDictionary *movie = [TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]];
+		NSData *body = [NSJSONSerialization dataWithJSONObject:movie options:0 error:NULL];
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 headers:limitHeaders body:body];
+		response.latency = 0.02;
+		return response;
+	}];
+}
+
+- (NSArray<NSError *> *)loadMovieCount:(NSUInteger)count elapsed:(NSTimeInterval *)elapsed {
+	NSMutableArray<NSError *> *errors = [NSMutableArray array];
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	__block NSUInteger remaining = count;
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	for (NSUInteger i = 1; i <= count; i++) {
+		TMDBMovie *movie = [[TMDBMovie alloc] initWithID:i context:self.context];
+		[movie load:TMDBMovieFetchOptionBasic completion:^(NSError *error) {
+			if (error != nil) {
+				[errors addObject:error];
+			}
+			if (--remaining == 0) {
+				[expectation fulfill];
+			}
+		}];
+	}
+
+	[self waitForExpectationsWithTimeout:60.0 handler:nil];
+	*elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+	return errors;
+}
+
+- (void)testSoakStaysUnderTheLimitAtFullSpeed {
+	const NSUInteger limit = 20;
+	const NSUInteger count = 100;
+	[self.context setRateLimitRequests:limit perWindow:1.0];
+	[self serveWithLimit:limit window:1.0];
+
+	NSTimeInterval elapsed = 0;
+	NSArray<NSError *> *errors = [self loadMovieCount:count elapsed:&elapsed];
+
+	// The first window is spent in a burst, and every later one at the limit,
+	// so 100 requests take just over 4 seconds at full speed.
+	NSTimeInterval ideal = (count - limit) / (double)limit;
+	NSLog(@"iTMDb: %tu requests in %.2f s (ideal %.2f s), %.1f requests/s sustained, %tu rate limited",
+		  count, elapsed, ideal, (count - limit) / elapsed, _rateLimitedCount);
+
+	XCTAssertEqual(errors.count, 0u);
+	XCTAssertEqual(_rateLimitedCount, 0u);
+	XCTAssertGreaterThanOrEqual(elapsed, ideal - TMDBRateLimiterTestsTolerance);
+	XCTAssertLessThan(elapsed, ideal * 1.15);
+	XCTAssertEqual([self requestCountForPath:@"/movie/1"], 1u);
+}
+
+- (void)testSlowsDownToALowerServerLimit {
+	const NSUInteger limit = 20;
+	const NSUInteger count = 100;
+	// The client believes it may make twice as many requests as the server allows
+	[self.context setRateLimitRequests:limit * 2 perWindow:1.0];
+	[self serveWithLimit:limit window:1.0];
+
+	NSTimeInterval elapsed = 0;
+	NSArray<NSError *> *errors = [self loadMovieCount:count elapsed:&elapsed];
+
+	NSLog(@"iTMDb: %tu requests in %.2f s against a lower server limit, %tu rate limited", count, elapsed, _rateLimitedCount);
+
+	// Only the opening burst runs into the server's limit; the rate limit
+	// headers and the 429s bring the budget down after that.
+	XCTAssertEqual(errors.count, 0u);
+	XCTAssertGreaterThan(_rateLimitedCount, 0u);
+	XCTAssertLessThanOrEqual(_rateLimitedCount, limit);
+}
+
+- (void)testContextsWithTheSameKeyShareOneBudget {
+	[self.context setRateLimitRequests:100 perWindow:2.0];
+
+	// A second context with the key doesn't reset the budget to the default
+	TMDB *otherContext = [[TMDB alloc] initWithAPIKey:self.context.apiKey language:@"en"];
+	XCTAssertEqual(otherContext.rateLimitRequests, 100u);
+	XCTAssertEqual(otherContext.rateLimitWindow, 2.0);
+
+	[otherContext setRateLimitRequests:20 perWindow:1.0];
+	XCTAssertEqual(self.context.rateLimitRequests, 20u);
+	XCTAssertEqual(self.context.rateLimitWindow, 1.0);
+
+	TMDB *thirdContext = [[TMDB alloc] initWithAPIKey:self.context.apiKey language:@"de"];
+	XCTAssertEqual(thirdContext.rateLimitRequests, 20u);
+	XCTAssertEqual(thirdContext.rateLimitWindow, 1.0);
+}
+
+@end
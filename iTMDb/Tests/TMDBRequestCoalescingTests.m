@@ -0,0 +1,118 @@
+//
+//  TMDBRequestCoalescingTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBMovie.h"
+#import "TMDBRequestToken.h"
+
+@interface TMDBRequestCoalescingTests : TMDBTestCase
+
+@end
+
+@implementation TMDBRequestCoalescingTests
+
+- (void)setUp {
+	[super setUp];
+
+	[self.context setRateLimitRequests:1000 perWindow:1.0];
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]]];
+		response.latency = 0.2;
+		return response;
+	}];
+}
+
+// A list view asking for the same ten movies from ten cells each
+- (void)testDuplicateLoadsShareOneRequest {
+	const NSUInteger movieCount = 10;
+	const NSUInteger loadsPerMovie = 10;
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	__block NSUInteger remaining = movieCount * loadsPerMovie;
+	__block NSUInteger errorCount = 0;
+
+	for (NSUInteger round = 0; round < loadsPerMovie; round++) {
+		for (NSUInteger tmdbID = 1; tmdbID <= movieCount; tmdbID++) {
+			TMDBMovie *movie = [[TMDBMovie alloc] initWithID:tmdbID context:self.context];
+			[movie load:TMDBMovieFetchOptionBasic completion:^(NSError *error) {
+				if (error != nil) {
+					errorCount++;
+				}
+				else {
+					XCTAssertEqualObjects(movie.title, ([NSString stringWithFormat:@"Movie %tu", tmdbID]));
+				}
+				if (--remaining == 0) {
+					[expectation fulfill];
+				}
+			}];
+		}
+	}
+
+	[self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+	NSUInteger requestCount = [self.transport requestCountForPathPrefix:[NSString stringWithFormat:@"/%@/movie/", TMDBAPIVersion]];
+	NSUInteger loadCount = movieCount * loadsPerMovie;
+	// The share of requests fetching a movie another request already fetched
+	NSLog(@"iTMDb: %tu loads made %tu requests, duplicate ratio %.2f (%.2f without coalescing)",
+		  loadCount, requestCount, (requestCount - movieCount) / (double)requestCount, (loadCount - movieCount) / (double)loadCount);
+
+	XCTAssertEqual(errorCount, 0u);
+	XCTAssertEqual(requestCount, movieCount);
+	for (NSUInteger tmdbID = 1; tmdbID <= movieCount; tmdbID++) {
+		XCTAssertEqual([self requestCountForPath:[NSString stringWithFormat:@"/movie/%tu", tmdbID]], 1u);
+	}
+}
+
+- (void)testCancellingOneCallerKeepsTheSharedRequestForTheOthers {
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	__block BOOL cancelledCalled = NO;
+
+	TMDBMovie *first = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	TMDBRequestToken *token = [first load:TMDBMovieFetchOptionBasic completion:^(NSError *error) {
+		cancelledCalled = YES;
+	}];
+
+	TMDBMovie *second = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	[second load:TMDBMovieFetchOptionBasic completion:^(NSError *error) {
+		XCTAssertNil(error);
+		XCTAssertEqualObjects(second.title, @"Movie 550");
+		[expectation fulfill];
+	}];
+
+	[token cancel];
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	XCTAssertFalse(cancelledCalled);
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 1u);
+	XCTAssertEqual(self.transport.cancelledTaskCount, 0u);
+}
+
+- (void)testCancellingEveryCallerStopsTheSharedRequest {
+	TMDBMovie *first = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	TMDBRequestToken *firstToken = [first load:TMDBMovieFetchOptionBasic completion:nil];
+	TMDBMovie *second = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	TMDBRequestToken *secondToken = [second load:TMDBMovieFetchOptionBasic completion:nil];
+
+	// Cancel once the request has reached the transport
+	XCTestExpectation *expectation = [self expectationWithDescription:@"cancelled"];
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.1 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+		[firstToken cancel];
+		[secondToken cancel];
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.3 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+			[expectation fulfill];
+		});
+	});
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 1u);
+	XCTAssertEqual(self.transport.cancelledTaskCount, 1u);
+}
+
+@end
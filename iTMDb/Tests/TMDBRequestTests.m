@@ -0,0 +1,149 @@
+//
+//  TMDBRequestTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBRequest.h"
+#import "TMDBMovie.h"
+
+@interface TMDBRequestTests : TMDBTestCase
+
+@end
+
+@implementation TMDBRequestTests {
+	NSUInteger _yearChangesOnMainThread;
+	NSUInteger _yearChangesElsewhere;
+}
+
+- (NSURL *)movieURLWithID:(NSUInteger)tmdbID {
+	return [NSURL URLWithString:[TMDBAPIURLBase stringByAppendingFormat:@"%@/movie/%tu?api_key=%@&language=en", TMDBAPIVersion, tmdbID, self.context.apiKey]];
+}
+
+- (void)testCompletionBlocksAreCalledOffTheMainThread {
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]]];
+	}];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+
+	[TMDBRequest requestWithURL:[self movieURLWithID:550] context:self.context completionBlock:^(id parsedData, NSError *error) {
+		XCTAssertFalse([NSThread isMainThread]);
+		XCTAssertNil(error);
+		XCTAssertEqualObjects(parsedData[@"id"], @550);
+		[expectation fulfill];
+	}];
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 1u);
+}
+
+// Measures how long the main thread is kept busy by a burst of requests,
+// which should be next to nothing now that nothing is scheduled on it.
+- (void)testBurstOfRequestsLeavesTheMainThreadIdle {
+	[self.context setRateLimitRequests:10000 perWindow:1.0];
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]]];
+		response.latency = 0.01;
+		response.chunkLength = 64;
+		return response;
+	}];
+
+	const NSUInteger requestCount = 500;
+	dispatch_group_t group = dispatch_group_create();
+	__block NSUInteger callbacksOnMainThread = 0;
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	for (NSUInteger i = 1; i <= requestCount; i++) {
+		dispatch_group_enter(group);
+		[TMDBRequest requestWithURL:[self movieURLWithID:i] context:self.context dataBlock:^(NSData *data) {
+			if ([NSThread isMainThread]) {
+				@synchronized(self) {
+					callbacksOnMainThread++;
+				}
+			}
+		} completionBlock:^(id parsedData, NSError *error) {
+			XCTAssertNil(error);
+			if ([NSThread isMainThread]) {
+				@synchronized(self) {
+					callbacksOnMainThread++;
+				}
+			}
+			dispatch_group_leave(group);
+		}];
+	}
+
+	// The main thread only waits here, which it could not do if it had to
+	// deliver the callbacks itself.
+	long timedOut = dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(30 * NSEC_PER_SEC)));
+	NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+	XCTAssertEqual(timedOut, 0);
+	XCTAssertEqual(callbacksOnMainThread, 0u);
+	NSLog(@"iTMDb: %tu requests in %.2f s, %.0f requests/s", requestCount, elapsed, requestCount / elapsed);
+}
+
+- (void)testCancellingStopsTheTransportTask {
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse hangingResponse];
+	}];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"cancelled"];
+	__block BOOL called = NO;
+
+	TMDBRequestSubscription *subscription = [TMDBRequest requestWithURL:[self movieURLWithID:550] context:self.context completionBlock:^(id parsedData, NSError *error) {
+		called = YES;
+	}];
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+		[subscription cancel];
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+			[expectation fulfill];
+		});
+	});
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+	XCTAssertFalse(called);
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 1u);
+	XCTAssertEqual(self.transport.cancelledTaskCount, 1u);
+	XCTAssertEqual(self.transport.runningTaskCount, 0u);
+}
+
+- (void)testYearChangesAreObservedOnTheCompletionQueue {
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:[TMDBTestCase movieIDFromRequest:request]]];
+	}];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"loaded"];
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+	[movie addObserver:self forKeyPath:@"year" options:NSKeyValueObservingOptionNew context:NULL];
+
+	[movie load:TMDBMovieFetchOptionBasic completion:^(NSError *error) {
+		XCTAssertNil(error);
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+	[movie removeObserver:self forKeyPath:@"year"];
+
+	XCTAssertEqual(movie.year, 1999u);
+	XCTAssertEqual(_yearChangesOnMainThread, 1u);
+	XCTAssertEqual(_yearChangesElsewhere, 0u);
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary<NSKeyValueChangeKey, id> *)change context:(void *)context {
+	XCTAssertEqualObjects(change[NSKeyValueChangeNewKey], @1999);
+	@synchronized(self) {
+		if ([NSThread isMainThread]) {
+			_yearChangesOnMainThread++;
+		}
+		else {
+			_yearChangesElsewhere++;
+		}
+	}
+}
+
+@end
@@ -0,0 +1,267 @@
+//
+//  TMDBRetryTests.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBRequest.h"
+#import "TMDBRetryBudget.h"
+#import "TMDBMovie.h"
+
+@interface TMDBRetryTests : TMDBTestCase
+
+@end
+
+@implementation TMDBRetryTests
+
+- (void)setUp {
+	[super setUp];
+
+	self.context.retryPolicy = [self quickPolicy];
+	[self.context setRateLimitRequests:1000 perWindow:1.0];
+}
+
+// The default policy, with backoffs short enough for a test
+- (TMDBRetryPolicy *)quickPolicy {
+	TMDBRetryPolicy *policy = [[TMDBRetryPolicy alloc] init];
+	policy.initialBackoff = 0.05;
+	policy.maximumBackoff = 0.1;
+	return policy;
+}
+
+- (NSURL *)movieURLWithID:(NSUInteger)tmdbID {
+	return [NSURL URLWithString:[TMDBAPIURLBase stringByAppendingFormat:@"%@/movie/%tu?api_key=%@&language=en", TMDBAPIVersion, tmdbID, self.context.apiKey]];
+}
+
+// Answers the requests for each movie with `statusCodes` in turn, and with
+// the last of them from then on.
+- (void)serveMoviesWithStatusCodes:(NSArray<NSNumber *> *)statusCodes headers:(NSDictionary<NSString *, NSString *> *)headers {
+	NSMutableDictionary<NSNumber *, NSNumber *> *attempts = [NSMutableDictionary dictionary];
+
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		NSUInteger tmdbID = [TMDBTestCase movieIDFromRequest:request];
+		NSUInteger attempt;
+		@synchronized(attempts) {
+			attempt = [attempts[@(tmdbID)] unsignedIntegerValue];
+			attempts[@(tmdbID)] = @(attempt + 1);
+		}
+
+		NSInteger statusCode = statusCodes[MIN(attempt, statusCodes.count - 1)].integerValue;
+		if (statusCode != 200) {
+			return [TMDBScriptedResponse responseWithStatusCode:statusCode headers:headers body:nil];
+		}
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:tmdbID]];
+	}];
+}
+
+- (NSError *)requestMovieWithID:(NSUInteger)tmdbID parsedData:(id *)parsedData elapsed:(NSTimeInterval *)elapsed {
+	XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+	__block NSError *requestError = nil;
+	__block id requestData = nil;
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	[TMDBRequest requestWithURL:[self movieURLWithID:tmdbID] context:self.context completionBlock:^(id data, NSError *error) {
+		requestData = data;
+		requestError = error;
+		[expectation fulfill];
+	}];
+	[self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+	if (parsedData != NULL) {
+		*parsedData = requestData;
+	}
+	if (elapsed != NULL) {
+		*elapsed = CFAbsoluteTimeGetCurrent() - start;
+	}
+	return requestError;
+}
+
+#pragma mark - Retrying
+
+- (void)testRetriesServerErrorsUntilTheRequestSucceeds {
+	[self serveMoviesWithStatusCodes:@[@503, @503, @200] headers:nil];
+
+	id parsedData = nil;
+	NSError *error = [self requestMovieWithID:550 parsedData:&parsedData elapsed:NULL];
+
+	XCTAssertNil(error);
+	XCTAssertEqualObjects(parsedData[@"id"], @550);
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 3u);
+}
+
+- (void)testGivesUpAfterTheMaximumNumberOfRetries {
+	[self serveMoviesWithStatusCodes:@[@503] headers:nil];
+
+	id parsedData = nil;
+	[self requestMovieWithID:550 parsedData:&parsedData elapsed:NULL];
+
+	XCTAssertNil(parsedData);
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 1u + self.context.retryPolicy.maximumRetries);
+}
+
+- (void)testDoesNotRetryClientErrors {
+	[self serveMoviesWithStatusCodes:@[@404, @200] headers:nil];
+
+	id parsedData = nil;
+	[self requestMovieWithID:550 parsedData:&parsedData elapsed:NULL];
+
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 1u);
+}
+
+- (void)testWaitsAsLongAsRetryAfterAsks {
+	[self serveMoviesWithStatusCodes:@[@503, @200] headers:@{@"Retry-After": @"1"}];
+
+	NSTimeInterval elapsed = 0;
+	NSError *error = [self requestMovieWithID:550 parsedData:NULL elapsed:&elapsed];
+
+	XCTAssertNil(error);
+	XCTAssertGreaterThanOrEqual(elapsed, 1.0);
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 2u);
+}
+
+- (void)testRetriesFailedConnections {
+	NSMutableArray<NSURLRequest *> *seen = [NSMutableArray array];
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		@synchronized(seen) {
+			[seen addObject:request];
+			if (seen.count == 1) {
+				return [TMDBScriptedResponse responseWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]];
+			}
+		}
+		return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:550]];
+	}];
+
+	NSError *error = [self requestMovieWithID:550 parsedData:NULL elapsed:NULL];
+
+	XCTAssertNil(error);
+	XCTAssertEqual([self requestCountForPath:@"/movie/550"], 2u);
+}
+
+#pragma mark - Deadlines
+
+- (void)testDeadlineCoversRetries {
+	TMDBRetryPolicy *policy = [self quickPolicy];
+	policy.timeout = 0.5;
+	self.context.retryPolicy = policy;
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:503 headers:nil body:nil];
+		response.latency = 0.3;
+		return response;
+	}];
+
+	NSTimeInterval elapsed = 0;
+	NSError *error = [self requestMovieWithID:550 parsedData:NULL elapsed:&elapsed];
+
+	XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+	XCTAssertEqual(error.code, NSURLErrorTimedOut);
+	XCTAssertLessThan(elapsed, 1.0);
+}
+
+- (void)testDeadlineCutsAHangingRequestShort {
+	TMDBRetryPolicy *policy = [self quickPolicy];
+	policy.timeout = 0.3;
+	self.context.retryPolicy = policy;
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse hangingResponse];
+	}];
+
+	NSTimeInterval elapsed = 0;
+	NSError *error = [self requestMovieWithID:550 parsedData:NULL elapsed:&elapsed];
+
+	XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+	XCTAssertEqual(error.code, NSURLErrorTimedOut);
+	XCTAssertGreaterThanOrEqual(elapsed, 0.3);
+	XCTAssertLessThan(elapsed, 1.0);
+
+	// The hanging task is let go once nobody is waiting for it
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+	XCTAssertEqual(self.transport.runningTaskCount, 0u);
+}
+
+- (void)testCallerDeadlineOverridesThePolicy {
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse hangingResponse];
+	}];
+
+	XCTestExpectation *expectation = [self expectationWithDescription:@"timed out"];
+	TMDBMovie *movie = [[TMDBMovie alloc] initWithID:550 context:self.context];
+
+	CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+	TMDBRequestToken *token = [movie load:TMDBMovieFetchOptionBasic completion:^(NSError *error) {
+		XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+		XCTAssertEqual(error.code, NSURLErrorTimedOut);
+		XCTAssertLessThan(CFAbsoluteTimeGetCurrent() - start, 1.0);
+		[expectation fulfill];
+	}];
+	token.deadline = [NSDate dateWithTimeIntervalSinceNow:0.3];
+
+	[self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+#pragma mark - Hedging
+
+- (void)testHedgesSlowRequests {
+	TMDBRetryPolicy *policy = [self quickPolicy];
+	policy.hedgingPercentile = 0.9;
+	self.context.retryPolicy = policy;
+
+	// The first attempt at movie 999 stalls, everything else is quick
+	__block BOOL stalled = NO;
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		NSUInteger tmdbID = [TMDBTestCase movieIDFromRequest:request];
+		TMDBScriptedResponse *response = [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase movieDictionaryWithID:tmdbID]];
+		response.latency = 0.01;
+
+		@synchronized(self) {
+			if (tmdbID == 999 && !stalled) {
+				stalled = YES;
+				response.latency = 3.0;
+			}
+		}
+		return response;
+	}];
+
+	// Fill the endpoint's latency history, pushing out that of earlier tests
+	for (NSUInteger i = 1; i <= 64; i++) {
+		XCTAssertNil([self requestMovieWithID:i parsedData:NULL elapsed:NULL]);
+	}
+
+	id parsedData = nil;
+	NSTimeInterval elapsed = 0;
+	NSError *error = [self requestMovieWithID:999 parsedData:&parsedData elapsed:&elapsed];
+
+	XCTAssertNil(error);
+	XCTAssertEqualObjects(parsedData[@"id"], @999);
+	XCTAssertLessThan(elapsed, 1.0);
+	XCTAssertEqual([self requestCountForPath:@"/movie/999"], 2u);
+
+	// The stalled request loses the race and is cancelled
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+	XCTAssertEqual(self.transport.cancelledTaskCount, 1u);
+	XCTAssertEqual(self.transport.runningTaskCount, 0u);
+}
+
+#pragma mark - Budget
+
+- (void)testBudgetOnlyGrowsWithSuccessfulRequests {
+	TMDBRetryBudget *budget = [[TMDBRetryBudget alloc] initWithMaximumTokens:2.0];
+
+	XCTAssertTrue([budget withdraw]);
+	XCTAssertTrue([budget withdraw]);
+	XCTAssertFalse([budget withdraw]);
+
+	[budget depositWithRatio:0.5];
+	XCTAssertFalse([budget withdraw]);
+	[budget depositWithRatio:0.5];
+	XCTAssertTrue([budget withdraw]);
+
+	[budget depositWithRatio:10.0];
+	XCTAssertTrue([budget withdraw]);
+	XCTAssertTrue([budget withdraw]);
+	XCTAssertFalse([budget withdraw]);
+}
+
+@end
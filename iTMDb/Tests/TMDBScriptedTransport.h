@@ -0,0 +1,74 @@
+//
+//  TMDBScriptedTransport.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBTransport.h"
+
+/**
+ * What a scripted transport answers a single request with.
+ */
+@interface TMDBScriptedResponse : NSObject
+
++ (nonnull instancetype)responseWithStatusCode:(NSInteger)statusCode JSONObject:(nullable id)object;
++ (nonnull instancetype)responseWithStatusCode:(NSInteger)statusCode headers:(nullable NSDictionary<NSString *, NSString *> *)headers body:(nullable NSData *)body;
+
+/** Fails the task with `error` without ever responding. */
++ (nonnull instancetype)responseWithError:(nonnull NSError *)error;
+
+/** Never responds; the task only ends when it is cancelled. */
++ (nonnull instancetype)hangingResponse;
+
+@property (nonatomic) NSInteger statusCode;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic, copy, nullable) NSData *body;
+@property (nonatomic, copy, nullable) NSError *error;
+@property (nonatomic, getter=isHanging) BOOL hanging;
+
+/** The time from starting the task to delivering the response. */
+@property (nonatomic) NSTimeInterval latency;
+
+/**
+ * The size of the chunks the body is delivered in, or `0` to deliver it all
+ * at once, and the time between chunks.
+ */
+@property (nonatomic) NSUInteger chunkLength;
+@property (nonatomic) NSTimeInterval chunkInterval;
+
+@end
+
+typedef TMDBScriptedResponse * _Nonnull (^TMDBScriptedResponseHandler)(NSURLRequest * _Nonnull request, NSUInteger requestIndex);
+
+/**
+ * A transport that answers every request through a handler instead of the
+ * network, and records what it was asked for. Callbacks for each task are
+ * delivered on a serial background queue of their own, like a real session.
+ */
+@interface TMDBScriptedTransport : NSObject <TMDBTransport>
+
+- (nonnull instancetype)initWithHandler:(nullable TMDBScriptedResponseHandler)handler;
+
+/** Answers requests with an empty 404 response if `nil`. */
+@property (atomic, copy, nullable) TMDBScriptedResponseHandler handler;
+
+/** The requests started so far, in order. */
+@property (nonatomic, copy, readonly, nonnull) NSArray<NSURLRequest *> *requests;
+@property (nonatomic, readonly) NSUInteger requestCount;
+
+/** The number of requests started for a URL whose path is `path`. */
+- (NSUInteger)requestCountForPath:(nonnull NSString *)path;
+
+/** The number of requests started for a URL whose path has `prefix`. */
+- (NSUInteger)requestCountForPathPrefix:(nonnull NSString *)prefix;
+
+/** The most tasks that have been running at the same time. */
+@property (nonatomic, readonly) NSUInteger maximumConcurrentTasks;
+@property (nonatomic, readonly) NSUInteger runningTaskCount;
+@property (nonatomic, readonly) NSUInteger cancelledTaskCount;
+
+@end
@@ -0,0 +1,275 @@
+//
+//  TMDBScriptedTransport.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBScriptedTransport.h"
+
+@implementation TMDBScriptedResponse
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode JSONObject:(id)object {
+	NSData *body = object != nil ? [NSJSONSerialization dataWithJSONObject:object options:0 error:NULL] : nil;
+	return [self responseWithStatusCode:statusCode headers:@{@"Content-Type": @"application/json;charset=utf-8"} body:body];
+}
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode headers:(NSDictionary<NSString *, NSString *> *)headers body:(NSData *)body {
+	TMDBScriptedResponse *response = [[self alloc] init];
+	response.statusCode = statusCode;
+	response.headers = headers;
+	response.body = body;
+	return response;
+}
+
++ (instancetype)responseWithError:(NSError *)error {
+	TMDBScriptedResponse *response = [[self alloc] init];
+	response.error = error;
+	return response;
+}
+
++ (instancetype)hangingResponse {
+	TMDBScriptedResponse *response = [[self alloc] init];
+	response.hanging = YES;
+	return response;
+}
+
+@end
+
+#pragma mark -
+
+@class TMDBScriptedTransport;
+
+// Private class
+@interface TMDBScriptedTask : NSObject <TMDBTransportTask>
+
+- (instancetype)initWithTransport:(TMDBScriptedTransport *)transport request:(NSURLRequest *)request response:(TMDBScriptedResponse *)response delegate:(id<TMDBTransportDelegate>)delegate;
+
+- (void)start;
+
+@end
+
+@interface TMDBScriptedTransport ()
+
+- (void)taskDidFinish:(TMDBScriptedTask *)task cancelled:(BOOL)cancelled;
+
+@end
+
+@implementation TMDBScriptedTask {
+@private
+	__weak TMDBScriptedTransport *_transport;
+	NSURLRequest *_request;
+	TMDBScriptedResponse *_response;
+	id<TMDBTransportDelegate> _delegate;
+	dispatch_queue_t _queue;
+	BOOL _finished;
+}
+
+- (instancetype)initWithTransport:(TMDBScriptedTransport *)transport request:(NSURLRequest *)request response:(TMDBScriptedResponse *)response delegate:(id<TMDBTransportDelegate>)delegate {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_transport = transport;
+	_request = [request copy];
+	_response = response;
+	_delegate = delegate;
+	_queue = dispatch_queue_create("dk.devify.iTMDbTests.ScriptedTask", DISPATCH_QUEUE_SERIAL);
+
+	return self;
+}
+
+- (void)start {
+	if (_response.isHanging) {
+		return;
+	}
+
+	[self after:_response.latency do:^{
+		if (_response.error != nil) {
+			[self completeWithError:_response.error cancelled:NO];
+			return;
+		}
+
+		NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:_request.URL
+																  statusCode:_response.statusCode
+																 HTTPVersion:@"HTTP/1.1"
+																headerFields:_response.headers];
+		[_delegate transportTask:self didReceiveResponse:response];
+		[self deliverBodyFromOffset:0];
+	}];
+}
+
+- (void)deliverBodyFromOffset:(NSUInteger)offset {
+	NSData *body = _response.body;
+	if (_finished) {
+		return;
+	}
+	if (offset >= body.length) {
+		[self completeWithError:nil cancelled:NO];
+		return;
+	}
+
+	NSUInteger length = _response.chunkLength > 0 ? MIN(_response.chunkLength, body.length - offset) : body.length - offset;
+	[_delegate transportTask:self didReceiveData:[body subdataWithRange:NSMakeRange(offset, length)]];
+
+	if (offset + length >= body.length) {
+		[self completeWithError:nil cancelled:NO];
+		return;
+	}
+
+	[self after:_response.chunkInterval do:^{
+		[self deliverBodyFromOffset:offset + length];
+	}];
+}
+
+- (void)after:(NSTimeInterval)delay do:(dispatch_block_t)block {
+	dispatch_block_t guarded = ^{
+		if (!_finished) {
+			block();
+		}
+	};
+
+	if (delay <= 0) {
+		dispatch_async(_queue, guarded);
+	}
+	else {
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, guarded);
+	}
+}
+
+- (void)completeWithError:(NSError *)error cancelled:(BOOL)cancelled {
+	if (_finished) {
+		return;
+	}
+	_finished = YES;
+
+	id<TMDBTransportDelegate> delegate = _delegate;
+	_delegate = nil;
+
+	[_transport taskDidFinish:self cancelled:cancelled];
+	[delegate transportTask:self didCompleteWithError:error];
+}
+
+#pragma mark - TMDBTransportTask
+
+- (void)cancel {
+	// Like a session task, cancelling completes the task asynchronously
+	dispatch_async(_queue, ^{
+		NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+		[self completeWithError:error cancelled:YES];
+	});
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBScriptedTransport {
+@private
+	NSMutableArray<NSURLRequest *> *_requests;
+	NSUInteger _runningTaskCount;
+	NSUInteger _maximumConcurrentTasks;
+	NSUInteger _cancelledTaskCount;
+}
+
+- (instancetype)init {
+	return (self = [self initWithHandler:nil]);
+}
+
+- (instancetype)initWithHandler:(TMDBScriptedResponseHandler)handler {
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_handler = [handler copy];
+	_requests = [NSMutableArray array];
+
+	return self;
+}
+
+#pragma mark - Recording
+
+- (NSArray<NSURLRequest *> *)requests {
+	@synchronized(self) {
+		return [_requests copy];
+	}
+}
+
+- (NSUInteger)requestCount {
+	@synchronized(self) {
+		return _requests.count;
+	}
+}
+
+- (NSUInteger)requestCountForPath:(NSString *)path {
+	NSUInteger count = 0;
+	for (NSURLRequest *request in self.requests) {
+		if ([request.URL.path isEqualToString:path]) {
+			count++;
+		}
+	}
+	return count;
+}
+
+- (NSUInteger)requestCountForPathPrefix:(NSString *)prefix {
+	NSUInteger count = 0;
+	for (NSURLRequest *request in self.requests) {
+		if ([request.URL.path hasPrefix:prefix]) {
+			count++;
+		}
+	}
+	return count;
+}
+
+- (NSUInteger)maximumConcurrentTasks {
+	@synchronized(self) {
+		return _maximumConcurrentTasks;
+	}
+}
+
+- (NSUInteger)runningTaskCount {
+	@synchronized(self) {
+		return _runningTaskCount;
+	}
+}
+
+- (NSUInteger)cancelledTaskCount {
+	@synchronized(self) {
+		return _cancelledTaskCount;
+	}
+}
+
+- (void)taskDidFinish:(TMDBScriptedTask *)task cancelled:(BOOL)cancelled {
+	@synchronized(self) {
+		_runningTaskCount--;
+		if (cancelled) {
+			_cancelledTaskCount++;
+		}
+	}
+}
+
+#pragma mark - TMDBTransport
+
+- (id<TMDBTransportTask>)startTaskWithRequest:(NSURLRequest *)request delegate:(id<TMDBTransportDelegate>)delegate {
+	NSParameterAssert(request != nil);
+	NSParameterAssert(delegate != nil);
+
+	NSUInteger index;
+	@synchronized(self) {
+		index = _requests.count;
+		[_requests addObject:[request copy]];
+		_runningTaskCount++;
+		_maximumConcurrentTasks = MAX(_maximumConcurrentTasks, _runningTaskCount);
+	}
+
+	TMDBScriptedResponseHandler handler = self.handler;
+	TMDBScriptedResponse *response = handler != nil ? handler(request, index) : [TMDBScriptedResponse responseWithStatusCode:404 headers:nil body:nil];
+
+	TMDBScriptedTask *task = [[TMDBScriptedTask alloc] initWithTransport:self request:request response:response delegate:delegate];
+	[task start];
+
+	return task;
+}
+
+@end
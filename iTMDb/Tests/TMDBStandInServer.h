@@ -0,0 +1,51 @@
+//
+//  TMDBStandInServer.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import Foundation;
+
+#import "TMDBURLSessionTransport.h"
+
+/**
+ * A local HTTP stand-in for TMDb, `Benchmarks/stand_in_server.py`, replaying
+ * the recorded fixtures with a configurable latency.
+ *
+ * The server at the URL in the environment variable `TMDB_BENCHMARK_SERVER`
+ * is used if there is one. Otherwise a server is started for the test run,
+ * and stops with it.
+ */
+@interface TMDBStandInServer : NSObject
+
+/** The server for this run, or `nil` if none could be started. */
++ (nullable instancetype)sharedServer;
+
+@property (nonatomic, copy, nonnull, readonly) NSURL *baseURL;
+
+/**
+ * Holds back every response from now on by `latency`, plus a random part of
+ * `jitter`.
+ */
+- (void)setLatency:(NSTimeInterval)latency jitter:(NSTimeInterval)jitter;
+
+/** The number of requests for each path since the counts were last reset. */
+- (nonnull NSDictionary<NSString *, NSNumber *> *)requestCounts;
+- (void)resetRequestCounts;
+
+@end
+
+/**
+ * A session transport that sends every request to a stand-in server instead
+ * of the host it was made for, and is otherwise configured like the shared
+ * transport.
+ */
+@interface TMDBStandInTransport : TMDBURLSessionTransport
+
+- (nonnull instancetype)initWithServer:(nonnull TMDBStandInServer *)server;
+
+@property (nonatomic, strong, nonnull, readonly) TMDBStandInServer *server;
+
+@end
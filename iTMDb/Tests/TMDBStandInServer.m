@@ -0,0 +1,168 @@
+//
+//  TMDBStandInServer.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBStandInServer.h"
+
+@implementation TMDBStandInServer {
+@private
+	// Only set for a server started by this process
+	NSTask *_task;
+	NSURLSession *_controlSession;
+}
+
++ (instancetype)sharedServer {
+	static TMDBStandInServer *sharedServer;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		NSString *serverURL = [NSProcessInfo processInfo].environment[@"TMDB_BENCHMARK_SERVER"];
+		if (serverURL.length > 0) {
+			sharedServer = [[self alloc] initWithBaseURL:[NSURL URLWithString:serverURL] task:nil];
+		}
+		else {
+			sharedServer = [self launchedServer];
+		}
+
+		if (sharedServer == nil) {
+			NSLog(@"iTMDb: No stand-in server; set TMDB_BENCHMARK_SERVER or make python3 available");
+		}
+	});
+	return sharedServer;
+}
+
+// Starts the script next to the tests. It prints the URL it listens on, and
+// exits by itself once this process is gone.
++ (instancetype)launchedServer {
+	NSString *testsDirectory = [@(__FILE__) stringByDeletingLastPathComponent];
+	NSString *scriptPath = [testsDirectory stringByAppendingPathComponent:@"Benchmarks/stand_in_server.py"];
+	if (![[NSFileManager defaultManager] fileExistsAtPath:scriptPath]) {
+		return nil;
+	}
+
+	NSPipe *output = [NSPipe pipe];
+	NSTask *task = [[NSTask alloc] init];
+	task.executableURL = [NSURL fileURLWithPath:@"/usr/bin/env"];
+	task.arguments = @[@"python3", scriptPath, @"--port", @"0", @"--parent-pid", [NSString stringWithFormat:@"%d", [NSProcessInfo processInfo].processIdentifier]];
+	task.standardOutput = output;
+
+	NSError *error = nil;
+	if (![task launchAndReturnError:&error]) {
+		NSLog(@"iTMDb: Couldn't start the stand-in server: %@", error);
+		return nil;
+	}
+
+	// The first line of output is the server's URL
+	NSMutableData *line = [NSMutableData data];
+	NSFileHandle *handle = output.fileHandleForReading;
+	while (YES) {
+		NSData *data = [handle readDataOfLength:1];
+		if (data.length == 0 || ((const char *)data.bytes)[0] == '\n') {
+			break;
+		}
+		[line appendData:data];
+	}
+
+	NSString *serverURL = [[NSString alloc] initWithData:line encoding:NSUTF8StringEncoding];
+	NSURL *baseURL = serverURL.length > 0 ? [NSURL URLWithString:serverURL] : nil;
+	if (baseURL == nil) {
+		[task terminate];
+		return nil;
+	}
+
+	return [[self alloc] initWithBaseURL:baseURL task:task];
+}
+
+- (instancetype)initWithBaseURL:(NSURL *)baseURL task:(NSTask *)task {
+	NSParameterAssert(baseURL != nil);
+
+	if (!(self = [super init])) {
+		return nil;
+	}
+
+	_baseURL = [baseURL copy];
+	_task = task;
+	_controlSession = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration ephemeralSessionConfiguration]];
+
+	return self;
+}
+
+#pragma mark - Controlling the Server
+
+// Sends a request to the server and waits for its response
+- (NSData *)sendControlRequestToPath:(NSString *)path method:(NSString *)method {
+	NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:path relativeToURL:_baseURL]];
+	request.HTTPMethod = method;
+	request.timeoutInterval = 10.0;
+
+	dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+	__block NSData *responseData = nil;
+
+	[[_controlSession dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+		if (error != nil) {
+			NSLog(@"iTMDb: Stand-in server request %@ failed: %@", path, error);
+		}
+		responseData = data;
+		dispatch_semaphore_signal(semaphore);
+	}] resume];
+
+	dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+	return responseData;
+}
+
+- (void)setLatency:(NSTimeInterval)latency jitter:(NSTimeInterval)jitter {
+	[self sendControlRequestToPath:[NSString stringWithFormat:@"/_stand-in/latency?latency=%.4f&jitter=%.4f", latency, jitter] method:@"POST"];
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)requestCounts {
+	NSData *data = [self sendControlRequestToPath:@"/_stand-in/stats" method:@"GET"];
+	NSDictionary *stats = data != nil ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil;
+	return [stats isKindOfClass:[NSDictionary class]] ? stats[@"requests"] ?: @{} : @{};
+}
+
+- (void)resetRequestCounts {
+	[self sendControlRequestToPath:@"/_stand-in/reset" method:@"POST"];
+}
+
+@end
+
+#pragma mark -
+
+@implementation TMDBStandInTransport
+
+- (instancetype)initWithServer:(TMDBStandInServer *)server {
+	NSParameterAssert(server != nil);
+
+	// The shared transport's settings, which the server is meant to stand in for
+	NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+	configuration.timeoutIntervalForRequest = 30.0;
+	configuration.HTTPMaximumConnectionsPerHost = 6;
+	configuration.HTTPAdditionalHeaders = @{@"Accept": @"application/json"};
+	configuration.URLCache = nil;
+	configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+
+	if (!(self = [super initWithSessionConfiguration:configuration])) {
+		return nil;
+	}
+
+	_server = server;
+
+	return self;
+}
+
+- (id<TMDBTransportTask>)startTaskWithRequest:(NSURLRequest *)request delegate:(id<TMDBTransportDelegate>)delegate {
+	NSURLComponents *components = [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:NO];
+	components.scheme = _server.baseURL.scheme;
+	components.host = _server.baseURL.host;
+	components.port = _server.baseURL.port;
+
+	NSMutableURLRequest *standInRequest = [request mutableCopy];
+	standInRequest.URL = components.URL;
+
+	return [super startTaskWithRequest:standInRequest delegate:delegate];
+}
+
+@end
@@ -0,0 +1,44 @@
+//
+//  TMDBTestCase.h
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+@import XCTest;
+
+#import "TMDB.h"
+#import "TMDBScriptedTransport.h"
+
+/**
+ * A test case that talks to a scripted transport instead of TMDb. Each test
+ * gets a fresh transport and a context of its own, with an API key nobody
+ * else uses, so it has a rate limiter to itself. Nothing is cached.
+ */
+@interface TMDBTestCase : XCTestCase
+
+@property (nonatomic, strong, nonnull, readonly) TMDBScriptedTransport *transport;
+@property (nonatomic, strong, nonnull, readonly) TMDB *context;
+
+/**
+ * Answers requests with `handler`, except for `/configuration`, which is
+ * always answered with `configurationDictionary`.
+ */
+- (void)serveRequestsWithHandler:(nonnull TMDBScriptedResponseHandler)handler;
+
+/** The number of requests made to `path` below the API version. */
+- (NSUInteger)requestCountForPath:(nonnull NSString *)path;
+
++ (nonnull NSDictionary *)configurationDictionary;
+
+/** A basic movie response, as returned by `/movie/{id}`. */
++ (nonnull NSDictionary *)movieDictionaryWithID:(NSUInteger)tmdbID;
+
+/** A page of search results for `count` movies, starting at `firstID`. */
++ (nonnull NSDictionary *)searchPageDictionaryWithPage:(NSUInteger)page totalPages:(NSUInteger)totalPages firstID:(NSUInteger)firstID count:(NSUInteger)count;
+
+/** The ID in a `/movie/{id}` URL, or `0` for other URLs. */
++ (NSUInteger)movieIDFromRequest:(nonnull NSURLRequest *)request;
+
+@end
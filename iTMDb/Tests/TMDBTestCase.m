@@ -0,0 +1,133 @@
+//
+//  TMDBTestCase.m
+//  iTMDb
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 Devify. All rights reserved.
+//
+
+#import "TMDBTestCase.h"
+#import "TMDBRequest.h"
+
+@implementation TMDBTestCase
+
+- (void)setUp {
+	[super setUp];
+
+	_transport = [[TMDBScriptedTransport alloc] init];
+	[self serveRequestsWithHandler:^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		return [TMDBScriptedResponse responseWithStatusCode:404 JSONObject:@{@"status_code": @34, @"status_message": @"The resource you requested could not be found."}];
+	}];
+	[TMDBRequest setTransport:_transport];
+
+	_context = [[TMDB alloc] initWithAPIKey:nil language:@"en"];
+	for (TMDBCacheEndpoint endpoint = TMDBCacheEndpointConfiguration; endpoint <= TMDBCacheEndpointOther; endpoint++) {
+		[_context setCacheLifetime:0 forEndpoint:endpoint];
+	}
+	_context.apiKey = [NSUUID UUID].UUIDString;
+}
+
+- (void)tearDown {
+	[TMDBRequest setTransport:nil];
+	_transport = nil;
+	_context = nil;
+
+	[super tearDown];
+}
+
+#pragma mark -
+
+- (void)serveRequestsWithHandler:(TMDBScriptedResponseHandler)handler {
+	NSString *configurationPath = [NSString stringWithFormat:@"/%@/configuration", TMDBAPIVersion];
+
+	_transport.handler = ^TMDBScriptedResponse *(NSURLRequest *request, NSUInteger requestIndex) {
+		if ([request.URL.path isEqualToString:configurationPath]) {
+			return [TMDBScriptedResponse responseWithStatusCode:200 JSONObject:[TMDBTestCase configurationDictionary]];
+		}
+		return handler(request, requestIndex);
+	};
+}
+
+- (NSUInteger)requestCountForPath:(NSString *)path {
+	return [_transport requestCountForPath:[NSString stringWithFormat:@"/%@%@", TMDBAPIVersion, path]];
+}
+
+#pragma mark - Responses
+
++ (NSDictionary *)configurationDictionary {
+	return @{
+		@"images": @{
+			@"base_url": @"http://image.tmdb.org/t/p/",
+			@"secure_base_url": @"https://image.tmdb.org/t/p/",
+			@"backdrop_sizes": @[@"w300", @"w780", @"w1280", @"original"],
+			@"logo_sizes": @[@"w45", @"w92", @"w154", @"w185", @"w300", @"w500", @"original"],
+			@"poster_sizes": @[@"w92", @"w154", @"w185", @"w342", @"w500", @"w780", @"original"],
+			@"profile_sizes": @[@"w45", @"w185", @"h632", @"original"],
+			@"still_sizes": @[@"w92", @"w185", @"w300", @"original"]
+		},
+		@"change_keys": @[@"adult", @"budget", @"casts", @"genres", @"images", @"keywords", @"overview", @"release_dates", @"runtime", @"title"]
+	};
+}
+
++ (NSDictionary *)movieDictionaryWithID:(NSUInteger)tmdbID {
+	return @{
+		@"id": @(tmdbID),
+		@"title": [NSString stringWithFormat:@"Movie %tu", tmdbID],
+		@"original_title": [NSString stringWithFormat:@"Movie %tu", tmdbID],
+		@"overview": @"A movie made up for testing.",
+		@"tagline": @"",
+		@"release_date": @"1999-10-15",
+		@"runtime": @139,
+		@"adult": @NO,
+		@"vote_count": @1024,
+		@"vote_average": @7.5,
+		@"imdb_id": [NSString stringWithFormat:@"tt%07tu", tmdbID],
+		@"homepage": @"",
+		@"poster_path": @"/poster.jpg",
+		@"backdrop_path": @"/backdrop.jpg",
+		@"genres": @[@{@"id": @18, @"name": @"Drama"}],
+		@"spoken_languages": @[@{@"iso_639_1": @"en", @"name": @"English"}],
+		@"production_countries": @[@{@"iso_3166_1": @"US", @"name": @"United States of America"}]
+	};
+}
+
++ (NSDictionary *)searchPageDictionaryWithPage:(NSUInteger)page totalPages:(NSUInteger)totalPages firstID:(NSUInteger)firstID count:(NSUInteger)count {
+	NSMutableArray *results = [NSMutableArray arrayWithCapacity:count];
+	for (NSUInteger i = 0; i < count; i++) {
+		NSUInteger tmdbID = firstID + i;
+		[results addObject:@{
+			@"id": @(tmdbID),
+			@"title": [NSString stringWithFormat:@"Movie %tu", tmdbID],
+			@"original_title": [NSString stringWithFormat:@"Movie %tu", tmdbID],
+			@"overview": @"A movie made up for testing.",
+			@"release_date": @"1999-10-15",
+			@"adult": @NO,
+			@"popularity": @(100.0 - i),
+			@"vote_count": @1024,
+			@"vote_average": @7.5,
+			@"poster_path": @"/poster.jpg",
+			@"backdrop_path": @"/backdrop.jpg",
+			@"genre_ids": @[@18]
+		}];
+	}
+
+	return @{
+		@"page": @(page),
+		@"total_pages": @(totalPages),
+		@"total_results": @(totalPages * 20),
+		@"results": results
+	};
+}
+
++ (NSUInteger)movieIDFromRequest:(NSURLRequest *)request {
+	NSArray<NSString *> *components = request.URL.pathComponents;
+	// "/", "3", "movie", "{id}"
+	if (components.count < 4 || ![components[2] isEqualToString:@"movie"]) {
+		return 0;
+	}
+
+	NSInteger tmdbID = components[3].integerValue;
+	return tmdbID > 0 ? (NSUInteger)tmdbID : 0;
+}
+
+@end
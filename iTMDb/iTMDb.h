@@ -9,9 +9,19 @@
 @import Foundation;
 
 #import <iTMDb/TMDB.h>
+#import <iTMDb/TMDBContextPool.h>
 #import <iTMDb/TMDBMovie.h>
+#import <iTMDb/TMDBRequestToken.h>
+#import <iTMDb/TMDBRetryPolicy.h>
+#import <iTMDb/TMDBRequestMetrics.h>
 #import <iTMDb/TMDBMovieSearch.h>
+#import <iTMDb/TMDBMovieSearchCursor.h>
+#import <iTMDb/TMDBMovieSnapshot.h>
+#import <iTMDb/TMDBMovieTitleIndex.h>
+#import <iTMDb/TMDBMovieSync.h>
 #import <iTMDb/TMDBImage.h>
+#import <iTMDb/TMDBImageLoader.h>
 #import <iTMDb/TMDBPerson.h>
+#import <iTMDb/TMDBCredit.h>
 #import <iTMDb/TMDBLanguage.h>
 #import <iTMDb/TMDBConfiguration.h>